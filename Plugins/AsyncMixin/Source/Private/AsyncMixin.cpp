@@ -7,7 +7,11 @@
 
 DEFINE_LOG_CATEGORY_STATIC(LogAsyncMixin, Log, All);
 
-TMap<FAsyncMixin*, TSharedRef<FAsyncMixin::FLoadingState>> FAsyncMixin::Loading;
+namespace AsyncMixin
+{
+	// Shared by every loading state so that step ids from a canceled sequence can never match a new one
+	static uint32 NextStepGeneration = 0;
+}
 
 FAsyncMixin::FAsyncMixin()
 {
@@ -19,32 +23,33 @@ FAsyncMixin::~FAsyncMixin()
 
 	// Removing the loading state will cancel any pending loadings it was 
 	// monitoring, and shouldn't receive any future callbacks for completion.
-	Loading.Remove(this);
+	LoadingState.Reset();
 }
 
 const FAsyncMixin::FLoadingState& FAsyncMixin::GetLoadingStateConst() const
 {
 	check(IsInGameThread());
-	return Loading.FindChecked(this).Get();
+	check(LoadingState.IsValid());
+	return *LoadingState;
 }
 
 FAsyncMixin::FLoadingState& FAsyncMixin::GetLoadingState()
 {
 	check(IsInGameThread());
 
-	if (TSharedRef<FLoadingState>* LoadingState = Loading.Find(this))
+	if (!LoadingState.IsValid())
 	{
-		return (*LoadingState).Get();
+		LoadingState = MakeShared<FLoadingState>(*this);
 	}
 
-	return Loading.Add(this, MakeShared<FLoadingState>(*this)).Get();
+	return *LoadingState;
 }
 
 bool FAsyncMixin::HasLoadingState() const
 {
 	check(IsInGameThread());
 
-	return Loading.Contains(this);
+	return LoadingState.IsValid();
 }
 
 void FAsyncMixin::CancelAsyncLoading()
@@ -77,29 +82,34 @@ bool FAsyncMixin::IsLoadingInProgressOrPending() const
 	return false;
 }
 
-void FAsyncMixin::AsyncLoad(FSoftObjectPath SoftObjectPath, const FSimpleDelegate& DelegateToCall)
+FAsyncStepId FAsyncMixin::AsyncLoad(FSoftObjectPath SoftObjectPath, const FSimpleDelegate& DelegateToCall)
+{
+	return GetLoadingState().AsyncLoad(SoftObjectPath, DelegateToCall);
+}
+
+FAsyncStepId FAsyncMixin::AsyncLoad(const TArray<FSoftObjectPath>& SoftObjectPaths, const FSimpleDelegate& DelegateToCall)
 {
-	GetLoadingState().AsyncLoad(SoftObjectPath, DelegateToCall);
+	return GetLoadingState().AsyncLoad(SoftObjectPaths, DelegateToCall);
 }
 
-void FAsyncMixin::AsyncLoad(const TArray<FSoftObjectPath>& SoftObjectPaths, const FSimpleDelegate& DelegateToCall)
+FAsyncStepId FAsyncMixin::AsyncLoadAfter(TConstArrayView<FAsyncStepId> Dependencies, const TArray<FSoftObjectPath>& SoftObjectPaths, const FSimpleDelegate& DelegateToCall)
 {
-	GetLoadingState().AsyncLoad(SoftObjectPaths, DelegateToCall);
+	return GetLoadingState().AsyncLoadAfter(Dependencies, SoftObjectPaths, DelegateToCall);
 }
 
-void FAsyncMixin::AsyncPreloadPrimaryAssetsAndBundles(const TArray<FPrimaryAssetId>& AssetIds, const TArray<FName>& LoadBundles, const FSimpleDelegate& DelegateToCall)
+FAsyncStepId FAsyncMixin::AsyncPreloadPrimaryAssetsAndBundles(const TArray<FPrimaryAssetId>& AssetIds, const TArray<FName>& LoadBundles, const FSimpleDelegate& DelegateToCall)
 {
-	GetLoadingState().AsyncPreloadPrimaryAssetsAndBundles(AssetIds, LoadBundles, DelegateToCall);
+	return GetLoadingState().AsyncPreloadPrimaryAssetsAndBundles(AssetIds, LoadBundles, DelegateToCall);
 }
 
-void FAsyncMixin::AsyncCondition(TSharedRef<FAsyncCondition> Condition, const FSimpleDelegate& Callback)
+FAsyncStepId FAsyncMixin::AsyncCondition(TSharedRef<FAsyncCondition> Condition, const FSimpleDelegate& Callback)
 {
-	GetLoadingState().AsyncCondition(Condition, Callback);
+	return GetLoadingState().AsyncCondition(Condition, Callback);
 }
 
-void FAsyncMixin::AsyncEvent(const FSimpleDelegate& Callback)
+FAsyncStepId FAsyncMixin::AsyncEvent(const FSimpleDelegate& Callback)
 {
-	GetLoadingState().AsyncEvent(Callback);
+	return GetLoadingState().AsyncEvent(Callback);
 }
 
 void FAsyncMixin::StartAsyncLoading()
@@ -123,6 +133,7 @@ void FAsyncMixin::StartAsyncLoading()
 
 FAsyncMixin::FLoadingState::FLoadingState(FAsyncMixin& InOwner)
 	: OwnerRef(InOwner)
+	, StepGeneration(++AsyncMixin::NextStepGeneration)
 {
 }
 
@@ -158,6 +169,7 @@ void FAsyncMixin::FLoadingState::CancelOnly(bool bDestroying)
 	bPreloadedBundles = false;
 	bHasStarted = false;
 	CurrentAsyncStep = 0;
+	StepGeneration = ++AsyncMixin::NextStepGeneration;
 }
 
 void FAsyncMixin::FLoadingState::CancelAndDestroy()
@@ -190,7 +202,7 @@ void FAsyncMixin::FLoadingState::RequestDestroyThisMemory()
 
 		DestroyMemoryDelegate = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([this](float DeltaTime) {
 			// Remove any memory we were using.
-			FAsyncMixin::Loading.Remove(&OwnerRef);
+			OwnerRef.LoadingState.Reset();
 			return false;
 		}));
 	}
@@ -223,35 +235,75 @@ void FAsyncMixin::FLoadingState::Start()
 	TryCompleteAsyncLoading();
 }
 
-void FAsyncMixin::FLoadingState::AsyncLoad(FSoftObjectPath SoftObjectPath, const FSimpleDelegate& DelegateToCall)
+FAsyncStepId FAsyncMixin::FLoadingState::AddStep(TUniquePtr<FAsyncStep>&& Step)
+{
+	FAsyncStepId StepId;
+	StepId.StepIndex = AsyncSteps.Add(MoveTemp(Step));
+	StepId.Generation = StepGeneration;
+
+	TryScheduleStart();
+
+	return StepId;
+}
+
+FAsyncStepId FAsyncMixin::FLoadingState::AsyncLoad(FSoftObjectPath SoftObjectPath, const FSimpleDelegate& DelegateToCall)
 {
 	UE_LOG(LogAsyncMixin, Verbose, TEXT("[0x%X] AsyncLoad '%s'"), this, *SoftObjectPath.ToString());
 
-	AsyncSteps.Add(
+	return AddStep(
 		MakeUnique<FAsyncStep>(
 			DelegateToCall,
 			UAssetManager::GetStreamableManager().RequestAsyncLoad(SoftObjectPath, FStreamableDelegate(), FStreamableManager::AsyncLoadHighPriority, false, false, TEXT("AsyncMixin"))
 			)
 	);
-
-	TryScheduleStart();
 }
 
-void FAsyncMixin::FLoadingState::AsyncLoad(const TArray<FSoftObjectPath>& SoftObjectPaths, const FSimpleDelegate& DelegateToCall)
+FAsyncStepId FAsyncMixin::FLoadingState::AsyncLoad(const TArray<FSoftObjectPath>& SoftObjectPaths, const FSimpleDelegate& DelegateToCall)
 {
 	UE_LOG(LogAsyncMixin, Verbose, TEXT("[0x%X] AsyncLoad [%s]"), this, *FString::JoinBy(SoftObjectPaths, TEXT(", "), [](const FSoftObjectPath& SoftObjectPath) { return FString::Printf(TEXT("'%s'"), *SoftObjectPath.ToString()); }));
 
-	AsyncSteps.Add(
+	return AddStep(
 		MakeUnique<FAsyncStep>(
 			DelegateToCall,
 			UAssetManager::GetStreamableManager().RequestAsyncLoad(SoftObjectPaths, FStreamableDelegate(), FStreamableManager::AsyncLoadHighPriority, false, false, TEXT("AsyncMixin"))
 			)
 	);
+}
 
-	TryScheduleStart();
+FAsyncStepId FAsyncMixin::FLoadingState::AsyncLoadAfter(TConstArrayView<FAsyncStepId> Dependencies, const TArray<FSoftObjectPath>& SoftObjectPaths, const FSimpleDelegate& DelegateToCall)
+{
+	TArray<int32> DependencyIndices;
+	for (const FAsyncStepId& Dependency : Dependencies)
+	{
+		if (Dependency.Generation == StepGeneration && AsyncSteps.IsValidIndex(Dependency.StepIndex))
+		{
+			DependencyIndices.AddUnique(Dependency.StepIndex);
+		}
+		else if (Dependency.IsValid())
+		{
+			UE_LOG(LogAsyncMixin, Warning, TEXT("[0x%X] AsyncLoadAfter - Ignoring a dependency on step %d, it belongs to a canceled or different loading sequence"), this, Dependency.StepIndex + 1);
+		}
+	}
+
+	if (DependencyIndices.Num() == 0)
+	{
+		return AsyncLoad(SoftObjectPaths, DelegateToCall);
+	}
+
+	UE_LOG(LogAsyncMixin, Verbose, TEXT("[0x%X] AsyncLoadAfter [%s], Steps [%s]"),
+		this,
+		*FString::JoinBy(SoftObjectPaths, TEXT(", "), [](const FSoftObjectPath& SoftObjectPath) { return FString::Printf(TEXT("'%s'"), *SoftObjectPath.ToString()); }),
+		*FString::JoinBy(DependencyIndices, TEXT(", "), [](int32 DependencyIndex) { return FString::FromInt(DependencyIndex + 1); })
+	);
+
+	TFunction<TSharedPtr<FStreamableHandle>()> DeferredRequest = [SoftObjectPaths]() {
+		return UAssetManager::GetStreamableManager().RequestAsyncLoad(SoftObjectPaths, FStreamableDelegate(), FStreamableManager::AsyncLoadHighPriority, false, false, TEXT("AsyncMixin"));
+	};
+
+	return AddStep(MakeUnique<FAsyncStep>(DelegateToCall, MoveTemp(DeferredRequest), MoveTemp(DependencyIndices)));
 }
 
-void FAsyncMixin::FLoadingState::AsyncPreloadPrimaryAssetsAndBundles(const TArray<FPrimaryAssetId>& AssetIds, const TArray<FName>& LoadBundles, const FSimpleDelegate& DelegateToCall)
+FAsyncStepId FAsyncMixin::FLoadingState::AsyncPreloadPrimaryAssetsAndBundles(const TArray<FPrimaryAssetId>& AssetIds, const TArray<FName>& LoadBundles, const FSimpleDelegate& DelegateToCall)
 {
 	UE_LOG(LogAsyncMixin, Verbose, TEXT("[0x%X]  AsyncPreload Assets [%s], Bundles[%s]"),
 		this,
@@ -269,27 +321,21 @@ void FAsyncMixin::FLoadingState::AsyncPreloadPrimaryAssetsAndBundles(const TArra
 		StreamingHandle = UAssetManager::Get().PreloadPrimaryAssets(AssetIds, LoadBundles, bLoadRecursive);
 	}
 
-	AsyncSteps.Add(MakeUnique<FAsyncStep>(DelegateToCall, StreamingHandle));
-
-	TryScheduleStart();
+	return AddStep(MakeUnique<FAsyncStep>(DelegateToCall, StreamingHandle));
 }
 
-void FAsyncMixin::FLoadingState::AsyncCondition(TSharedRef<FAsyncCondition> Condition, const FSimpleDelegate& DelegateToCall)
+FAsyncStepId FAsyncMixin::FLoadingState::AsyncCondition(TSharedRef<FAsyncCondition> Condition, const FSimpleDelegate& DelegateToCall)
 {
 	UE_LOG(LogAsyncMixin, Verbose, TEXT("[0x%X] AsyncCondition '0x%X'"), this, &Condition.Get());
 
-	AsyncSteps.Add(MakeUnique<FAsyncStep>(DelegateToCall, Condition));
-
-	TryScheduleStart();
+	return AddStep(MakeUnique<FAsyncStep>(DelegateToCall, Condition));
 }
 
-void FAsyncMixin::FLoadingState::AsyncEvent(const FSimpleDelegate& DelegateToCall)
+FAsyncStepId FAsyncMixin::FLoadingState::AsyncEvent(const FSimpleDelegate& DelegateToCall)
 {
 	UE_LOG(LogAsyncMixin, Verbose, TEXT("[0x%X] AsyncEvent"), this);
 
-	AsyncSteps.Add(MakeUnique<FAsyncStep>(DelegateToCall));
-
-	TryScheduleStart();
+	return AddStep(MakeUnique<FAsyncStep>(DelegateToCall));
 }
 
 void FAsyncMixin::FLoadingState::TryScheduleStart()
@@ -337,6 +383,46 @@ bool FAsyncMixin::FLoadingState::IsPendingDestroy() const
 	return DestroyMemoryDelegate.IsValid();
 }
 
+bool FAsyncMixin::FLoadingState::AreStepDependenciesComplete(const FAsyncStep& Step) const
+{
+	for (const int32 DependencyIndex : Step.GetDependencies())
+	{
+		// Anything before the current step has already completed and called back
+		if (DependencyIndex >= CurrentAsyncStep && !AsyncSteps[DependencyIndex]->IsComplete())
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void FAsyncMixin::FLoadingState::TryIssueStep(int32 StepIndex)
+{
+	FAsyncStep* Step = AsyncSteps[StepIndex].Get();
+	if (!Step->IsIssued() && AreStepDependenciesComplete(*Step))
+	{
+		UE_LOG(LogAsyncMixin, Verbose, TEXT("[0x%X] Step %d - Dependencies Loaded (Issuing)"), this, StepIndex + 1);
+		Step->Issue();
+	}
+}
+
+void FAsyncMixin::FLoadingState::IssueAndListenToReadySteps()
+{
+	// Dependencies always come earlier in the list, so a single pass issues everything whose dependencies are already loaded.
+	for (int32 StepIndex = CurrentAsyncStep; StepIndex < AsyncSteps.Num(); ++StepIndex)
+	{
+		TryIssueStep(StepIndex);
+
+		FAsyncStep* Step = AsyncSteps[StepIndex].Get();
+		if (Step->IsIssued() && !Step->IsCompleteDelegateBound() && Step->IsLoadingInProgress())
+		{
+			UE_LOG(LogAsyncMixin, Verbose, TEXT("[0x%X] Step %d - Still Loading (Listening)"), this, StepIndex + 1);
+			Step->BindCompleteDelegate(FSimpleDelegate::CreateSP(this, &FLoadingState::TryCompleteAsyncLoading));
+		}
+	}
+}
+
 void FAsyncMixin::FLoadingState::TryCompleteAsyncLoading()
 {
 	// If we haven't started when we get this callback it means we've already completed
@@ -349,8 +435,16 @@ void FAsyncMixin::FLoadingState::TryCompleteAsyncLoading()
 
 	UE_LOG(LogAsyncMixin, Verbose, TEXT("[0x%X] TryCompleteAsyncLoading - (Current Progress %d/%d)"), this, CurrentAsyncStep + 1, AsyncSteps.Num());
 
+	// In parallel mode we listen to every outstanding step, the callbacks below are still only called in order.
+	if (OwnerRef.bParallelStepIssuance)
+	{
+		IssueAndListenToReadySteps();
+	}
+
 	while (CurrentAsyncStep < AsyncSteps.Num())
 	{
+		TryIssueStep(CurrentAsyncStep);
+
 		FAsyncStep* Step = AsyncSteps[CurrentAsyncStep].Get();
 		if (Step->IsLoadingInProgress())
 		{
@@ -442,6 +536,13 @@ FAsyncMixin::FLoadingState::FAsyncStep::FAsyncStep(const FSimpleDelegate& InUser
 {
 }
 
+FAsyncMixin::FLoadingState::FAsyncStep::FAsyncStep(const FSimpleDelegate& InUserCallback, TFunction<TSharedPtr<FStreamableHandle>()>&& InDeferredRequest, TArray<int32>&& InDependencies)
+	: UserCallback(InUserCallback)
+	, Dependencies(MoveTemp(InDependencies))
+	, DeferredRequest(MoveTemp(InDeferredRequest))
+{
+}
+
 FAsyncMixin::FLoadingState::FAsyncStep::~FAsyncStep()
 {
 
@@ -453,9 +554,22 @@ void FAsyncMixin::FLoadingState::FAsyncStep::ExecuteUserCallback()
 	UserCallback.Unbind();
 }
 
+void FAsyncMixin::FLoadingState::FAsyncStep::Issue()
+{
+	if (DeferredRequest)
+	{
+		StreamingHandle = DeferredRequest();
+		DeferredRequest.Reset();
+	}
+}
+
 bool FAsyncMixin::FLoadingState::FAsyncStep::IsComplete() const
 {
-	if (StreamingHandle.IsValid())
+	if (!IsIssued())
+	{
+		return false;
+	}
+	else if (StreamingHandle.IsValid())
 	{
 		return StreamingHandle->HasLoadCompleted();
 	}
@@ -479,6 +593,7 @@ void FAsyncMixin::FLoadingState::FAsyncStep::Cancel()
 		Condition.Reset();
 	}
 
+	DeferredRequest.Reset();
 	bIsCompletionDelegateBound = false;
 }
 
@@ -13,6 +13,20 @@ class UPrimaryDataAsset;
 
 DECLARE_DELEGATE_OneParam(FStreamableHandleDelegate, TSharedPtr<FStreamableHandle>)
 
+/** Identifies a step queued on an FAsyncMixin, so that later steps can be declared as depending on it. */
+struct FAsyncStepId
+{
+	bool IsValid() const { return StepIndex != INDEX_NONE; }
+
+private:
+	friend class FAsyncMixin;
+
+	int32 StepIndex = INDEX_NONE;
+
+	// Steps are indexed per loading sequence, so canceling starts a new generation and invalidates the old ids
+	uint32 Generation = 0;
+};
+
 //TODO I think we need to introduce a retention policy, preloads automatically stay in memory until canceled
 //     but what if you want to preload individual items just using the AsyncLoad functions?  I don't want to
 //     introduce individual policies per call, or introduce a whole set of preload vs asyncloads, so would
@@ -51,6 +65,12 @@ DECLARE_DELEGATE_OneParam(FStreamableHandleDelegate, TSharedPtr<FStreamableHandl
  * requested the async loads - even if ItemOne or ItemTwo was already loaded when you request it.
  *
  * When all the async loading requests complete, OnFinishedLoading will be called.
+ *
+ * By default each step is only waited on once the steps before it have completed.  If you call
+ * SetParallelStepIssuance(true), every step is issued and waited on as soon as loading starts (conditions start
+ * polling immediately, for example), while the callbacks are still called in the order the steps were declared.
+ * A load that should only be requested once other steps have finished loading can be declared with AsyncLoadAfter,
+ * passing the ids returned when those steps were declared.
  * 
  * If you forget to call StartAsyncLoading(), we'll call it next frame, but you should remember to call it
  * when you're done with your setup, as maybe everything is already loaded, and it will avoid a single frame
@@ -59,10 +79,10 @@ DECLARE_DELEGATE_OneParam(FStreamableHandleDelegate, TSharedPtr<FStreamableHandl
  * NOTE: The FAsyncMixin also makes it safe to pass [this] as a captured input into your lambda, because it handles 
  * unhooking everything if either your owner class is destroyed, or you cancel everything.
  *
- * NOTE: FAsyncMixin doesn't add any additional memory to your class.  Several classes currently handling async loading 
+ * NOTE: FAsyncMixin only adds a single pointer to your class.  Several classes currently handling async loading 
  * internally allocate TSharedPtr<FStreamableHandle> members and tend to hold onto SoftObjectPaths temporary state.  The 
- * FAsyncMixin does all of this internally with a static TMap so that all of the async request memory is stored temporarily
- * and sparsely.
+ * FAsyncMixin allocates all of this internally on demand, and frees it when loading completes, so that all of the
+ * async request memory is stored temporarily and sparsely.
  * 
  * NOTE: For debugging and understanding what's going on, you should add -LogCmds="LogAsyncMixin Verbose" to the command line.
  */
@@ -83,16 +103,16 @@ protected:
 protected:
 	/** Async load a TSoftClassPtr<T>, call the Callback when complete. */
 	template<typename T = UObject>
-	void AsyncLoad(TSoftClassPtr<T> SoftClass, TFunction<void()>&& Callback)
+	FAsyncStepId AsyncLoad(TSoftClassPtr<T> SoftClass, TFunction<void()>&& Callback)
 	{
-		AsyncLoad(SoftClass.ToSoftObjectPath(), FSimpleDelegate::CreateLambda(MoveTemp(Callback)));
+		return AsyncLoad(SoftClass.ToSoftObjectPath(), FSimpleDelegate::CreateLambda(MoveTemp(Callback)));
 	}
 
 	/** Async load a TSoftClassPtr<T>, call the Callback when complete. */
 	template<typename T = UObject>
-	void AsyncLoad(TSoftClassPtr<T> SoftClass, TFunction<void(TSubclassOf<T>)>&& Callback)
+	FAsyncStepId AsyncLoad(TSoftClassPtr<T> SoftClass, TFunction<void(TSubclassOf<T>)>&& Callback)
 	{
-		AsyncLoad(SoftClass.ToSoftObjectPath(),
+		return AsyncLoad(SoftClass.ToSoftObjectPath(),
 			FSimpleDelegate::CreateLambda([SoftClass, UserCallback = MoveTemp(Callback)]() mutable {
 				UserCallback(SoftClass.Get());
 			})
@@ -101,23 +121,23 @@ protected:
 
 	/** Async load a TSoftClassPtr<T>, call the Callback when complete. */
 	template<typename T = UObject>
-	void AsyncLoad(TSoftClassPtr<T> SoftClass, const FSimpleDelegate& Callback = FSimpleDelegate())
+	FAsyncStepId AsyncLoad(TSoftClassPtr<T> SoftClass, const FSimpleDelegate& Callback = FSimpleDelegate())
 	{
-		AsyncLoad(SoftClass.ToSoftObjectPath(), Callback);
+		return AsyncLoad(SoftClass.ToSoftObjectPath(), Callback);
 	}
 
 	/** Async load a TSoftObjectPtr<T>, call the Callback when complete. */
 	template<typename T = UObject>
-	void AsyncLoad(TSoftObjectPtr<T> SoftObject, TFunction<void()>&& Callback)
+	FAsyncStepId AsyncLoad(TSoftObjectPtr<T> SoftObject, TFunction<void()>&& Callback)
 	{
-		AsyncLoad(SoftObject.ToSoftObjectPath(), FSimpleDelegate::CreateLambda(MoveTemp(Callback)));
+		return AsyncLoad(SoftObject.ToSoftObjectPath(), FSimpleDelegate::CreateLambda(MoveTemp(Callback)));
 	}
 
 	/** Async load a TSoftObjectPtr<T>, call the Callback when complete. */
 	template<typename T = UObject>
-	void AsyncLoad(TSoftObjectPtr<T> SoftObject, TFunction<void(T*)>&& Callback)
+	FAsyncStepId AsyncLoad(TSoftObjectPtr<T> SoftObject, TFunction<void(T*)>&& Callback)
 	{
-		AsyncLoad(SoftObject.ToSoftObjectPath(),
+		return AsyncLoad(SoftObject.ToSoftObjectPath(),
 			FSimpleDelegate::CreateLambda([SoftObject, UserCallback = MoveTemp(Callback)]() mutable {
 				UserCallback(SoftObject.Get());
 			})
@@ -126,26 +146,35 @@ protected:
 
 	/** Async load a TSoftObjectPtr<T>, call the Callback when complete. */
 	template<typename T = UObject>
-	void AsyncLoad(TSoftObjectPtr<T> SoftObject, const FSimpleDelegate& Callback = FSimpleDelegate())
+	FAsyncStepId AsyncLoad(TSoftObjectPtr<T> SoftObject, const FSimpleDelegate& Callback = FSimpleDelegate())
 	{
-		AsyncLoad(SoftObject.ToSoftObjectPath(), Callback);
+		return AsyncLoad(SoftObject.ToSoftObjectPath(), Callback);
 	}
 
 	/** Async load a FSoftObjectPath, call the Callback when complete. */
-	void AsyncLoad(FSoftObjectPath SoftObjectPath, const FSimpleDelegate& Callback = FSimpleDelegate());
+	FAsyncStepId AsyncLoad(FSoftObjectPath SoftObjectPath, const FSimpleDelegate& Callback = FSimpleDelegate());
 
 	/** Async load an array of FSoftObjectPath, call the Callback when complete. */
-	void AsyncLoad(const TArray<FSoftObjectPath>& SoftObjectPaths, TFunction<void()>&& Callback)
+	FAsyncStepId AsyncLoad(const TArray<FSoftObjectPath>& SoftObjectPaths, TFunction<void()>&& Callback)
 	{
-		AsyncLoad(SoftObjectPaths, FSimpleDelegate::CreateLambda(MoveTemp(Callback)));
+		return AsyncLoad(SoftObjectPaths, FSimpleDelegate::CreateLambda(MoveTemp(Callback)));
 	}
 
 	/** Async load an array of FSoftObjectPath, call the Callback when complete. */
-	void AsyncLoad(const TArray<FSoftObjectPath>& SoftObjectPaths, const FSimpleDelegate& Callback = FSimpleDelegate());
+	FAsyncStepId AsyncLoad(const TArray<FSoftObjectPath>& SoftObjectPaths, const FSimpleDelegate& Callback = FSimpleDelegate());
+
+	/** Async load an array of FSoftObjectPath once all of the Dependencies have finished loading, call the Callback when complete. */
+	FAsyncStepId AsyncLoadAfter(TConstArrayView<FAsyncStepId> Dependencies, const TArray<FSoftObjectPath>& SoftObjectPaths, TFunction<void()>&& Callback)
+	{
+		return AsyncLoadAfter(Dependencies, SoftObjectPaths, FSimpleDelegate::CreateLambda(MoveTemp(Callback)));
+	}
+
+	/** Async load an array of FSoftObjectPath once all of the Dependencies have finished loading, call the Callback when complete. */
+	FAsyncStepId AsyncLoadAfter(TConstArrayView<FAsyncStepId> Dependencies, const TArray<FSoftObjectPath>& SoftObjectPaths, const FSimpleDelegate& Callback = FSimpleDelegate());
 
 	/** Given an array of primary assets, it loads all of the bundles referenced by properties of these assets specified in the LoadBundles array. */
 	template<typename T = UPrimaryDataAsset>
-	void AsyncPreloadPrimaryAssetsAndBundles(const TArray<T*>& Assets, const TArray<FName>& LoadBundles, const FSimpleDelegate& Callback = FSimpleDelegate())
+	FAsyncStepId AsyncPreloadPrimaryAssetsAndBundles(const TArray<T*>& Assets, const TArray<FName>& LoadBundles, const FSimpleDelegate& Callback = FSimpleDelegate())
 	{
 		TArray<FPrimaryAssetId> PrimaryAssetIds;
 		for (const T* Item : Assets)
@@ -153,29 +182,29 @@ protected:
 			PrimaryAssetIds.Add(Item);
 		}
 
-		AsyncPreloadPrimaryAssetsAndBundles(PrimaryAssetIds, LoadBundles, Callback);
+		return AsyncPreloadPrimaryAssetsAndBundles(PrimaryAssetIds, LoadBundles, Callback);
 	}
 
 	/** Given an array of primary asset ids, it loads all of the bundles referenced by properties of these assets specified in the LoadBundles array. */
-	void AsyncPreloadPrimaryAssetsAndBundles(const TArray<FPrimaryAssetId>& AssetIds, const TArray<FName>& LoadBundles, TFunction<void()>&& Callback)
+	FAsyncStepId AsyncPreloadPrimaryAssetsAndBundles(const TArray<FPrimaryAssetId>& AssetIds, const TArray<FName>& LoadBundles, TFunction<void()>&& Callback)
 	{
-		AsyncPreloadPrimaryAssetsAndBundles(AssetIds, LoadBundles, FSimpleDelegate::CreateLambda(MoveTemp(Callback)));
+		return AsyncPreloadPrimaryAssetsAndBundles(AssetIds, LoadBundles, FSimpleDelegate::CreateLambda(MoveTemp(Callback)));
 	}
 
 	/** Given an array of primary asset ids, it loads all of the bundles referenced by properties of these assets specified in the LoadBundles array. */
-	void AsyncPreloadPrimaryAssetsAndBundles(const TArray<FPrimaryAssetId>& AssetIds, const TArray<FName>& LoadBundles, const FSimpleDelegate& Callback = FSimpleDelegate());
+	FAsyncStepId AsyncPreloadPrimaryAssetsAndBundles(const TArray<FPrimaryAssetId>& AssetIds, const TArray<FName>& LoadBundles, const FSimpleDelegate& Callback = FSimpleDelegate());
 
 	/** Add a future condition that must be true before we move forward. */
-	void AsyncCondition(TSharedRef<FAsyncCondition> Condition, const FSimpleDelegate& Callback = FSimpleDelegate());
+	FAsyncStepId AsyncCondition(TSharedRef<FAsyncCondition> Condition, const FSimpleDelegate& Callback = FSimpleDelegate());
 
 	/**
 	 * Rather than load anything, this callback is just inserted into the callback sequence so that when async loading 
 	 * completes this event will be called at the same point in the sequence.  Super useful if you don't want a step to be
 	 * tied to a particular asset in case some of the assets are optional.
 	 */
-	void AsyncEvent(TFunction<void()>&& Callback)
+	FAsyncStepId AsyncEvent(TFunction<void()>&& Callback)
 	{
-		AsyncEvent(FSimpleDelegate::CreateLambda(MoveTemp(Callback)));
+		return AsyncEvent(FSimpleDelegate::CreateLambda(MoveTemp(Callback)));
 	}
 
 	/**
@@ -183,7 +212,7 @@ protected:
 	 * completes this event will be called at the same point in the sequence.  Super useful if you don't want a step to be
 	 * tied to a particular asset in case some of the assets are optional.
 	 */
-	void AsyncEvent(const FSimpleDelegate& Callback);
+	FAsyncStepId AsyncEvent(const FSimpleDelegate& Callback);
 
 	/** Flushes any async loading requests. */
 	void StartAsyncLoading();
@@ -194,10 +223,16 @@ protected:
 	/** Is async loading current in progress? */
 	bool IsAsyncLoadingInProgress() const;
 
+	/**
+	 * Should every step be issued and waited on as soon as loading starts, rather than once the steps before it have completed?
+	 * Callbacks are called in the order the steps were declared either way.
+	 */
+	void SetParallelStepIssuance(bool bInParallelStepIssuance) { bParallelStepIssuance = bInParallelStepIssuance; }
+
 private:
 	/**
-	 * The FLoadingState is what actually is allocated for the FAsyncMixin in a big map so that the FAsyncMixin itself holds no
-	 * no memory, and we dynamically create the FLoadingState only if needed, and destroy it when it's unneeded.
+	 * The FLoadingState is what actually is allocated for the FAsyncMixin so that the FAsyncMixin itself holds almost no
+	 * memory, we dynamically create the FLoadingState only if needed, and destroy it when it's unneeded.
 	 */
 	class FLoadingState : public TSharedFromThis<FLoadingState>
 	{
@@ -211,11 +246,12 @@ private:
 		/** Cancels the async sequence. */
 		void CancelAndDestroy();
 
-		void AsyncLoad(FSoftObjectPath SoftObject, const FSimpleDelegate& DelegateToCall);
-		void AsyncLoad(const TArray<FSoftObjectPath>& SoftObjectPaths, const FSimpleDelegate& DelegateToCall);
-		void AsyncPreloadPrimaryAssetsAndBundles(const TArray<FPrimaryAssetId>& PrimaryAssetIds, const TArray<FName>& LoadBundles, const FSimpleDelegate& DelegateToCall);
-		void AsyncCondition(TSharedRef<FAsyncCondition> Condition, const FSimpleDelegate& Callback);
-		void AsyncEvent(const FSimpleDelegate& Callback);
+		FAsyncStepId AsyncLoad(FSoftObjectPath SoftObject, const FSimpleDelegate& DelegateToCall);
+		FAsyncStepId AsyncLoad(const TArray<FSoftObjectPath>& SoftObjectPaths, const FSimpleDelegate& DelegateToCall);
+		FAsyncStepId AsyncLoadAfter(TConstArrayView<FAsyncStepId> Dependencies, const TArray<FSoftObjectPath>& SoftObjectPaths, const FSimpleDelegate& DelegateToCall);
+		FAsyncStepId AsyncPreloadPrimaryAssetsAndBundles(const TArray<FPrimaryAssetId>& PrimaryAssetIds, const TArray<FName>& LoadBundles, const FSimpleDelegate& DelegateToCall);
+		FAsyncStepId AsyncCondition(TSharedRef<FAsyncCondition> Condition, const FSimpleDelegate& Callback);
+		FAsyncStepId AsyncEvent(const FSimpleDelegate& Callback);
 
 		bool IsLoadingComplete() const { return !IsLoadingInProgress(); }
 		bool IsLoadingInProgress() const;
@@ -229,6 +265,12 @@ private:
 		void TryCompleteAsyncLoading();
 		void CompleteAsyncLoading();
 
+		class FAsyncStep;
+		FAsyncStepId AddStep(TUniquePtr<FAsyncStep>&& Step);
+		bool AreStepDependenciesComplete(const FAsyncStep& Step) const;
+		void TryIssueStep(int32 StepIndex);
+		void IssueAndListenToReadySteps();
+
 	private:
 		void RequestDestroyThisMemory();
 		void CancelDestroyThisMemory(bool bDestroying);
@@ -248,6 +290,7 @@ private:
 			FAsyncStep(const FSimpleDelegate& InUserCallback);
 			FAsyncStep(const FSimpleDelegate& InUserCallback, const TSharedPtr<FStreamableHandle>& InStreamingHandle);
 			FAsyncStep(const FSimpleDelegate& InUserCallback, const TSharedPtr<FAsyncCondition>& InCondition);
+			FAsyncStep(const FSimpleDelegate& InUserCallback, TFunction<TSharedPtr<FStreamableHandle>()>&& InDeferredRequest, TArray<int32>&& InDependencies);
 
 			~FAsyncStep();
 
@@ -264,10 +307,20 @@ private:
 			bool BindCompleteDelegate(const FSimpleDelegate& NewDelegate);
 			bool IsCompleteDelegateBound() const;
 
+			/** Steps declared with dependencies don't request their load until Issue() is called */
+			bool IsIssued() const { return !DeferredRequest; }
+			void Issue();
+
+			const TArray<int32>& GetDependencies() const { return Dependencies; }
+
 		private:
 			FSimpleDelegate UserCallback;
 			bool bIsCompletionDelegateBound = false;
 
+			// Indices of the earlier steps that must finish loading before this one is issued
+			TArray<int32> Dependencies;
+			TFunction<TSharedPtr<FStreamableHandle>()> DeferredRequest;
+
 			// Possible Async 'thing'
 			TSharedPtr<FStreamableHandle> StreamingHandle;
 			TSharedPtr<FAsyncCondition> Condition;
@@ -275,6 +328,8 @@ private:
 
 		bool bHasStarted = false;
 
+		uint32 StepGeneration = 0;
+
 		int32 CurrentAsyncStep = 0;
 		TArray<TUniquePtr<FAsyncStep>> AsyncSteps;
 		TArray<TUniquePtr<FAsyncStep>> AsyncStepsPendingDestruction;
@@ -292,7 +347,9 @@ private:
 	bool IsLoadingInProgressOrPending() const;
 
 private:
-	static TMap<FAsyncMixin*, TSharedRef<FLoadingState>> Loading;
+	TSharedPtr<FLoadingState> LoadingState;
+
+	bool bParallelStepIssuance = false;
 };
 
 /**
@@ -307,6 +364,8 @@ class ASYNCMIXIN_API FAsyncScope : public FAsyncMixin
 public:
 	using FAsyncMixin::AsyncLoad;
 
+	using FAsyncMixin::AsyncLoadAfter;
+
 	using FAsyncMixin::AsyncPreloadPrimaryAssetsAndBundles;
 
 	using FAsyncMixin::AsyncCondition;
@@ -318,6 +377,8 @@ public:
 	using FAsyncMixin::StartAsyncLoading;
 
 	using FAsyncMixin::IsAsyncLoadingInProgress;
+
+	using FAsyncMixin::SetParallelStepIssuance;
 };
 
 //------------------------------------------------------------------------------
@@ -407,6 +407,305 @@ FBox2D FAimAssistOwnerViewData::ProjectCapsuleToScreen(const FCollisionShape& Sh
 	return Box2D;
 }
 
+///////////////////////////////////////////////////////////////////
+// FAimAssistShapeProjectionBatch
+
+void FAimAssistShapeProjectionBatch::Reset(const FAimAssistOwnerViewData& ViewData)
+{
+	ViewOrigin = ViewData.ViewTransform.GetTranslation();
+	ViewAxisY = ViewData.ViewTransform.GetUnitAxis(EAxis::Y);
+	ViewAxisZ = ViewData.ViewTransform.GetUnitAxis(EAxis::Z);
+
+	VertexX.Reset();
+	VertexY.Reset();
+	VertexZ.Reset();
+	NumVertices = 0;
+
+	ShapeVertexRanges.Reset();
+	ScreenBounds.Reset();
+}
+
+void FAimAssistShapeProjectionBatch::AddVertex(const FVector& WorldLocation)
+{
+	// Rebase on the view origin in double precision so the float projection doesn't lose precision far from the world origin
+	const FVector RelativeLocation = (WorldLocation - ViewOrigin);
+
+	VertexX.Add(static_cast<float>(RelativeLocation.X));
+	VertexY.Add(static_cast<float>(RelativeLocation.Y));
+	VertexZ.Add(static_cast<float>(RelativeLocation.Z));
+	++NumVertices;
+}
+
+int32 FAimAssistShapeProjectionBatch::AddShape(const FCollisionShape& Shape, const FVector& ShapeOrigin, const FTransform& WorldTransform)
+{
+	const int32 FirstVertex = NumVertices;
+
+	// The vertices match the ones used by FAimAssistOwnerViewData::ProjectBoxToScreen, ProjectSphereToScreen and ProjectCapsuleToScreen
+	switch (Shape.ShapeType)
+	{
+	case ECollisionShape::Box:
+	{
+		const FVector BoxExtents = Shape.GetBox();
+
+		for (int32 CornerIndex = 0; CornerIndex < 8; ++CornerIndex)
+		{
+			const FVector Corner(
+				(CornerIndex & 4) ? BoxExtents.X : -BoxExtents.X,
+				(CornerIndex & 2) ? BoxExtents.Y : -BoxExtents.Y,
+				(CornerIndex & 1) ? BoxExtents.Z : -BoxExtents.Z);
+
+			AddVertex(WorldTransform.TransformPositionNoScale(Corner + ShapeOrigin));
+		}
+		break;
+	}
+	case ECollisionShape::Sphere:
+	{
+		const float SphereRadius = Shape.GetSphereRadius();
+		const FVector SphereLocation = WorldTransform.TransformPositionNoScale(ShapeOrigin);
+		const FVector SphereExtent = (ViewAxisY * SphereRadius) + (ViewAxisZ * SphereRadius);
+
+		AddVertex(SphereLocation + SphereExtent);
+		AddVertex(SphereLocation - SphereExtent);
+		break;
+	}
+	case ECollisionShape::Capsule:
+	{
+		const float CapsuleAxisHalfLength = Shape.GetCapsuleAxisHalfLength();
+		const float CapsuleRadius = Shape.GetCapsuleRadius();
+
+		const FVector TopSphereLocation = WorldTransform.TransformPositionNoScale(FVector(0.0f, 0.0f, CapsuleAxisHalfLength) + ShapeOrigin);
+		const FVector BottomSphereLocation = WorldTransform.TransformPositionNoScale(FVector(0.0f, 0.0f, -CapsuleAxisHalfLength) + ShapeOrigin);
+		const FVector SphereExtent = (ViewAxisY * CapsuleRadius) + (ViewAxisZ * CapsuleRadius);
+
+		AddVertex(TopSphereLocation + SphereExtent);
+		AddVertex(TopSphereLocation - SphereExtent);
+		AddVertex(BottomSphereLocation + SphereExtent);
+		AddVertex(BottomSphereLocation - SphereExtent);
+		break;
+	}
+	default:
+		UE_LOG(LogAimAssist, Warning, TEXT("FAimAssistShapeProjectionBatch::AddShape() - Invalid shape type!"));
+		return INDEX_NONE;
+	}
+
+	return ShapeVertexRanges.Emplace(FirstVertex, (NumVertices - FirstVertex));
+}
+
+void FAimAssistShapeProjectionBatch::Project(const FAimAssistOwnerViewData& ViewData)
+{
+	// Pad the vertices out to whole vector registers
+	const int32 NumGroups = FMath::DivideAndRoundUp(NumVertices, 4);
+	const int32 NumPaddedVertices = (NumGroups * 4);
+
+	VertexX.SetNumZeroed(NumPaddedVertices);
+	VertexY.SetNumZeroed(NumPaddedVertices);
+	VertexZ.SetNumZeroed(NumPaddedVertices);
+	ScreenX.SetNumUninitialized(NumPaddedVertices);
+	ScreenY.SetNumUninitialized(NumPaddedVertices);
+	VertexGroupMasks.SetNumUninitialized(NumGroups);
+
+	// Fold the view origin into the view projection matrix since the vertices are relative to it
+	const FMatrix44f RelativeViewProjection(FTranslationMatrix(ViewOrigin) * ViewData.ViewProjectionMatrix);
+
+	const VectorRegister4Float M00 = VectorSetFloat1(RelativeViewProjection.M[0][0]);
+	const VectorRegister4Float M10 = VectorSetFloat1(RelativeViewProjection.M[1][0]);
+	const VectorRegister4Float M20 = VectorSetFloat1(RelativeViewProjection.M[2][0]);
+	const VectorRegister4Float M30 = VectorSetFloat1(RelativeViewProjection.M[3][0]);
+	const VectorRegister4Float M01 = VectorSetFloat1(RelativeViewProjection.M[0][1]);
+	const VectorRegister4Float M11 = VectorSetFloat1(RelativeViewProjection.M[1][1]);
+	const VectorRegister4Float M21 = VectorSetFloat1(RelativeViewProjection.M[2][1]);
+	const VectorRegister4Float M31 = VectorSetFloat1(RelativeViewProjection.M[3][1]);
+	const VectorRegister4Float M03 = VectorSetFloat1(RelativeViewProjection.M[0][3]);
+	const VectorRegister4Float M13 = VectorSetFloat1(RelativeViewProjection.M[1][3]);
+	const VectorRegister4Float M23 = VectorSetFloat1(RelativeViewProjection.M[2][3]);
+	const VectorRegister4Float M33 = VectorSetFloat1(RelativeViewProjection.M[3][3]);
+
+	const VectorRegister4Float Zero = VectorZeroFloat();
+	const VectorRegister4Float One = VectorOneFloat();
+	const VectorRegister4Float Half = VectorSetFloat1(0.5f);
+	const VectorRegister4Float ViewWidth = VectorSetFloat1(static_cast<float>(ViewData.ViewRect.Width()));
+	const VectorRegister4Float ViewHeight = VectorSetFloat1(static_cast<float>(ViewData.ViewRect.Height()));
+	const VectorRegister4Float ViewMinX = VectorSetFloat1(static_cast<float>(ViewData.ViewRect.Min.X));
+	const VectorRegister4Float ViewMinY = VectorSetFloat1(static_cast<float>(ViewData.ViewRect.Min.Y));
+
+	for (int32 GroupIndex = 0; GroupIndex < NumGroups; ++GroupIndex)
+	{
+		const int32 Offset = (GroupIndex * 4);
+
+		const VectorRegister4Float X = VectorLoad(&VertexX[Offset]);
+		const VectorRegister4Float Y = VectorLoad(&VertexY[Offset]);
+		const VectorRegister4Float Z = VectorLoad(&VertexZ[Offset]);
+
+		// Same as FMatrix::TransformFVector4 with W = 1, Z isn't needed for the screen position
+		const VectorRegister4Float ClipX = VectorMultiplyAdd(Z, M20, VectorMultiplyAdd(Y, M10, VectorMultiplyAdd(X, M00, M30)));
+		const VectorRegister4Float ClipY = VectorMultiplyAdd(Z, M21, VectorMultiplyAdd(Y, M11, VectorMultiplyAdd(X, M01, M31)));
+		const VectorRegister4Float ClipW = VectorMultiplyAdd(Z, M23, VectorMultiplyAdd(Y, M13, VectorMultiplyAdd(X, M03, M33)));
+
+		const VectorRegister4Float InFrontMask = VectorCompareGT(ClipW, Zero);
+		VertexGroupMasks[GroupIndex] = static_cast<uint8>(VectorMaskBits(InFrontMask));
+
+		// Vertices behind the view are masked out, just keep them from dividing by zero
+		const VectorRegister4Float SafeW = VectorSelect(InFrontMask, ClipW, One);
+		const VectorRegister4Float ProjectedX = VectorDivide(ClipX, SafeW);
+		const VectorRegister4Float ProjectedY = VectorDivide(ClipY, SafeW);
+
+		// Move from projection space to the view rect, as FSceneView::ProjectWorldToScreen does
+		const VectorRegister4Float NormalizedX = VectorMultiplyAdd(ProjectedX, Half, Half);
+		const VectorRegister4Float NormalizedY = VectorSubtract(Half, VectorMultiply(ProjectedY, Half));
+
+		VectorStore(VectorMultiplyAdd(NormalizedX, ViewWidth, ViewMinX), &ScreenX[Offset]);
+		VectorStore(VectorMultiplyAdd(NormalizedY, ViewHeight, ViewMinY), &ScreenY[Offset]);
+	}
+
+	ScreenBounds.Reset(ShapeVertexRanges.Num());
+
+	for (const TPair<int32, int32>& VertexRange : ShapeVertexRanges)
+	{
+		FBox2D Box2D(ForceInitToZero);
+
+		const int32 EndVertex = (VertexRange.Key + VertexRange.Value);
+		for (int32 VertexIndex = VertexRange.Key; VertexIndex < EndVertex; ++VertexIndex)
+		{
+			if (VertexGroupMasks[VertexIndex >> 2] & (1 << (VertexIndex & 3)))
+			{
+				Box2D += FVector2D(ScreenX[VertexIndex], ScreenY[VertexIndex]);
+			}
+		}
+
+		ScreenBounds.Add(Box2D);
+	}
+}
+
+double FAimAssistShapeProjectionBatch::GetScreenBoundsDifference(const FBox2D& BoundsA, const FBox2D& BoundsB)
+{
+	if (BoundsA.bIsValid != BoundsB.bIsValid)
+	{
+		return -1.0;
+	}
+
+	if (!BoundsA.bIsValid)
+	{
+		return 0.0;
+	}
+
+	const FVector2D MinDifference = (BoundsA.Min - BoundsB.Min).GetAbs();
+	const FVector2D MaxDifference = (BoundsA.Max - BoundsB.Max).GetAbs();
+
+	return FMath::Max(MinDifference.GetMax(), MaxDifference.GetMax());
+}
+
+#if !UE_BUILD_SHIPPING
+static void BenchmarkAimAssistShapeProjection(const TArray<FString>& Args, UWorld* World)
+{
+	const int32 NumShapes = (Args.Num() > 0) ? FMath::Max(1, FCString::Atoi(*Args[0])) : 64;
+	const int32 NumIterations = (Args.Num() > 1) ? FMath::Max(1, FCString::Atoi(*Args[1])) : 1000;
+
+	FAimAssistOwnerViewData ViewData;
+	ViewData.UpdateViewData(World ? World->GetFirstPlayerController() : nullptr);
+
+	if (!ViewData.IsDataValid())
+	{
+		UE_LOG(LogAimAssist, Warning, TEXT("Lyra.AimAssist.BenchmarkProjection needs a local player with a pawn."));
+		return;
+	}
+
+	struct FBenchmarkShape
+	{
+		FCollisionShape Shape;
+		FVector ShapeOrigin;
+		FTransform WorldTransform;
+	};
+
+	// Scatter a fixed set of shapes around the view so runs are comparable
+	FRandomStream RandomStream(NumShapes);
+	const FVector ViewLocation = ViewData.ViewTransform.GetTranslation();
+	const FVector ViewAxisX = ViewData.ViewTransform.GetUnitAxis(EAxis::X);
+	const FVector ViewAxisY = ViewData.ViewTransform.GetUnitAxis(EAxis::Y);
+	const FVector ViewAxisZ = ViewData.ViewTransform.GetUnitAxis(EAxis::Z);
+
+	TArray<FBenchmarkShape> Shapes;
+	Shapes.Reserve(NumShapes);
+
+	for (int32 ShapeIndex = 0; ShapeIndex < NumShapes; ++ShapeIndex)
+	{
+		FBenchmarkShape& BenchmarkShape = Shapes.AddDefaulted_GetRef();
+
+		switch (ShapeIndex % 3)
+		{
+		case 0:
+			BenchmarkShape.Shape = FCollisionShape::MakeBox(FVector3f(RandomStream.FRandRange(10.0f, 100.0f), RandomStream.FRandRange(10.0f, 100.0f), RandomStream.FRandRange(10.0f, 100.0f)));
+			break;
+		case 1:
+			BenchmarkShape.Shape = FCollisionShape::MakeSphere(RandomStream.FRandRange(10.0f, 100.0f));
+			break;
+		default:
+			BenchmarkShape.Shape = FCollisionShape::MakeCapsule(RandomStream.FRandRange(20.0f, 50.0f), RandomStream.FRandRange(50.0f, 100.0f));
+			break;
+		}
+
+		// Some of the shapes end up behind the view to cover the clipped case
+		const FVector Location = ViewLocation
+			+ (ViewAxisX * RandomStream.FRandRange(-500.0f, 5000.0f))
+			+ (ViewAxisY * RandomStream.FRandRange(-2000.0f, 2000.0f))
+			+ (ViewAxisZ * RandomStream.FRandRange(-1000.0f, 1000.0f));
+
+		BenchmarkShape.ShapeOrigin = FVector(0.0f, 0.0f, RandomStream.FRandRange(-50.0f, 50.0f));
+		BenchmarkShape.WorldTransform = FTransform(FRotator(0.0f, RandomStream.FRandRange(0.0f, 360.0f), 0.0f), Location);
+	}
+
+	TArray<FBox2D> ScalarBounds;
+	ScalarBounds.SetNum(NumShapes);
+
+	const double ScalarStartTime = FPlatformTime::Seconds();
+	for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+	{
+		for (int32 ShapeIndex = 0; ShapeIndex < NumShapes; ++ShapeIndex)
+		{
+			const FBenchmarkShape& BenchmarkShape = Shapes[ShapeIndex];
+			ScalarBounds[ShapeIndex] = ViewData.ProjectShapeToScreen(BenchmarkShape.Shape, BenchmarkShape.ShapeOrigin, BenchmarkShape.WorldTransform);
+		}
+	}
+	const double ScalarTime = (FPlatformTime::Seconds() - ScalarStartTime);
+
+	FAimAssistShapeProjectionBatch Batch;
+
+	const double BatchedStartTime = FPlatformTime::Seconds();
+	for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+	{
+		Batch.Reset(ViewData);
+		for (const FBenchmarkShape& BenchmarkShape : Shapes)
+		{
+			Batch.AddShape(BenchmarkShape.Shape, BenchmarkShape.ShapeOrigin, BenchmarkShape.WorldTransform);
+		}
+		Batch.Project(ViewData);
+	}
+	const double BatchedTime = (FPlatformTime::Seconds() - BatchedStartTime);
+
+	double MaxDifference = 0.0;
+	int32 NumValidityMismatches = 0;
+	for (int32 ShapeIndex = 0; ShapeIndex < NumShapes; ++ShapeIndex)
+	{
+		const double Difference = FAimAssistShapeProjectionBatch::GetScreenBoundsDifference(Batch.GetScreenBounds(ShapeIndex), ScalarBounds[ShapeIndex]);
+		if (Difference < 0.0)
+		{
+			++NumValidityMismatches;
+		}
+		else
+		{
+			MaxDifference = FMath::Max(MaxDifference, Difference);
+		}
+	}
+
+	UE_LOG(LogAimAssist, Display, TEXT("Aim assist shape projection, %d shapes x %d iterations: scalar %.3f ms, batched %.3f ms (%.2fx). Max difference %.4f px, %d validity mismatches."),
+		NumShapes, NumIterations, ScalarTime * 1000.0, BatchedTime * 1000.0, (BatchedTime > 0.0) ? (ScalarTime / BatchedTime) : 0.0, MaxDifference, NumValidityMismatches);
+}
+
+static FAutoConsoleCommandWithWorldAndArgs BenchmarkAimAssistShapeProjectionCommand(
+	TEXT("Lyra.AimAssist.BenchmarkProjection"),
+	TEXT("Projects random target shapes around the first local player's view with the scalar and batched aim assist paths, then logs the timings and the largest difference between them. Usage: Lyra.AimAssist.BenchmarkProjection [NumShapes] [NumIterations]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(BenchmarkAimAssistShapeProjection));
+#endif // !UE_BUILD_SHIPPING
+
 ///////////////////////////////////////////////////////////////////
 // UAimAssistInputModifier
 
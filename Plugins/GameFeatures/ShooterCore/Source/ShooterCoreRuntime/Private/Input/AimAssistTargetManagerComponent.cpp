@@ -23,6 +23,22 @@ namespace LyraConsoleVariables
 		bDrawDebugViewfinder,
 		TEXT("Should we draw a debug box for the aim assist target viewfinder?"),
 		ECVF_Cheat);
+
+	static bool bBatchAimAssistProjection = true;
+	static FAutoConsoleVariableRef CVarBatchAimAssistProjection(
+		TEXT("lyra.Weapon.AimAssist.BatchProjection"),
+		bBatchAimAssistProjection,
+		TEXT("Should the screen bounds of all aim assist targets be projected in one batched pass?"),
+		ECVF_Default);
+
+#if !UE_BUILD_SHIPPING
+	static bool bVerifyAimAssistProjection = false;
+	static FAutoConsoleVariableRef CVarVerifyAimAssistProjection(
+		TEXT("lyra.Weapon.AimAssist.VerifyBatchProjection"),
+		bVerifyAimAssistProjection,
+		TEXT("Should batched aim assist projections be checked against the scalar projection, logging any target that differs by more than a pixel?"),
+		ECVF_Cheat);
+#endif // !UE_BUILD_SHIPPING
 }
 
 const FLyraAimAssistTarget* FindTarget(const TArray<FLyraAimAssistTarget>& Targets, const UShapeComponent* TargetComponent)
@@ -167,6 +183,22 @@ void UAimAssistTargetManagerComponent::GetVisibleTargets(const FAimAssistFilter&
 	{
 		const FVector PawnLocation = OwnerPawn->GetActorLocation();		
 		
+		struct FCandidateTarget
+		{
+			const FAimAssistTargetOptions* TargetOptions = nullptr;
+			FTransform Transform;
+			FCollisionShape Shape;
+			FVector ShapeOrigin;
+			float ViewDistance = 0.0f;
+			float ViewDot = 0.0f;
+			int32 ProjectionIndex = INDEX_NONE;
+		};
+
+		const bool bBatchProjection = LyraConsoleVariables::bBatchAimAssistProjection;
+		ProjectionBatch.Reset(OwnerData);
+
+		TArray<FCandidateTarget, TInlineAllocator<16>> CandidateTargets;
+
 		for (FAimAssistTargetOptions& AimAssistTarget : NewTargetData)
 		{
 			if (!DoesTargetPassFilter(OwnerData, Filter, AimAssistTarget, TargetRange))
@@ -196,7 +228,34 @@ void UAimAssistTargetManagerComponent::GetVisibleTargets(const FAimAssistFilter&
 			{
 				continue;
 			}
-			
+
+			FCandidateTarget& Candidate = CandidateTargets.AddDefaulted_GetRef();
+			Candidate.TargetOptions = &AimAssistTarget;
+			Candidate.Transform = TargetTransform;
+			Candidate.Shape = TargetShape;
+			Candidate.ShapeOrigin = TargetShapeOrigin;
+			Candidate.ViewDistance = TargetViewDistance;
+			Candidate.ViewDot = TargetViewDot;
+
+			if (bBatchProjection)
+			{
+				Candidate.ProjectionIndex = ProjectionBatch.AddShape(TargetShape, TargetShapeOrigin, TargetTransform);
+			}
+		}
+
+		// Project the shapes of all the candidates in one pass
+		if (bBatchProjection)
+		{
+			ProjectionBatch.Project(OwnerData);
+		}
+
+		for (const FCandidateTarget& Candidate : CandidateTargets)
+		{
+			const FAimAssistTargetOptions& AimAssistTarget = *Candidate.TargetOptions;
+			const FTransform& TargetTransform = Candidate.Transform;
+			const float TargetViewDistance = Candidate.ViewDistance;
+			const float TargetViewDot = Candidate.ViewDot;
+
 			const FLyraAimAssistTarget* OldTarget = FindTarget(OldTargets, AimAssistTarget.TargetShapeComponent.Get());
 
 			// Calculate the screen bounds for this target
@@ -204,7 +263,27 @@ void UAimAssistTargetManagerComponent::GetVisibleTargets(const FAimAssistFilter&
 			const bool bUpdateTargetProjections = true;
 			if (bUpdateTargetProjections)
 			{
-				TargetScreenBounds = OwnerData.ProjectShapeToScreen(TargetShape, TargetShapeOrigin, TargetTransform);
+				if (Candidate.ProjectionIndex != INDEX_NONE)
+				{
+					TargetScreenBounds = ProjectionBatch.GetScreenBounds(Candidate.ProjectionIndex);
+
+#if !UE_BUILD_SHIPPING
+					if (LyraConsoleVariables::bVerifyAimAssistProjection)
+					{
+						const FBox2D ScalarScreenBounds = OwnerData.ProjectShapeToScreen(Candidate.Shape, Candidate.ShapeOrigin, TargetTransform);
+						const double Difference = FAimAssistShapeProjectionBatch::GetScreenBoundsDifference(TargetScreenBounds, ScalarScreenBounds);
+						if ((Difference < 0.0) || (Difference > 1.0))
+						{
+							UE_LOG(LogAimAssist, Warning, TEXT("Batched aim assist projection of [%s] differs from the scalar projection (Batched: %s, Scalar: %s)"),
+								*GetNameSafe(AimAssistTarget.TargetShapeComponent.Get()), *TargetScreenBounds.ToString(), *ScalarScreenBounds.ToString());
+						}
+					}
+#endif // !UE_BUILD_SHIPPING
+				}
+				else
+				{
+					TargetScreenBounds = OwnerData.ProjectShapeToScreen(Candidate.Shape, Candidate.ShapeOrigin, TargetTransform);
+				}
 			}
 			else
 			{
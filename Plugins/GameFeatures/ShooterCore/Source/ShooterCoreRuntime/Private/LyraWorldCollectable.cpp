@@ -2,11 +2,33 @@
 
 #include "LyraWorldCollectable.h"
 #include "EngineUtils.h"
+#include "Interaction/LyraInteractionSubsystem.h"
 
 ALyraWorldCollectable::ALyraWorldCollectable()
 {
 }
 
+void ALyraWorldCollectable::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// Our option doesn't depend on who is asking, so the registry can cache it
+	if (ULyraInteractionSubsystem* InteractionSubsystem = UWorld::GetSubsystem<ULyraInteractionSubsystem>(GetWorld()))
+	{
+		InteractionSubsystem->RegisterInteractableTarget(this, /*bCacheOptions=*/ true);
+	}
+}
+
+void ALyraWorldCollectable::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (ULyraInteractionSubsystem* InteractionSubsystem = UWorld::GetSubsystem<ULyraInteractionSubsystem>(GetWorld()))
+	{
+		InteractionSubsystem->UnregisterInteractableTarget(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
 void ALyraWorldCollectable::GatherInteractionOptions(const FInteractionQuery& InteractQuery, FInteractionOptionBuilder& InteractionBuilder)
 {
 	InteractionBuilder.AddInteractionOption(Option);
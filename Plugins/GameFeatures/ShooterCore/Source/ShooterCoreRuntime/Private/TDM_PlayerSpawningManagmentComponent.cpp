@@ -1,16 +1,17 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "TDM_PlayerSpawningManagmentComponent.h"
-#include "Character/LyraPawn.h"
 #include "Teams/LyraTeamSubsystem.h"
-#include "GameModes/LyraGameState.h"
-#include "GameFramework/PlayerState.h"
 #include "Player/LyraPlayerStart.h"
 #include "Engine/World.h"
 
 UTDM_PlayerSpawningManagmentComponent::UTDM_PlayerSpawningManagmentComponent(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
+	// Spawn away from enemies, teammates don't matter
+	bScorePlayerStarts = true;
+	ScoringSettings.EnemyInfluenceWeight = 1.0f;
+	ScoringSettings.AllyInfluenceWeight = 0.0f;
 }
 
 AActor* UTDM_PlayerSpawningManagmentComponent::OnChoosePlayerStart(AController* Player, TArray<ALyraPlayerStart*>& PlayerStarts)
@@ -24,59 +25,7 @@ AActor* UTDM_PlayerSpawningManagmentComponent::OnChoosePlayerStart(AController*
 		return nullptr;
 	}
 
-	ALyraGameState* GameState = GetGameStateChecked<ALyraGameState>();
-
-	ALyraPlayerStart* BestPlayerStart = nullptr;
-	double MaxDistance = 0;
-	ALyraPlayerStart* FallbackPlayerStart = nullptr;
-	double FallbackMaxDistance = 0;
-
-	for (APlayerState* PS : GameState->PlayerArray)
-	{
-		const int32 TeamId = TeamSubsystem->FindTeamFromObject(PS);
-		
-		// We should have a TeamId by now...
-		if (PS->IsOnlyASpectator() || !ensure(TeamId != INDEX_NONE))
-		{
-			continue;
-		}
-
-		// If the other player isn't on the same team, lets find the furthest spawn from them.
-		if (TeamId != PlayerTeamId)
-		{
-			for (ALyraPlayerStart* PlayerStart : PlayerStarts)
-			{
-				if (APawn* Pawn = PS->GetPawn())
-				{
-					const double Distance = PlayerStart->GetDistanceTo(Pawn);
-
-					if (PlayerStart->IsClaimed())
-					{
-						if (FallbackPlayerStart == nullptr || Distance > FallbackMaxDistance)
-						{
-							FallbackPlayerStart = PlayerStart;
-							FallbackMaxDistance = Distance;
-						}
-					}
-					else if (PlayerStart->GetLocationOccupancy(Player) < ELyraPlayerStartLocationOccupancy::Full)
-					{
-						if (BestPlayerStart == nullptr || Distance > MaxDistance)
-						{
-							BestPlayerStart = PlayerStart;
-							MaxDistance = Distance;
-						}
-					}
-				}
-			}
-		}
-	}
-
-	if (BestPlayerStart)
-	{
-		return BestPlayerStart;
-	}
-
-	return FallbackPlayerStart;
+	return ChooseScoredPlayerStart(Player);
 }
 
 void UTDM_PlayerSpawningManagmentComponent::OnFinishRestartPlayer(AController* Player, const FRotator& StartRotation)
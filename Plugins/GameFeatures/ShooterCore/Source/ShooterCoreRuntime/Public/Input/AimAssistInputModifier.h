@@ -71,6 +71,53 @@ struct FAimAssistOwnerViewData
 	int32 TeamID = INDEX_NONE;
 };
 
+/**
+ * Projects the screen bounds of a batch of target shapes in one pass.
+ * The shape vertices are stored relative to the view in SoA form so they can be projected four at a time,
+ * the resulting bounds match FAimAssistOwnerViewData::ProjectShapeToScreen to well within a pixel.
+ */
+struct FAimAssistShapeProjectionBatch
+{
+	/** Clears the batch and latches the view that shapes will be added for */
+	void Reset(const FAimAssistOwnerViewData& ViewData);
+
+	/** Adds a shape to the batch, returns the index of its screen bounds after Project() or INDEX_NONE if the shape type isn't supported */
+	int32 AddShape(const FCollisionShape& Shape, const FVector& ShapeOrigin, const FTransform& WorldTransform);
+
+	/** Projects every shape added since the last Reset() */
+	void Project(const FAimAssistOwnerViewData& ViewData);
+
+	const FBox2D& GetScreenBounds(int32 ShapeIndex) const { return ScreenBounds[ShapeIndex]; }
+
+	int32 Num() const { return ShapeVertexRanges.Num(); }
+
+	/** Returns the largest difference between the corners of two screen bounds, or a negative value if only one of them is valid */
+	static double GetScreenBoundsDifference(const FBox2D& BoundsA, const FBox2D& BoundsB);
+
+private:
+	void AddVertex(const FVector& WorldLocation);
+
+	FVector ViewOrigin = FVector::ZeroVector;
+	FVector ViewAxisY = FVector::ZeroVector;
+	FVector ViewAxisZ = FVector::ZeroVector;
+
+	// View relative vertex positions, padded to a multiple of four when projected
+	TArray<float> VertexX;
+	TArray<float> VertexY;
+	TArray<float> VertexZ;
+	int32 NumVertices = 0;
+
+	TArray<float> ScreenX;
+	TArray<float> ScreenY;
+
+	// One entry per group of four vertices, bit N is set if vertex N of the group is in front of the view
+	TArray<uint8> VertexGroupMasks;
+
+	// First vertex and number of vertices of each shape
+	TArray<TPair<int32, int32>> ShapeVertexRanges;
+	TArray<FBox2D> ScreenBounds;
+};
+
 /** A container for keeping the state of targets between frames that can be cached */
 USTRUCT(BlueprintType)
 struct FLyraAimAssistTarget
@@ -45,4 +45,7 @@ protected:
 	
 	/** Setup CollisionQueryParams to ignore a set of actors based on filter settings. Such as Ignoring Requester or Instigator. */
 	void InitTargetSelectionCollisionParams(FCollisionQueryParams& OutParams, const AActor& RequestedBy, const FAimAssistFilter& Filter) const;
+
+	/** Reused between updates so projecting the candidate targets doesn't reallocate */
+	FAimAssistShapeProjectionBatch ProjectionBatch;
 };
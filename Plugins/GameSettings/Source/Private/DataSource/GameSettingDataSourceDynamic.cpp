@@ -3,6 +3,17 @@
 #include "DataSource/GameSettingDataSourceDynamic.h"
 #include "Engine/LocalPlayer.h"
 
+namespace GameSettingsConsoleVars
+{
+	static bool bUseCompiledDataSources = true;
+
+	static FAutoConsoleVariableRef CVarGameSettingsUseCompiledDataSources(
+		TEXT("GameSettings.UseCompiledDataSources"),
+		bUseCompiledDataSources,
+		TEXT("Should dynamic data sources read and write bool, numeric and enum values directly, rather than walking the property path and going through text?"),
+		ECVF_Default);
+}
+
 //--------------------------------------
 // FGameSettingDataSourceDynamic
 //--------------------------------------
@@ -14,13 +25,27 @@ FGameSettingDataSourceDynamic::FGameSettingDataSourceDynamic(const TArray<FStrin
 
 bool FGameSettingDataSourceDynamic::Resolve(ULocalPlayer* InLocalPlayer)
 {
-	return DynamicPath.Resolve(InLocalPlayer);
+	const bool bResolved = DynamicPath.Resolve(InLocalPlayer);
+
+	if (bResolved)
+	{
+		CompileAccessor(InLocalPlayer);
+	}
+
+	return bResolved;
 }
 
 FString FGameSettingDataSourceDynamic::GetValueAsString(ULocalPlayer* InLocalPlayer) const
 {
 	FString OutStringValue;
 
+	// Only read the compiled value when it can be turned into a string, otherwise the value would be read twice
+	double CompiledValue;
+	if (PrepareCompiledAccessor(InLocalPlayer) && CanConvertCompiledValueToString() && ReadCompiledValue(InLocalPlayer, CompiledValue) && CompiledValueToString(CompiledValue, OutStringValue))
+	{
+		return OutStringValue;
+	}
+
 	const bool bSuccess = PropertyPathHelpers::GetPropertyValueAsString(InLocalPlayer, DynamicPath, OutStringValue);
 	ensure(bSuccess);
 
@@ -29,11 +54,374 @@ FString FGameSettingDataSourceDynamic::GetValueAsString(ULocalPlayer* InLocalPla
 
 void FGameSettingDataSourceDynamic::SetValue(ULocalPlayer* InLocalPlayer, const FString& InStringValue)
 {
+	double CompiledValue;
+	if (PrepareCompiledAccessor(InLocalPlayer) && CompiledValueFromString(InStringValue, CompiledValue) && WriteCompiledValue(InLocalPlayer, CompiledValue))
+	{
+		return;
+	}
+
 	const bool bSuccess = PropertyPathHelpers::SetPropertyValueFromString(InLocalPlayer, DynamicPath, InStringValue);
 	ensure(bSuccess);
 }
 
+bool FGameSettingDataSourceDynamic::GetValueAsDouble(ULocalPlayer* InLocalPlayer, double& OutValue) const
+{
+	return ReadCompiledValue(InLocalPlayer, OutValue);
+}
+
+bool FGameSettingDataSourceDynamic::SetValueFromDouble(ULocalPlayer* InLocalPlayer, double Value)
+{
+	return WriteCompiledValue(InLocalPlayer, Value);
+}
+
 FString FGameSettingDataSourceDynamic::ToString() const
 {
 	return DynamicPath.ToString();
 }
+
+void FGameSettingDataSourceDynamic::CompileAccessor(ULocalPlayer* InLocalPlayer) const
+{
+	bCompileAttempted = true;
+	CompiledAccessor = FCompiledAccessor();
+
+	if (!InLocalPlayer || !DynamicPath.Resolve(InLocalPlayer))
+	{
+		return;
+	}
+
+	const int32 NumSegments = DynamicPath.GetNumSegments();
+	if (NumSegments == 0)
+	{
+		return;
+	}
+
+	FCompiledAccessor NewAccessor;
+
+	for (int32 SegmentIndex = 0; SegmentIndex < NumSegments - 1; ++SegmentIndex)
+	{
+		const FPropertyPathSegment& Segment = DynamicPath.GetSegment(SegmentIndex);
+		if (Segment.GetArrayIndex() != INDEX_NONE)
+		{
+			return;
+		}
+
+		FCompiledStep Step;
+
+		const FFieldVariant Field = Segment.GetField();
+		if (UFunction* Function = Cast<UFunction>(Field.ToUObject()))
+		{
+			if (Function->NumParms != 1)
+			{
+				return;
+			}
+
+			Step.Function = Function;
+			Step.Property = CastField<FObjectPropertyBase>(Function->GetReturnProperty());
+		}
+		else
+		{
+			Step.Property = CastField<FObjectPropertyBase>(Field.ToField());
+			if (Step.Property && (Step.Property->GetOwnerClass() == nullptr))
+			{
+				return;
+			}
+		}
+
+		if (!Step.Property || Step.Property->ArrayDim != 1)
+		{
+			return;
+		}
+
+		NewAccessor.Steps.Add(Step);
+		NewAccessor.FieldOwners.AddUnique(Step.Function ? Step.Function->GetOuterUClass() : Step.Property->GetOwnerClass());
+	}
+
+	const FPropertyPathSegment& ValueSegment = DynamicPath.GetSegment(NumSegments - 1);
+	if (ValueSegment.GetArrayIndex() != INDEX_NONE)
+	{
+		return;
+	}
+
+	const FFieldVariant ValueField = ValueSegment.GetField();
+	if (UFunction* Function = Cast<UFunction>(ValueField.ToUObject()))
+	{
+		// Either a getter's return value or a setter's only parameter.
+		if (Function->NumParms != 1)
+		{
+			return;
+		}
+
+		for (TFieldIterator<FProperty> It(Function); It && It->HasAnyPropertyFlags(CPF_Parm); ++It)
+		{
+			NewAccessor.ValueProperty = *It;
+		}
+
+		NewAccessor.ValueFunction = Function;
+		NewAccessor.ValueOwnerClass = Function->GetOuterUClass();
+	}
+	else
+	{
+		NewAccessor.ValueProperty = CastField<FProperty>(ValueField.ToField());
+		NewAccessor.ValueOwnerClass = NewAccessor.ValueProperty ? NewAccessor.ValueProperty->GetOwnerClass() : nullptr;
+	}
+
+	if (!NewAccessor.ValueProperty || !NewAccessor.ValueOwnerClass || NewAccessor.ValueProperty->ArrayDim != 1)
+	{
+		return;
+	}
+
+	if (FBoolProperty* BoolProperty = CastField<FBoolProperty>(NewAccessor.ValueProperty))
+	{
+		NewAccessor.BoolProperty = BoolProperty;
+	}
+	else if (FEnumProperty* EnumProperty = CastField<FEnumProperty>(NewAccessor.ValueProperty))
+	{
+		NewAccessor.NumericProperty = EnumProperty->GetUnderlyingProperty();
+		NewAccessor.ValueEnum = EnumProperty->GetEnum();
+	}
+	else if (FNumericProperty* NumericProperty = CastField<FNumericProperty>(NewAccessor.ValueProperty))
+	{
+		NewAccessor.NumericProperty = NumericProperty;
+		NewAccessor.ValueEnum = NumericProperty->GetIntPropertyEnum();
+	}
+
+	if (!NewAccessor.BoolProperty && !NewAccessor.NumericProperty)
+	{
+		return;
+	}
+
+	NewAccessor.FieldOwners.AddUnique(NewAccessor.ValueOwnerClass);
+	if (NewAccessor.ValueEnum)
+	{
+		NewAccessor.FieldOwners.AddUnique(NewAccessor.ValueEnum);
+	}
+
+	NewAccessor.bIsValid = true;
+	CompiledAccessor = MoveTemp(NewAccessor);
+}
+
+bool FGameSettingDataSourceDynamic::PrepareCompiledAccessor(ULocalPlayer* InLocalPlayer) const
+{
+	if (!GameSettingsConsoleVars::bUseCompiledDataSources || !InLocalPlayer)
+	{
+		return false;
+	}
+
+	// The cached fields go away with their class, so recompile if it has been garbage collected or reinstanced (e.g., by hot reload)
+	bool bIsStale = false;
+	for (const TWeakObjectPtr<UObject>& FieldOwner : CompiledAccessor.FieldOwners)
+	{
+		const UObject* Owner = FieldOwner.Get();
+		const UClass* OwnerClass = Cast<UClass>(Owner);
+		if (!Owner || (OwnerClass && OwnerClass->HasAnyClassFlags(CLASS_NewerVersionExists)))
+		{
+			bIsStale = true;
+			break;
+		}
+	}
+
+	if (!bCompileAttempted || bIsStale)
+	{
+		CompileAccessor(InLocalPlayer);
+	}
+
+	return CompiledAccessor.bIsValid;
+}
+
+UObject* FGameSettingDataSourceDynamic::ResolveCompiledContainer(ULocalPlayer* InLocalPlayer) const
+{
+	if (!PrepareCompiledAccessor(InLocalPlayer))
+	{
+		return nullptr;
+	}
+
+	UObject* Container = InLocalPlayer;
+
+	for (const FCompiledStep& Step : CompiledAccessor.Steps)
+	{
+		if (Step.Function)
+		{
+			if (!Container->IsA(Step.Function->GetOuterUClass()))
+			{
+				return nullptr;
+			}
+
+			// Only object return values get here, so the parameters don't need constructing or destroying.
+			uint8* Params = (uint8*)FMemory_Alloca(Step.Function->ParmsSize);
+			FMemory::Memzero(Params, Step.Function->ParmsSize);
+
+			Container->ProcessEvent(Step.Function, Params);
+			Container = Step.Property->GetObjectPropertyValue_InContainer(Params);
+		}
+		else
+		{
+			if (!Container->IsA(Step.Property->GetOwnerClass()))
+			{
+				return nullptr;
+			}
+
+			Container = Step.Property->GetObjectPropertyValue_InContainer(Container);
+		}
+
+		if (!Container)
+		{
+			return nullptr;
+		}
+	}
+
+	return Container->IsA(CompiledAccessor.ValueOwnerClass) ? Container : nullptr;
+}
+
+bool FGameSettingDataSourceDynamic::ReadCompiledValue(ULocalPlayer* InLocalPlayer, double& OutValue) const
+{
+	UObject* Container = ResolveCompiledContainer(InLocalPlayer);
+	if (!Container)
+	{
+		return false;
+	}
+
+	const FCompiledAccessor& Accessor = CompiledAccessor;
+
+	auto ReadValue = [&Accessor](const void* ValuePtr)
+	{
+		if (Accessor.BoolProperty)
+		{
+			return Accessor.BoolProperty->GetPropertyValue(ValuePtr) ? 1.0 : 0.0;
+		}
+
+		return Accessor.NumericProperty->IsFloatingPoint()
+			? Accessor.NumericProperty->GetFloatingPointPropertyValue(ValuePtr)
+			: (double)Accessor.NumericProperty->GetSignedIntPropertyValue(ValuePtr);
+	};
+
+	if (Accessor.ValueFunction)
+	{
+		// Setters can't be read from.
+		if (Accessor.ValueFunction->GetReturnProperty() != Accessor.ValueProperty)
+		{
+			return false;
+		}
+
+		uint8* Params = (uint8*)FMemory_Alloca(Accessor.ValueFunction->ParmsSize);
+		FMemory::Memzero(Params, Accessor.ValueFunction->ParmsSize);
+
+		Container->ProcessEvent(Accessor.ValueFunction, Params);
+		OutValue = ReadValue(Accessor.ValueProperty->ContainerPtrToValuePtr<void>(Params));
+	}
+	else
+	{
+		OutValue = ReadValue(Accessor.ValueProperty->ContainerPtrToValuePtr<void>(Container));
+	}
+
+	return true;
+}
+
+bool FGameSettingDataSourceDynamic::WriteCompiledValue(ULocalPlayer* InLocalPlayer, double Value) const
+{
+	UObject* Container = ResolveCompiledContainer(InLocalPlayer);
+	if (!Container)
+	{
+		return false;
+	}
+
+	const FCompiledAccessor& Accessor = CompiledAccessor;
+
+	auto WriteValue = [&Accessor, Value](void* ValuePtr)
+	{
+		if (Accessor.BoolProperty)
+		{
+			Accessor.BoolProperty->SetPropertyValue(ValuePtr, Value != 0.0);
+		}
+		else if (Accessor.NumericProperty->IsFloatingPoint())
+		{
+			Accessor.NumericProperty->SetFloatingPointPropertyValue(ValuePtr, Value);
+		}
+		else
+		{
+			Accessor.NumericProperty->SetIntPropertyValue(ValuePtr, FMath::RoundToInt64(Value));
+		}
+	};
+
+	if (Accessor.ValueFunction)
+	{
+		// Getters can't be written to.
+		if (Accessor.ValueFunction->GetReturnProperty() != nullptr)
+		{
+			return false;
+		}
+
+		uint8* Params = (uint8*)FMemory_Alloca(Accessor.ValueFunction->ParmsSize);
+		FMemory::Memzero(Params, Accessor.ValueFunction->ParmsSize);
+
+		WriteValue(Accessor.ValueProperty->ContainerPtrToValuePtr<void>(Params));
+		Container->ProcessEvent(Accessor.ValueFunction, Params);
+	}
+	else
+	{
+		WriteValue(Accessor.ValueProperty->ContainerPtrToValuePtr<void>(Container));
+	}
+
+	return true;
+}
+
+bool FGameSettingDataSourceDynamic::CanConvertCompiledValueToString() const
+{
+	// Floating point values keep going through the property's text export so the strings match the option values exactly.
+	return CompiledAccessor.bIsValid && (CompiledAccessor.BoolProperty || CompiledAccessor.ValueEnum || CompiledAccessor.NumericProperty->IsInteger());
+}
+
+bool FGameSettingDataSourceDynamic::CompiledValueToString(double Value, FString& OutStringValue) const
+{
+	if (CompiledAccessor.BoolProperty)
+	{
+		OutStringValue = LexToString(Value != 0.0);
+		return true;
+	}
+	else if (CompiledAccessor.ValueEnum)
+	{
+		OutStringValue = CompiledAccessor.ValueEnum->GetNameStringByValue((int64)Value);
+		return true;
+	}
+	else if (CompiledAccessor.NumericProperty && CompiledAccessor.NumericProperty->IsInteger())
+	{
+		OutStringValue = LexToString((int64)Value);
+		return true;
+	}
+
+	return false;
+}
+
+bool FGameSettingDataSourceDynamic::CompiledValueFromString(const FString& InStringValue, double& OutValue) const
+{
+	if (!GameSettingsConsoleVars::bUseCompiledDataSources || !CompiledAccessor.bIsValid)
+	{
+		return false;
+	}
+
+	if (CompiledAccessor.BoolProperty)
+	{
+		OutValue = FCString::ToBool(*InStringValue) ? 1.0 : 0.0;
+		return true;
+	}
+	else if (CompiledAccessor.ValueEnum)
+	{
+		const int64 EnumValue = CompiledAccessor.ValueEnum->GetValueByNameString(InStringValue);
+		if (EnumValue == INDEX_NONE)
+		{
+			return false;
+		}
+
+		OutValue = (double)EnumValue;
+		return true;
+	}
+	else if (CompiledAccessor.NumericProperty && CompiledAccessor.NumericProperty->IsInteger() && InStringValue.IsNumeric())
+	{
+		int64 IntValue = 0;
+		LexFromString(IntValue, *InStringValue);
+
+		OutValue = (double)IntValue;
+		return true;
+	}
+
+	return false;
+}
@@ -4,6 +4,7 @@
 #include "Framework/Text/ITextDecorator.h"
 #include "Framework/Text/RichTextMarkupProcessing.h"
 #include "Templates/UnrealTemplate.h"
+#include "Misc/ScopeExit.h"
 #include "Engine/LocalPlayer.h"
 
 #define LOCTEXT_NAMESPACE "GameSetting"
@@ -26,6 +27,17 @@ namespace GameSettingsConsoleVars
 		TEXT("  Note: Shipping builds always disable this"),
 		ECVF_Default);
 #endif
+
+	static bool bBatchDependencyChanges = true;
+
+	static FAutoConsoleVariableRef CVarGameSettingsBatchDependencyChanges(
+		TEXT("GameSettings.BatchDependencyChanges"),
+		bBatchDependencyChanges,
+		TEXT("Should dependency changes raised while a setting change is being broadcast be applied once per setting at the end, rather than immediately?"),
+		ECVF_Default);
+
+	// Stop deferring if a dependency cycle keeps queueing changes
+	static const int32 MaxDeferredDependencyChanges = 4096;
 }
 
 
@@ -33,6 +45,10 @@ namespace GameSettingsConsoleVars
 // UGameSetting
 //--------------------------------------
 
+int32 UGameSetting::DependencyChangeBatchDepth = 0;
+int32 UGameSetting::DeferredDependencyChangeCursor = 0;
+TArray<UGameSetting::FDeferredDependencyChange> UGameSetting::DeferredDependencyChanges;
+
 void UGameSetting::Initialize(ULocalPlayer* InLocalPlayer)
 {
 	// If we've already gotten this local player we're already initialized.
@@ -173,6 +189,17 @@ void UGameSetting::RefreshPlainText() const
 
 void UGameSetting::NotifySettingChanged(EGameSettingChangeReason Reason)
 {
+	// Any dependency changes this triggers are applied once the outermost change has been broadcast.
+	++DependencyChangeBatchDepth;
+	ON_SCOPE_EXIT
+	{
+		if (DependencyChangeBatchDepth == 1)
+		{
+			FlushDeferredDependencyChanges();
+		}
+		--DependencyChangeBatchDepth;
+	};
+
 	OnSettingChanged(Reason);
 	
 	// Run through any edit conditions and let them know things changed.
@@ -252,21 +279,81 @@ void UGameSetting::OnEditConditionsChanged()
 
 void UGameSetting::HandleEditDependencyChanged(UGameSetting* DependencySetting)
 {
-	OnDependencyChanged();
-	RefreshEditableState();
+	if (!DeferDependencyChange(/*bNotifySettingChanged*/false))
+	{
+		ApplyDependencyChange(/*bNotifySettingChanged*/false);
+	}
 }
 
 void UGameSetting::HandleEditDependencyChanged(UGameSetting* DependencySetting, EGameSettingChangeReason Reason)
+{
+	const bool bNotifySettingChanged = (Reason != EGameSettingChangeReason::DependencyChanged);
+
+	if (!DeferDependencyChange(bNotifySettingChanged))
+	{
+		ApplyDependencyChange(bNotifySettingChanged);
+	}
+}
+
+void UGameSetting::ApplyDependencyChange(bool bNotifySettingChanged)
 {
 	OnDependencyChanged();
 	RefreshEditableState();
 
-	if (Reason != EGameSettingChangeReason::DependencyChanged)
+	if (bNotifySettingChanged)
 	{
 		NotifySettingChanged(EGameSettingChangeReason::DependencyChanged);
 	}
 }
 
+bool UGameSetting::DeferDependencyChange(bool bNotifySettingChanged)
+{
+	if (!GameSettingsConsoleVars::bBatchDependencyChanges || DependencyChangeBatchDepth == 0)
+	{
+		return false;
+	}
+
+	// Merge with a change that is already queued and hasn't been applied yet.
+	for (int32 ChangeIndex = DeferredDependencyChangeCursor; ChangeIndex < DeferredDependencyChanges.Num(); ++ChangeIndex)
+	{
+		FDeferredDependencyChange& DeferredChange = DeferredDependencyChanges[ChangeIndex];
+		if (DeferredChange.Setting == this)
+		{
+			DeferredChange.bNotifySettingChanged |= bNotifySettingChanged;
+			return true;
+		}
+	}
+
+	if (!ensureMsgf(DeferredDependencyChanges.Num() < GameSettingsConsoleVars::MaxDeferredDependencyChanges, TEXT("%s: too many deferred dependency changes, is there a dependency cycle?"), *GetDevName().ToString()))
+	{
+		return false;
+	}
+
+	FDeferredDependencyChange& DeferredChange = DeferredDependencyChanges.AddDefaulted_GetRef();
+	DeferredChange.Setting = this;
+	DeferredChange.bNotifySettingChanged = bNotifySettingChanged;
+
+	return true;
+}
+
+void UGameSetting::FlushDeferredDependencyChanges()
+{
+	// Applying a change can queue more, including for settings that were already applied,
+	// so keep going until the queue is drained.
+	while (DeferredDependencyChangeCursor < DeferredDependencyChanges.Num())
+	{
+		const FDeferredDependencyChange DeferredChange = DeferredDependencyChanges[DeferredDependencyChangeCursor++];
+
+		if (UGameSetting* Setting = DeferredChange.Setting.Get())
+		{
+			Setting->ApplyDependencyChange(DeferredChange.bNotifySettingChanged);
+		}
+	}
+
+	DeferredDependencyChanges.Reset();
+	DeferredDependencyChangeCursor = 0;
+}
+
 void UGameSetting::OnDependencyChanged()
 {
 
@@ -29,5 +29,14 @@ public:
 
 	virtual void SetValue(ULocalPlayer* InContext, const FString& Value) = 0;
 
+	/**
+	 * Numeric fast path for data sources backed by a bool, number or enum.  Returns false if the data source can't
+	 * provide it, in which case the string value should be used instead.
+	 */
+	virtual bool GetValueAsDouble(ULocalPlayer* InContext, double& OutValue) const { return false; }
+
+	/** Numeric fast path for setting the value, returns false (without changing anything) if the data source can't do it. */
+	virtual bool SetValueFromDouble(ULocalPlayer* InContext, double Value) { return false; }
+
 	virtual FString ToString() const = 0;
 };
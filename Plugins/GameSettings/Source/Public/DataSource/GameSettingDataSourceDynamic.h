@@ -22,8 +22,65 @@ public:
 
 	virtual void SetValue(ULocalPlayer* InLocalPlayer, const FString& Value) override;
 
+	virtual bool GetValueAsDouble(ULocalPlayer* InLocalPlayer, double& OutValue) const override;
+
+	virtual bool SetValueFromDouble(ULocalPlayer* InLocalPlayer, double Value) override;
+
 	virtual FString ToString() const override;
 
+private:
+	/**
+	 * Once the path resolves, paths made of object getters/properties that end in a bool, numeric or enum value are
+	 * compiled into direct calls, so reading and writing the value doesn't walk the path or go through text import/export.
+	 */
+	void CompileAccessor(ULocalPlayer* InLocalPlayer) const;
+
+	/** Compiles the accessor if it hasn't been yet or its fields are stale, returns true if it can be used. */
+	bool PrepareCompiledAccessor(ULocalPlayer* InLocalPlayer) const;
+
+	/** Follows the compiled path to the object that owns the value, or returns null if it can't be followed this time. */
+	UObject* ResolveCompiledContainer(ULocalPlayer* InLocalPlayer) const;
+
+	bool ReadCompiledValue(ULocalPlayer* InLocalPlayer, double& OutValue) const;
+	bool WriteCompiledValue(ULocalPlayer* InLocalPlayer, double Value) const;
+
+	bool CanConvertCompiledValueToString() const;
+	bool CompiledValueToString(double Value, FString& OutStringValue) const;
+	bool CompiledValueFromString(const FString& InStringValue, double& OutValue) const;
+
 private:
 	FCachedPropertyPath DynamicPath;
+
+	/** Each step to the value's owner is either a parameterless function returning an object, or an object property. */
+	struct FCompiledStep
+	{
+		UFunction* Function = nullptr;
+
+		/** The object property, or the function's return value. */
+		FObjectPropertyBase* Property = nullptr;
+	};
+
+	struct FCompiledAccessor
+	{
+		TArray<FCompiledStep> Steps;
+
+		/** The function the path ends in (a getter with only a return value, or a setter with one parameter), if any. */
+		UFunction* ValueFunction = nullptr;
+
+		/** The property holding the value, either on the owner or in the function's parameters. */
+		FProperty* ValueProperty = nullptr;
+		UClass* ValueOwnerClass = nullptr;
+
+		FBoolProperty* BoolProperty = nullptr;
+		FNumericProperty* NumericProperty = nullptr;
+		UEnum* ValueEnum = nullptr;
+
+		/** The classes (and enum) the fields above belong to, the accessor is recompiled if any of them is garbage collected or reinstanced. */
+		TArray<TWeakObjectPtr<UObject>> FieldOwners;
+
+		bool bIsValid = false;
+	};
+
+	mutable FCompiledAccessor CompiledAccessor;
+	mutable bool bCompileAttempted = false;
 };
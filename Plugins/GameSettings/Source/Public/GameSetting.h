@@ -249,4 +249,24 @@ private:
 
 	/** We cache the editable state of a setting when it changes rather than reprocessing it any time it's needed.  */
 	FGameSettingEditableState EditableStateCache;
+
+private:
+
+	/**
+	 * While a setting change is being broadcast, dependency changes are queued and applied once per setting when the
+	 * outermost change finishes, rather than every time one of a setting's dependencies reports a change.
+	 */
+	struct FDeferredDependencyChange
+	{
+		TWeakObjectPtr<UGameSetting> Setting;
+		bool bNotifySettingChanged = false;
+	};
+
+	bool DeferDependencyChange(bool bNotifySettingChanged);
+	void ApplyDependencyChange(bool bNotifySettingChanged);
+	static void FlushDeferredDependencyChanges();
+
+	static int32 DependencyChangeBatchDepth;
+	static int32 DeferredDependencyChangeCursor;
+	static TArray<FDeferredDependencyChange> DeferredDependencyChanges;
 };
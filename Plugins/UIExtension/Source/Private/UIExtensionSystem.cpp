@@ -43,19 +43,36 @@ bool FUIExtensionPoint::DoesExtensionPassContract(const FUIExtension* Extension)
 		{
 			// The data can either be the literal class of the data type, or a instance of the class type.
 			const UClass* DataClass = DataPtr->IsA(UClass::StaticClass()) ? Cast<UClass>(DataPtr) : DataPtr->GetClass();
-			for (const UClass* AllowedDataClass : AllowedDataClasses)
-			{
-				if (DataClass->IsChildOf(AllowedDataClass) || DataClass->ImplementsInterface(AllowedDataClass))
-				{
-					return true;
-				}
-			}
+			return DoesDataClassPassContract(DataClass);
 		}
 	}
 
 	return false;
 }
 
+bool FUIExtensionPoint::DoesDataClassPassContract(const UClass* DataClass) const
+{
+	const FObjectKey DataClassKey(DataClass);
+	if (const bool* CachedResult = DataClassContractCache.Find(DataClassKey))
+	{
+		return *CachedResult;
+	}
+
+	bool bPassesContract = false;
+	for (const UClass* AllowedDataClass : AllowedDataClasses)
+	{
+		if (DataClass->IsChildOf(AllowedDataClass) || DataClass->ImplementsInterface(AllowedDataClass))
+		{
+			bPassesContract = true;
+			break;
+		}
+	}
+
+	DataClassContractCache.Add(DataClassKey, bPassesContract);
+
+	return bPassesContract;
+}
+
 //=========================================================
 
 void UUIExtensionSubsystem::AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector)
@@ -77,6 +94,12 @@ void UUIExtensionSubsystem::AddReferencedObjects(UObject* InThis, FReferenceColl
 				Collector.AddReferencedObject(ValueElement->Data);
 			}
 		}
+
+		// Extensions waiting on a batch aren't in the map yet
+		for (const TSharedPtr<FUIExtension>& PendingExtension : ExtensionSubsystem->PendingAddedExtensions)
+		{
+			Collector.AddReferencedObject(PendingExtension->Data);
+		}
 	}
 }
 
@@ -155,9 +178,7 @@ FUIExtensionHandle UUIExtensionSubsystem::RegisterExtensionAsData(const FGamepla
 		return FUIExtensionHandle();
 	}
 
-	FExtensionList& List = ExtensionMap.FindOrAdd(ExtensionPointTag);
-
-	TSharedPtr<FUIExtension>& Entry = List.Add_GetRef(MakeShared<FUIExtension>());
+	TSharedPtr<FUIExtension> Entry = MakeShared<FUIExtension>();
 	Entry->ExtensionPointTag = ExtensionPointTag;
 	Entry->ContextObject = ContextObject;
 	Entry->Data = Data;
@@ -172,16 +193,71 @@ FUIExtensionHandle UUIExtensionSubsystem::RegisterExtensionAsData(const FGamepla
 		UE_LOG(LogUIExtension, Verbose, TEXT("Extension [%s] for [%s] @ [%s] Registered"), *GetNameSafe(Data), *GetNameSafe(ContextObject), *ExtensionPointTag.ToString());
 	}
 
-	NotifyExtensionPointsOfExtension(EUIExtensionAction::Added, Entry);
+	if (ExtensionBatchDepth > 0)
+	{
+		PendingAddedExtensions.Add(Entry);
+	}
+	else
+	{
+		AddExtensionToMap(Entry);
+		NotifyExtensionPointsOfExtension(EUIExtensionAction::Added, Entry);
+	}
 
 	return FUIExtensionHandle(this, Entry);
 }
 
+const TArray<FGameplayTag>& UUIExtensionSubsystem::GetTagAncestry(const FGameplayTag& Tag)
+{
+	if (const TArray<FGameplayTag>* ExistingAncestry = TagAncestryMap.Find(Tag))
+	{
+		return *ExistingAncestry;
+	}
+
+	TArray<FGameplayTag> Ancestry;
+	for (FGameplayTag ParentTag = Tag; ParentTag.IsValid(); ParentTag = ParentTag.RequestDirectParent())
+	{
+		Ancestry.Add(ParentTag);
+	}
+
+	return TagAncestryMap.Add(Tag, MoveTemp(Ancestry));
+}
+
+void UUIExtensionSubsystem::AddExtensionToMap(const TSharedPtr<FUIExtension>& Extension)
+{
+	ExtensionMap.FindOrAdd(Extension->ExtensionPointTag).Add(Extension);
+}
+
+bool UUIExtensionSubsystem::RemoveExtensionFromMap(const TSharedPtr<FUIExtension>& Extension)
+{
+	if (FExtensionList* ListPtr = ExtensionMap.Find(Extension->ExtensionPointTag))
+	{
+		const bool bRemoved = ListPtr->RemoveSwap(Extension) > 0;
+
+		if (ListPtr->Num() == 0)
+		{
+			ExtensionMap.Remove(Extension->ExtensionPointTag);
+		}
+
+		return bRemoved;
+	}
+
+	return false;
+}
+
+bool UUIExtensionSubsystem::IsExtensionInMap(const TSharedPtr<FUIExtension>& Extension) const
+{
+	const FExtensionList* ListPtr = ExtensionMap.Find(Extension->ExtensionPointTag);
+	return ListPtr && ListPtr->Contains(Extension);
+}
+
 void UUIExtensionSubsystem::NotifyExtensionPointOfExtensions(TSharedPtr<FUIExtensionPoint>& ExtensionPoint)
 {
-	for (FGameplayTag Tag = ExtensionPoint->ExtensionPointTag; Tag.IsValid(); Tag = Tag.RequestDirectParent())
+	const TArray<FGameplayTag>& Ancestry = GetTagAncestry(ExtensionPoint->ExtensionPointTag);
+	const int32 NumTagsToCheck = (ExtensionPoint->ExtensionPointTagMatchType == EUIExtensionPointMatch::ExactMatch) ? FMath::Min(1, Ancestry.Num()) : Ancestry.Num();
+
+	for (int32 TagIndex = 0; TagIndex < NumTagsToCheck; ++TagIndex)
 	{
-		if (const FExtensionList* ListPtr = ExtensionMap.Find(Tag))
+		if (const FExtensionList* ListPtr = ExtensionMap.Find(Ancestry[TagIndex]))
 		{
 			// Copy in case there are removals while handling callbacks
 			FExtensionList ExtensionArray(*ListPtr);
@@ -195,38 +271,135 @@ void UUIExtensionSubsystem::NotifyExtensionPointOfExtensions(TSharedPtr<FUIExten
 				}
 			}
 		}
+	}
+}
 
-		if (ExtensionPoint->ExtensionPointTagMatchType == EUIExtensionPointMatch::ExactMatch)
+void UUIExtensionSubsystem::GatherExtensionPointsForExtension(const TSharedPtr<FUIExtension>& Extension, TArray<TSharedPtr<FUIExtensionPoint>>& OutExtensionPoints)
+{
+	const TArray<FGameplayTag>& Ancestry = GetTagAncestry(Extension->ExtensionPointTag);
+	for (int32 TagIndex = 0; TagIndex < Ancestry.Num(); ++TagIndex)
+	{
+		if (const FExtensionPointList* ListPtr = ExtensionPointMap.Find(Ancestry[TagIndex]))
 		{
-			break;
+			const bool bOnInitialTag = (TagIndex == 0);
+
+			for (const TSharedPtr<FUIExtensionPoint>& ExtensionPoint : *ListPtr)
+			{
+				if (bOnInitialTag || (ExtensionPoint->ExtensionPointTagMatchType == EUIExtensionPointMatch::PartialMatch))
+				{
+					if (ExtensionPoint->DoesExtensionPassContract(Extension.Get()))
+					{
+						OutExtensionPoints.Add(ExtensionPoint);
+					}
+				}
+			}
 		}
 	}
 }
 
 void UUIExtensionSubsystem::NotifyExtensionPointsOfExtension(EUIExtensionAction Action, TSharedPtr<FUIExtension>& Extension)
 {
-	bool bOnInitialTag = true;
-	for (FGameplayTag Tag = Extension->ExtensionPointTag; Tag.IsValid(); Tag = Tag.RequestDirectParent())
+	// Gathered up front in case there are removals while handling callbacks
+	TArray<TSharedPtr<FUIExtensionPoint>> ExtensionPointArray;
+	GatherExtensionPointsForExtension(Extension, ExtensionPointArray);
+
+	for (const TSharedPtr<FUIExtensionPoint>& ExtensionPoint : ExtensionPointArray)
+	{
+		FUIExtensionRequest Request = CreateExtensionRequest(Extension);
+		ExtensionPoint->Callback.ExecuteIfBound(Action, Request);
+	}
+}
+
+void UUIExtensionSubsystem::BeginExtensionBatch()
+{
+	++ExtensionBatchDepth;
+}
+
+void UUIExtensionSubsystem::EndExtensionBatch()
+{
+	if (!ensureMsgf(ExtensionBatchDepth > 0, TEXT("EndExtensionBatch called without a matching BeginExtensionBatch.")))
+	{
+		return;
+	}
+
+	if (--ExtensionBatchDepth == 0)
+	{
+		FlushExtensionBatch();
+	}
+}
+
+void UUIExtensionSubsystem::UnregisterExtensions(TConstArrayView<FUIExtensionHandle> ExtensionHandles)
+{
+	FUIExtensionBatchScope BatchScope(this);
+
+	for (const FUIExtensionHandle& ExtensionHandle : ExtensionHandles)
+	{
+		UnregisterExtension(ExtensionHandle);
+	}
+}
+
+void UUIExtensionSubsystem::FlushExtensionBatch()
+{
+	const FExtensionList RemovedExtensions = MoveTemp(PendingRemovedExtensions);
+	const FExtensionList AddedExtensions = MoveTemp(PendingAddedExtensions);
+	PendingRemovedExtensions.Reset();
+	PendingAddedExtensions.Reset();
+
+	// Apply every change before notifying anyone, so callbacks see the final state of the batch
+	for (const TSharedPtr<FUIExtension>& Extension : RemovedExtensions)
+	{
+		RemoveExtensionFromMap(Extension);
+	}
+
+	for (const TSharedPtr<FUIExtension>& Extension : AddedExtensions)
 	{
-		if (const FExtensionPointList* ListPtr = ExtensionPointMap.Find(Tag))
+		AddExtensionToMap(Extension);
+	}
+
+	// Group the changes by extension point, keeping the order the points were first affected in
+	struct FExtensionPointChanges
+	{
+		TSharedPtr<FUIExtensionPoint> ExtensionPoint;
+		TArray<TPair<EUIExtensionAction, TSharedPtr<FUIExtension>>> Changes;
+	};
+
+	TArray<FExtensionPointChanges> ChangesByExtensionPoint;
+	TMap<const FUIExtensionPoint*, int32> ExtensionPointToChangesIndex;
+	TArray<TSharedPtr<FUIExtensionPoint>> ExtensionPointArray;
+
+	auto GatherChanges = [&](EUIExtensionAction Action, const FExtensionList& Extensions)
+	{
+		for (const TSharedPtr<FUIExtension>& Extension : Extensions)
 		{
-			// Copy in case there are removals while handling callbacks
-			FExtensionPointList ExtensionPointArray(*ListPtr);
+			ExtensionPointArray.Reset();
+			GatherExtensionPointsForExtension(Extension, ExtensionPointArray);
 
 			for (const TSharedPtr<FUIExtensionPoint>& ExtensionPoint : ExtensionPointArray)
 			{
-				if (bOnInitialTag || (ExtensionPoint->ExtensionPointTagMatchType == EUIExtensionPointMatch::PartialMatch))
+				int32& ChangesIndex = ExtensionPointToChangesIndex.FindOrAdd(ExtensionPoint.Get(), INDEX_NONE);
+				if (ChangesIndex == INDEX_NONE)
 				{
-					if (ExtensionPoint->DoesExtensionPassContract(Extension.Get()))
-					{
-						FUIExtensionRequest Request = CreateExtensionRequest(Extension);
-						ExtensionPoint->Callback.ExecuteIfBound(Action, Request);
-					}
+					ChangesIndex = ChangesByExtensionPoint.AddDefaulted();
+					ChangesByExtensionPoint[ChangesIndex].ExtensionPoint = ExtensionPoint;
 				}
+
+				ChangesByExtensionPoint[ChangesIndex].Changes.Emplace(Action, Extension);
 			}
 		}
-		
-		bOnInitialTag = false;
+	};
+
+	GatherChanges(EUIExtensionAction::Removed, RemovedExtensions);
+	GatherChanges(EUIExtensionAction::Added, AddedExtensions);
+
+	UE_LOG(LogUIExtension, Verbose, TEXT("Extension batch applied: %d removed, %d added, %d extension points notified"), RemovedExtensions.Num(), AddedExtensions.Num(), ChangesByExtensionPoint.Num());
+
+	for (const FExtensionPointChanges& PointChanges : ChangesByExtensionPoint)
+	{
+		for (const TPair<EUIExtensionAction, TSharedPtr<FUIExtension>>& Change : PointChanges.Changes)
+		{
+			FUIExtensionRequest Request = CreateExtensionRequest(Change.Value);
+			PointChanges.ExtensionPoint->Callback.ExecuteIfBound(Change.Key, Request);
+		}
 	}
 }
 
@@ -237,7 +410,23 @@ void UUIExtensionSubsystem::UnregisterExtension(const FUIExtensionHandle& Extens
 		checkf(ExtensionHandle.ExtensionSource == this, TEXT("Trying to unregister an extension that's not from this extension subsystem."));
 
 		TSharedPtr<FUIExtension> Extension = ExtensionHandle.DataPtr;
-		if (FExtensionList* ListPtr = ExtensionMap.Find(Extension->ExtensionPointTag))
+
+		if (ExtensionBatchDepth > 0)
+		{
+			// Registered and unregistered within the same batch, nobody ever needs to hear about it
+			if (PendingAddedExtensions.Remove(Extension) > 0)
+			{
+				return;
+			}
+
+			if (IsExtensionInMap(Extension))
+			{
+				PendingRemovedExtensions.AddUnique(Extension);
+			}
+			return;
+		}
+
+		if (IsExtensionInMap(Extension))
 		{
 			if (Extension->ContextObject.IsExplicitlyNull())
 			{
@@ -250,12 +439,7 @@ void UUIExtensionSubsystem::UnregisterExtension(const FUIExtensionHandle& Extens
 
 			NotifyExtensionPointsOfExtension(EUIExtensionAction::Removed, Extension);
 
-			ListPtr->RemoveSwap(Extension);
-			
-			if (ListPtr->Num() == 0)
-			{
-				ExtensionMap.Remove(Extension->ExtensionPointTag);
-			}
+			RemoveExtensionFromMap(Extension);
 		}
 	}
 	else
@@ -345,6 +529,25 @@ FUIExtensionHandle UUIExtensionSubsystem::K2_RegisterExtensionAsDataForContext(F
 
 //=========================================================
 
+FUIExtensionBatchScope::FUIExtensionBatchScope(UUIExtensionSubsystem* InExtensionSubsystem)
+	: ExtensionSubsystem(InExtensionSubsystem)
+{
+	if (InExtensionSubsystem)
+	{
+		InExtensionSubsystem->BeginExtensionBatch();
+	}
+}
+
+FUIExtensionBatchScope::~FUIExtensionBatchScope()
+{
+	if (UUIExtensionSubsystem* ExtensionSubsystemPtr = ExtensionSubsystem.Get())
+	{
+		ExtensionSubsystemPtr->EndExtensionBatch();
+	}
+}
+
+//=========================================================
+
 void UUIExtensionHandleFunctions::Unregister(FUIExtensionHandle& Handle)
 {
 	Handle.Unregister();
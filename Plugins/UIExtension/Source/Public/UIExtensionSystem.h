@@ -6,6 +6,7 @@
 #include "UObject/StrongObjectPtr.h"
 #include "UObject/WeakInterfacePtr.h"
 #include "UObject/Interface.h"
+#include "UObject/ObjectKey.h"
 #include "GameplayTagContainer.h"
 #include "Templates/SubclassOf.h"
 #include "Subsystems/LocalPlayerSubsystem.h"
@@ -61,6 +62,12 @@ public:
 	// Tests if the extension and the extension point match up, if they do then this extension point should learn
 	// about this extension.
 	bool DoesExtensionPassContract(const FUIExtension* Extension) const;
+
+private:
+	bool DoesDataClassPassContract(const UClass* DataClass) const;
+
+	// The allowed data classes never change after registration, so the class checks are cached per data class.
+	mutable TMap<FObjectKey, bool> DataClassContractCache;
 };
 
 /**
@@ -212,6 +219,17 @@ public:
 	UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = "UI Extension")
 	void UnregisterExtensionPoint(const FUIExtensionPointHandle& ExtensionPointHandle);
 
+	/**
+	 * Defers registering and unregistering extensions until the matching EndExtensionBatch, where every affected extension
+	 * point is notified of all of its removals and then all of its additions together. Extensions that are registered and
+	 * unregistered within the same batch are never broadcast. Batches can be nested, see also FUIExtensionBatchScope.
+	 */
+	void BeginExtensionBatch();
+	void EndExtensionBatch();
+
+	/** Unregisters a set of extensions as a single batch */
+	void UnregisterExtensions(TConstArrayView<FUIExtensionHandle> ExtensionHandles);
+
 	static void AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector);
 
 protected:
@@ -248,12 +266,43 @@ protected:
 
 	FUIExtensionRequest CreateExtensionRequest(const TSharedPtr<FUIExtension>& Extension);
 
+private:
+	// Returns the tag followed by each of its parents up to the root
+	const TArray<FGameplayTag>& GetTagAncestry(const FGameplayTag& Tag);
+
+	void GatherExtensionPointsForExtension(const TSharedPtr<FUIExtension>& Extension, TArray<TSharedPtr<FUIExtensionPoint>>& OutExtensionPoints);
+
+	void AddExtensionToMap(const TSharedPtr<FUIExtension>& Extension);
+	bool RemoveExtensionFromMap(const TSharedPtr<FUIExtension>& Extension);
+	bool IsExtensionInMap(const TSharedPtr<FUIExtension>& Extension) const;
+
+	void FlushExtensionBatch();
+
 private:
 	typedef TArray<TSharedPtr<FUIExtensionPoint>> FExtensionPointList;
 	TMap<FGameplayTag, FExtensionPointList> ExtensionPointMap;
 
 	typedef TArray<TSharedPtr<FUIExtension>> FExtensionList;
 	TMap<FGameplayTag, FExtensionList> ExtensionMap;
+
+	// Tag hierarchies don't change at runtime, so the parent chain of each tag we've seen is only built once
+	TMap<FGameplayTag, TArray<FGameplayTag>> TagAncestryMap;
+
+	// Changes waiting for the outermost EndExtensionBatch
+	int32 ExtensionBatchDepth = 0;
+	FExtensionList PendingAddedExtensions;
+	FExtensionList PendingRemovedExtensions;
+};
+
+/** Batches the extension changes made during its lifetime, see UUIExtensionSubsystem::BeginExtensionBatch */
+struct UIEXTENSION_API FUIExtensionBatchScope
+{
+public:
+	FUIExtensionBatchScope(UUIExtensionSubsystem* InExtensionSubsystem);
+	~FUIExtensionBatchScope();
+
+private:
+	TWeakObjectPtr<UUIExtensionSubsystem> ExtensionSubsystem;
 };
 
 
@@ -0,0 +1,92 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CheckChaosMeshCollisionCommandlet.h"
+#include "AssetData.h"
+#include "AssetRegistryModule.h"
+#include "ARFilter.h"
+#include "Engine/StaticMesh.h"
+#include "PhysicsEngine/BodySetup.h"
+
+#include "Utilities/CheckChaosMeshCollision.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogLyraCheckChaosMeshCollision, Log, Log);
+
+UCheckChaosMeshCollisionCommandlet::UCheckChaosMeshCollisionCommandlet(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+}
+
+int32 UCheckChaosMeshCollisionCommandlet::Main(const FString& FullCommandLine)
+{
+	UE_LOG(LogLyraCheckChaosMeshCollision, Display, TEXT("Running CheckChaosMeshCollision commandlet..."));
+
+	TArray<FString> Tokens;
+	TArray<FString> Switches;
+	TMap<FString, FString> Params;
+	ParseCommandLine(*FullCommandLine, Tokens, Switches, Params);
+
+	FString ContentPath = TEXT("/Game");
+	if (const FString* PathString = Params.Find(TEXT("Path")))
+	{
+		ContentPath = *PathString;
+	}
+
+	int32 BatchSize = 200;
+	if (const FString* BatchSizeString = Params.Find(TEXT("BatchSize")))
+	{
+		BatchSize = FMath::Max(1, FCString::Atoi(**BatchSizeString));
+	}
+
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+	AssetRegistry.SearchAllAssets(true);
+
+	FARFilter Filter;
+	Filter.PackagePaths.Add(FName(*ContentPath));
+	Filter.bRecursivePaths = true;
+	Filter.ClassNames.Add(UStaticMesh::StaticClass()->GetFName());
+	Filter.bRecursiveClasses = true;
+
+	TArray<FAssetData> MeshAssets;
+	AssetRegistry.GetAssets(Filter, MeshAssets);
+
+	UE_LOG(LogLyraCheckChaosMeshCollision, Display, TEXT("Found %d static meshes under %s"), MeshAssets.Num(), *ContentPath);
+
+	// Load and check the meshes a batch at a time so memory stays bounded
+	LyraEditorUtilities::FChaosMeshCollisionReport TotalReport;
+	for (int32 BatchStart = 0; BatchStart < MeshAssets.Num(); BatchStart += BatchSize)
+	{
+		const int32 BatchEnd = FMath::Min(BatchStart + BatchSize, MeshAssets.Num());
+
+		TArray<UStaticMesh*> Meshes;
+		for (int32 AssetIndex = BatchStart; AssetIndex < BatchEnd; ++AssetIndex)
+		{
+			if (UStaticMesh* MeshAsset = Cast<UStaticMesh>(MeshAssets[AssetIndex].GetAsset()))
+			{
+				// Make sure the collision data has been built, the commandlet doesn't create physics state that would otherwise do it
+				UBodySetup* BodySetup = MeshAsset->GetBodySetup();
+				if (BodySetup && !BodySetup->bCreatedPhysicsMeshes)
+				{
+					BodySetup->CreatePhysicsMeshes();
+				}
+
+				Meshes.Add(MeshAsset);
+			}
+		}
+
+		const LyraEditorUtilities::FChaosMeshCollisionReport BatchReport = LyraEditorUtilities::CheckChaosMeshCollision(Meshes);
+		TotalReport.NumMeshes += BatchReport.NumMeshes;
+		TotalReport.NumTriMeshes += BatchReport.NumTriMeshes;
+		TotalReport.NumTriangles += BatchReport.NumTriangles;
+		TotalReport.ElapsedSeconds += BatchReport.ElapsedSeconds;
+		TotalReport.ProblemMeshes.Append(BatchReport.ProblemMeshes);
+
+		UE_LOG(LogLyraCheckChaosMeshCollision, Display, TEXT("Checked %d / %d meshes, %d with problems so far"), BatchEnd, MeshAssets.Num(), TotalReport.ProblemMeshes.Num());
+
+		Meshes.Reset();
+		CollectGarbage(RF_NoFlags);
+	}
+
+	LyraEditorUtilities::LogChaosMeshCollisionReport(TotalReport, *GLog);
+
+	return (TotalReport.ProblemMeshes.Num() > 0) ? 1 : 0;
+}
@@ -0,0 +1,25 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectMacros.h"
+#include "Commandlets/Commandlet.h"
+#include "CheckChaosMeshCollisionCommandlet.generated.h"
+
+/**
+ * Checks the Chaos collision data of every static mesh under a content path for degenerate triangles.
+ *
+ * Usage: -run=CheckChaosMeshCollision [-Path=/Game] [-BatchSize=200]
+ * Returns 1 if any mesh has degenerate collision triangles.
+ */
+UCLASS()
+class UCheckChaosMeshCollisionCommandlet : public UCommandlet
+{
+	GENERATED_UCLASS_BODY()
+
+public:
+	// Begin UCommandlet Interface
+	virtual int32 Main(const FString& Params) override;
+	// End UCommandlet Interface
+};
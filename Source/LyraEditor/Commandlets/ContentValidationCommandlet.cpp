@@ -172,6 +172,15 @@ int32 UContentValidationCommandlet::Main(const FString& FullCommandLine)
 		MaxPackagesToLoad = FCString::Atoi(**InMaxPackagesToLoadString);
 	}
 
+	// Validate everything from scratch rather than skipping packages that passed before
+	if (Switches.Contains(TEXT("NoValidationCache")))
+	{
+		if (IConsoleVariable* UseResultCacheCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("EditorValidator.UseResultCache")))
+		{
+			UseResultCacheCVar->Set(false);
+		}
+	}
+
 	TArray<FString> AllWarningsAndErrors;
 	UEditorValidator::ValidatePackages(ChangedPackageNames, DeletedPackageNames, MaxPackagesToLoad, AllWarningsAndErrors, EDataValidationUsecase::Commandlet);
 
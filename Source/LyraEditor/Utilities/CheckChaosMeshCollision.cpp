@@ -1,75 +1,209 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
+#include "Utilities/CheckChaosMeshCollision.h"
 #include "LyraEditor.h"
 
 #include "AssetRegistryModule.h"
 #include "HAL/IConsoleManager.h"
+#include "Async/ParallelFor.h"
+#include "Math/VectorRegister.h"
 
 #include "Engine/StaticMesh.h"
 #include "Chaos/TriangleMeshImplicitObject.h"
 #include "PhysicsEngine/BodySetup.h"
 
+#include <atomic>
+
 namespace LyraEditorUtilities
 {
 
 //////////////////////////////////////////////////////////////////////////
 
-// returns true if the mesh has one or more degenerate triangles
-bool CheckMeshDataForProblem(const Chaos::FTriangleMeshImplicitObject::ParticlesType& Particles, const Chaos::FTrimeshIndexBuffer& Elements)
+static int32 GCheckChaosMeshTrianglesPerTask = 16384;
+static FAutoConsoleVariableRef CVarCheckChaosMeshTrianglesPerTask(
+	TEXT("Lyra.CheckChaosMeshCollision.TrianglesPerTask"),
+	GCheckChaosMeshTrianglesPerTask,
+	TEXT("How many collision triangles each worker task checks at a time in Lyra.CheckChaosMeshCollision"),
+	ECVF_Default);
+
+using FTriMeshPtr = TSharedPtr<Chaos::FTriangleMeshImplicitObject, ESPMode::ThreadSafe>;
+
+// returns true if the triangle is degenerate, this is the exact test, the vectorized one below only finds candidates for it
+static bool IsTriangleDegenerate(const Chaos::FTriangleMeshImplicitObject::ParticleVecType& A, const Chaos::FTriangleMeshImplicitObject::ParticleVecType& B, const Chaos::FTriangleMeshImplicitObject::ParticleVecType& C)
+{
+	using VecType = Chaos::FTriangleMeshImplicitObject::ParticleVecType;
+
+	const VecType AB = B - A;
+	const VecType AC = C - A;
+	VecType Normal = VecType::CrossProduct(AB, AC);
+
+	return Normal.SafeNormalize() < SMALL_NUMBER;
+}
+
+// returns the number of degenerate triangles in [FirstTriangle, LastTriangle)
+static int64 CountDegenerateTriangles(const Chaos::FTriangleMeshImplicitObject::ParticlesType& Particles, const Chaos::FTrimeshIndexBuffer& Elements, int32 FirstTriangle, int32 LastTriangle)
 {
+	// Anything whose squared normal length is under this (plus some slack for rounding on large triangles) gets the exact test
+	static const float CandidateThreshold = 1e-2f;
+	static const float CandidateRelativeThreshold = 1e-10f;
+
 	// Internal helper because the index buffer type is templated
-	auto CheckTris = [&](const auto& Elements, int32 NumTriangles)
+	auto CountTris = [&](const auto& Indices)
 	{
-		using VecType = Chaos::FTriangleMeshImplicitObject::ParticleVecType;
+		const VectorRegister4Float Threshold = VectorSetFloat1(CandidateThreshold);
+		const VectorRegister4Float RelativeThreshold = VectorSetFloat1(CandidateRelativeThreshold);
 
-		for (int32 FaceIdx = 0; FaceIdx < NumTriangles; ++FaceIdx)
+		int64 NumDegenerate = 0;
+		for (int32 FaceIdx = FirstTriangle; FaceIdx < LastTriangle; ++FaceIdx)
 		{
-			const VecType& A = Particles.X(Elements[FaceIdx][0]);
-			const VecType& B = Particles.X(Elements[FaceIdx][1]);
-			const VecType& C = Particles.X(Elements[FaceIdx][2]);
+			const auto& A = Particles.X(Indices[FaceIdx][0]);
+			const auto& B = Particles.X(Indices[FaceIdx][1]);
+			const auto& C = Particles.X(Indices[FaceIdx][2]);
+
+			const VectorRegister4Float VecA = MakeVectorRegisterFloat((float)A[0], (float)A[1], (float)A[2], 0.0f);
+			const VectorRegister4Float VecAB = VectorSubtract(MakeVectorRegisterFloat((float)B[0], (float)B[1], (float)B[2], 0.0f), VecA);
+			const VectorRegister4Float VecAC = VectorSubtract(MakeVectorRegisterFloat((float)C[0], (float)C[1], (float)C[2], 0.0f), VecA);
 
-			const VecType AB = B - A;
-			const VecType AC = C - A;
-			VecType Normal = VecType::CrossProduct(AB, AC);
+			const VectorRegister4Float Normal = VectorCross(VecAB, VecAC);
+			const VectorRegister4Float NormalSizeSquared = VectorDot3(Normal, Normal);
+			const VectorRegister4Float EdgeSizeProduct = VectorMultiply(VectorDot3(VecAB, VecAB), VectorDot3(VecAC, VecAC));
+			const VectorRegister4Float CandidateLimit = VectorMultiplyAdd(EdgeSizeProduct, RelativeThreshold, Threshold);
 
-			if (Normal.SafeNormalize() < SMALL_NUMBER)
+			if (VectorMaskBits(VectorCompareLT(NormalSizeSquared, CandidateLimit)) != 0)
 			{
-				return true;
+				if (IsTriangleDegenerate(A, B, C))
+				{
+					++NumDegenerate;
+				}
 			}
 		}
 
-		return false;
+		return NumDegenerate;
 	};
 
-	const int32 NumTriangles = Elements.GetNumTriangles();
 	if (Elements.RequiresLargeIndices())
 	{
-		return CheckTris(Elements.GetLargeIndexBuffer(), NumTriangles);
+		return CountTris(Elements.GetLargeIndexBuffer());
 	}
 	else
 	{
-		return CheckTris(Elements.GetSmallIndexBuffer(), NumTriangles);
+		return CountTris(Elements.GetSmallIndexBuffer());
 	}
 }
 
-void CheckChaosMeshCollision(FOutputDevice& Ar)
+FChaosMeshCollisionReport CheckChaosMeshCollision(TConstArrayView<UStaticMesh*> Meshes)
 {
-	for (UStaticMesh* MeshAsset : TObjectRange<UStaticMesh>())
+	const double StartTime = FPlatformTime::Seconds();
+
+	FChaosMeshCollisionReport Report;
+
+	// Gather the collision data on the game thread, holding a reference so it stays alive while the workers read it
+	struct FScanTask
 	{
-		if (UBodySetup* BodySetup = MeshAsset->GetBodySetup())
+		int32 TriMeshIndex = 0;
+		int32 FirstTriangle = 0;
+		int32 LastTriangle = 0;
+	};
+
+	TArray<FTriMeshPtr> TriMeshes;
+	TArray<int32> TriMeshToMeshIndex;
+	TArray<FScanTask> Tasks;
+
+	const int32 TrianglesPerTask = FMath::Max(1, GCheckChaosMeshTrianglesPerTask);
+
+	for (int32 MeshIndex = 0; MeshIndex < Meshes.Num(); ++MeshIndex)
+	{
+		UStaticMesh* MeshAsset = Meshes[MeshIndex];
+		UBodySetup* BodySetup = MeshAsset ? MeshAsset->GetBodySetup() : nullptr;
+		if (!BodySetup)
+		{
+			continue;
+		}
+
+		Report.NumMeshes++;
+
+		for (const FTriMeshPtr& TriMesh : BodySetup->ChaosTriMeshes)
 		{
-			for (const TSharedPtr<Chaos::FTriangleMeshImplicitObject, ESPMode::ThreadSafe>& TriMesh : BodySetup->ChaosTriMeshes)
+			if (TriMesh.IsValid())
 			{
-				if (Chaos::FTriangleMeshImplicitObject* TriMeshData = TriMesh.Get())
+				const int32 TriMeshIndex = TriMeshes.Add(TriMesh);
+				TriMeshToMeshIndex.Add(MeshIndex);
+
+				const int32 NumTriangles = TriMesh->Elements().GetNumTriangles();
+				Report.NumTriangles += NumTriangles;
+
+				for (int32 FirstTriangle = 0; FirstTriangle < NumTriangles; FirstTriangle += TrianglesPerTask)
 				{
-					if (CheckMeshDataForProblem(TriMeshData->Particles(), TriMeshData->Elements()))
-					{
-						UE_LOG(LogConsoleResponse, Warning, TEXT("Mesh asset %s has one or more degenerate triangles in collision data"), *GetPathNameSafe(MeshAsset));
-					}
+					Tasks.Add({ TriMeshIndex, FirstTriangle, FMath::Min(FirstTriangle + TrianglesPerTask, NumTriangles) });
 				}
 			}
 		}
 	}
+
+	Report.NumTriMeshes = TriMeshes.Num();
+
+	UE_LOG(LogLyraEditor, Display, TEXT("Checking %lld collision triangles in %d meshes (%d tasks)..."), Report.NumTriangles, Report.NumMeshes, Tasks.Num());
+
+	// Scan the triangles in parallel, reporting progress every 10%
+	TArray<std::atomic<int64>> DegenerateCounts;
+	DegenerateCounts.SetNum(Meshes.Num());
+	for (std::atomic<int64>& Count : DegenerateCounts)
+	{
+		Count = 0;
+	}
+
+	std::atomic<int64> NumTrianglesScanned(0);
+	std::atomic<int32> LastReportedPercent(0);
+	const int64 NumTrianglesToScan = FMath::Max<int64>(Report.NumTriangles, 1);
+
+	ParallelFor(Tasks.Num(), [&](int32 TaskIndex)
+	{
+		const FScanTask& Task = Tasks[TaskIndex];
+		const Chaos::FTriangleMeshImplicitObject* TriMeshData = TriMeshes[Task.TriMeshIndex].Get();
+
+		const int64 NumDegenerate = CountDegenerateTriangles(TriMeshData->Particles(), TriMeshData->Elements(), Task.FirstTriangle, Task.LastTriangle);
+		if (NumDegenerate > 0)
+		{
+			DegenerateCounts[TriMeshToMeshIndex[Task.TriMeshIndex]] += NumDegenerate;
+		}
+
+		const int64 NumScanned = (NumTrianglesScanned += (Task.LastTriangle - Task.FirstTriangle));
+		const int32 Percent = (int32)((NumScanned * 100) / NumTrianglesToScan);
+
+		int32 ReportedPercent = LastReportedPercent.load();
+		while ((Percent >= ReportedPercent + 10) && !LastReportedPercent.compare_exchange_weak(ReportedPercent, Percent))
+		{
+		}
+
+		if (Percent >= ReportedPercent + 10)
+		{
+			UE_LOG(LogLyraEditor, Display, TEXT("  ... %d%% (%lld / %lld triangles)"), Percent, NumScanned, Report.NumTriangles);
+		}
+	});
+
+	for (int32 MeshIndex = 0; MeshIndex < Meshes.Num(); ++MeshIndex)
+	{
+		const int64 NumDegenerate = DegenerateCounts[MeshIndex];
+		if (NumDegenerate > 0)
+		{
+			Report.ProblemMeshes.Emplace(GetPathNameSafe(Meshes[MeshIndex]), NumDegenerate);
+		}
+	}
+
+	Report.ElapsedSeconds = FPlatformTime::Seconds() - StartTime;
+
+	return Report;
+}
+
+void LogChaosMeshCollisionReport(const FChaosMeshCollisionReport& Report, FOutputDevice& Ar)
+{
+	for (const TPair<FString, int64>& ProblemMesh : Report.ProblemMeshes)
+	{
+		Ar.Logf(ELogVerbosity::Warning, TEXT("Mesh asset %s has %lld degenerate triangles in collision data"), *ProblemMesh.Key, ProblemMesh.Value);
+	}
+
+	Ar.Logf(ELogVerbosity::Display, TEXT("Checked %lld collision triangles (%d trimeshes) in %d meshes in %.2f seconds, %d meshes have degenerate triangles"),
+		Report.NumTriangles, Report.NumTriMeshes, Report.NumMeshes, Report.ElapsedSeconds, Report.ProblemMeshes.Num());
 }
 
 FAutoConsoleCommandWithWorldArgsAndOutputDevice GCheckChaosMeshCollisionCmd(
@@ -77,11 +211,18 @@ FAutoConsoleCommandWithWorldArgsAndOutputDevice GCheckChaosMeshCollisionCmd(
 	TEXT("Usage:\n")
 	TEXT("  Lyra.CheckChaosMeshCollision\n")
 	TEXT("\n")
-	TEXT("It will check Chaos collision data for all *loaded* static mesh assets for any degenerate triangles"),
+	TEXT("It will check Chaos collision data for all *loaded* static mesh assets for any degenerate triangles\n")
+	TEXT("Use the CheckChaosMeshCollision commandlet to check every static mesh under a content path"),
 	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(
 		[](const TArray<FString>& Params, UWorld* World, FOutputDevice& Ar)
 {
-	CheckChaosMeshCollision(Ar);
+	TArray<UStaticMesh*> Meshes;
+	for (UStaticMesh* MeshAsset : TObjectRange<UStaticMesh>())
+	{
+		Meshes.Add(MeshAsset);
+	}
+
+	LogChaosMeshCollisionReport(CheckChaosMeshCollision(Meshes), Ar);
 }));
 
 
@@ -0,0 +1,30 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UStaticMesh;
+
+namespace LyraEditorUtilities
+{
+
+// Results of scanning static mesh collision for degenerate triangles
+struct FChaosMeshCollisionReport
+{
+	int32 NumMeshes = 0;
+	int32 NumTriMeshes = 0;
+	int64 NumTriangles = 0;
+	double ElapsedSeconds = 0.0;
+
+	// Meshes with at least one degenerate collision triangle, and how many they have
+	TArray<TPair<FString, int64>> ProblemMeshes;
+};
+
+// Checks the Chaos collision data of the given meshes for degenerate triangles, spreading the triangles across worker threads
+FChaosMeshCollisionReport CheckChaosMeshCollision(TConstArrayView<UStaticMesh*> Meshes);
+
+// Logs a summary of the report, listing every mesh with problems
+void LogChaosMeshCollisionReport(const FChaosMeshCollisionReport& Report, FOutputDevice& Ar);
+
+}; // End of namespace
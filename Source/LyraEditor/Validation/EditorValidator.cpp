@@ -21,6 +21,15 @@
 #include "SourceCodeNavigation.h"
 #include "Stats/StatsMisc.h"
 #include "DataValidationModule.h"
+#include "Async/ParallelFor.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformMemory.h"
+#include "Misc/FileHelper.h"
+#include "Misc/SecureHash.h"
+#include "Modules/ModuleManager.h"
+#include "Serialization/JsonWriter.h"
+#include "Policies/PrettyJsonPrintPolicy.h"
+#include "UObject/UObjectGlobals.h"
 
 #include "LyraEditor.h"
 
@@ -29,8 +38,210 @@
 int32 GMaxAssetsChangedByAHeader = 200;
 static FAutoConsoleVariableRef CVarMaxAssetsChangedByAHeader(TEXT("EditorValidator.MaxAssetsChangedByAHeader"), GMaxAssetsChangedByAHeader, TEXT("The maximum number of assets to check for content validation based on a single header change."), ECVF_Default);
 
+int32 GValidationPackagesPerBatch = 64;
+static FAutoConsoleVariableRef CVarValidationPackagesPerBatch(TEXT("EditorValidator.PackagesPerBatch"), GValidationPackagesPerBatch, TEXT("How many packages are loaded and validated together before garbage is collected."), ECVF_Default);
+
+int32 GValidationMemoryHighWaterMarkMB = 8192;
+static FAutoConsoleVariableRef CVarValidationMemoryHighWaterMarkMB(TEXT("EditorValidator.MemoryHighWaterMarkMB"), GValidationMemoryHighWaterMarkMB, TEXT("In the editor, garbage is collected between validation batches once used physical memory goes over this many MB (0 to never collect). Commandlets always collect between batches."), ECVF_Default);
+
+bool GUseValidationResultCache = true;
+static FAutoConsoleVariableRef CVarUseValidationResultCache(TEXT("EditorValidator.UseResultCache"), GUseValidationResultCache, TEXT("Should packages that passed validation be skipped until they (or one of their direct dependencies) change?"), ECVF_Default);
+
 bool UEditorValidator::bAllowFullValidationInEditor = false;
+TSet<FName> UEditorValidator::PackagesChangedByCode;
 TArray<FString> FLyraValidationMessageGatherer::IgnorePatterns;
+TMap<FName, FLyraValidatorTiming> UEditorValidator::ValidatorTimings;
+
+//////////////////////////////////////////////////////////////////////
+
+FLyraScopedValidatorTimer::FLyraScopedValidatorTimer(const UObject* InValidator)
+	: ValidatorName(InValidator->GetClass()->GetFName())
+	, StartTime(FPlatformTime::Seconds())
+{
+}
+
+FLyraScopedValidatorTimer::~FLyraScopedValidatorTimer()
+{
+	const double ElapsedSeconds = FPlatformTime::Seconds() - StartTime;
+
+	FLyraValidatorTiming& Timing = UEditorValidator::ValidatorTimings.FindOrAdd(ValidatorName);
+	Timing.NumAssets++;
+	Timing.TotalSeconds += ElapsedSeconds;
+	Timing.MaxSeconds = FMath::Max(Timing.MaxSeconds, ElapsedSeconds);
+}
+
+//////////////////////////////////////////////////////////////////////
+
+namespace LyraValidationCache
+{
+	// Bump to throw away every cached result
+	static const int32 CacheVersion = 1;
+
+	static FString GetCacheFilename()
+	{
+		return FPaths::ProjectSavedDir() / TEXT("Validation") / TEXT("PackageValidationCache.txt");
+	}
+
+	// Results are only reused by the same validation use case and the same build of the validators and the game classes they check
+	static FString GetCacheHeader(const EDataValidationUsecase InValidationUsecase)
+	{
+		FString Header = FString::Printf(TEXT("Version=%d Usecase=%d"), CacheVersion, (int32)InValidationUsecase);
+
+		for (const TCHAR* ModuleName : { TEXT("LyraEditor"), TEXT("LyraGame") })
+		{
+			FDateTime ModuleTimeStamp;
+			FModuleStatus ModuleStatus;
+			if (FModuleManager::Get().QueryModule(ModuleName, ModuleStatus))
+			{
+				ModuleTimeStamp = IFileManager::Get().GetTimeStamp(*ModuleStatus.FilePath);
+			}
+
+			Header += FString::Printf(TEXT(" %s=%s"), ModuleName, *ModuleTimeStamp.ToString());
+		}
+
+		return Header;
+	}
+
+	static void Load(const FString& ExpectedHeader, TMap<FName, FString>& OutPassedPackageHashes)
+	{
+		TArray<FString> Lines;
+		if (!FFileHelper::LoadFileToStringArray(Lines, *GetCacheFilename()) || (Lines.Num() == 0) || (Lines[0] != ExpectedHeader))
+		{
+			return;
+		}
+
+		for (int32 LineIndex = 1; LineIndex < Lines.Num(); ++LineIndex)
+		{
+			FString PackageName;
+			FString Hash;
+			if (Lines[LineIndex].Split(TEXT(" "), &PackageName, &Hash))
+			{
+				OutPassedPackageHashes.Add(FName(*PackageName), Hash);
+			}
+		}
+	}
+
+	static void Save(const FString& Header, const TMap<FName, FString>& PassedPackageHashes)
+	{
+		TArray<FString> Lines;
+		Lines.Reserve(PassedPackageHashes.Num() + 1);
+		Lines.Add(Header);
+
+		for (const TPair<FName, FString>& KVP : PassedPackageHashes)
+		{
+			Lines.Add(FString::Printf(TEXT("%s %s"), *KVP.Key.ToString(), *KVP.Value));
+		}
+
+		FFileHelper::SaveStringArrayToFile(Lines, *GetCacheFilename());
+	}
+
+	// Hashes each package's file together with the files of its direct hard dependencies. The files are hashed in parallel.
+	static void ComputePackageHashes(IAssetRegistry& AssetRegistry, const TArray<FName>& PackageNames, TMap<FName, FString>& OutPackageHashes)
+	{
+		TArray<TArray<FName>> PackageDependencies;
+		PackageDependencies.SetNum(PackageNames.Num());
+
+		TMap<FName, int32> FileIndexByPackage;
+		TArray<FString> Filenames;
+
+		auto AddFile = [&FileIndexByPackage, &Filenames](FName PackageName)
+		{
+			if (!FileIndexByPackage.Contains(PackageName))
+			{
+				FString Filename;
+				const bool bExists = !FPackageName::IsScriptPackage(PackageName.ToString()) && FPackageName::DoesPackageExist(PackageName.ToString(), &Filename);
+				FileIndexByPackage.Add(PackageName, bExists ? Filenames.Add(Filename) : INDEX_NONE);
+			}
+		};
+
+		for (int32 PackageIndex = 0; PackageIndex < PackageNames.Num(); ++PackageIndex)
+		{
+			AddFile(PackageNames[PackageIndex]);
+
+			AssetRegistry.GetDependencies(PackageNames[PackageIndex], PackageDependencies[PackageIndex], UE::AssetRegistry::EDependencyCategory::Package, UE::AssetRegistry::EDependencyQuery::Hard);
+			PackageDependencies[PackageIndex].Sort(FNameLexicalLess());
+
+			for (FName Dependency : PackageDependencies[PackageIndex])
+			{
+				AddFile(Dependency);
+			}
+		}
+
+		TArray<FMD5Hash> FileHashes;
+		FileHashes.SetNum(Filenames.Num());
+		ParallelFor(Filenames.Num(), [&Filenames, &FileHashes](int32 FileIndex)
+		{
+			FileHashes[FileIndex] = FMD5Hash::HashFile(*Filenames[FileIndex]);
+		});
+
+		for (int32 PackageIndex = 0; PackageIndex < PackageNames.Num(); ++PackageIndex)
+		{
+			const int32 PackageFileIndex = FileIndexByPackage.FindChecked(PackageNames[PackageIndex]);
+			if (PackageFileIndex == INDEX_NONE || !FileHashes[PackageFileIndex].IsValid())
+			{
+				continue;
+			}
+
+			FMD5 CombinedHash;
+			CombinedHash.Update(FileHashes[PackageFileIndex].GetBytes(), FileHashes[PackageFileIndex].GetSize());
+
+			for (FName Dependency : PackageDependencies[PackageIndex])
+			{
+				const int32 DependencyFileIndex = FileIndexByPackage.FindChecked(Dependency);
+				if (DependencyFileIndex != INDEX_NONE && FileHashes[DependencyFileIndex].IsValid())
+				{
+					CombinedHash.Update(FileHashes[DependencyFileIndex].GetBytes(), FileHashes[DependencyFileIndex].GetSize());
+				}
+				else
+				{
+					// Script and missing packages still change the hash if they're added or removed
+					const FString DependencyString = Dependency.ToString();
+					CombinedHash.Update((const uint8*)*DependencyString, DependencyString.Len() * sizeof(TCHAR));
+				}
+			}
+
+			FMD5Hash PackageHash;
+			PackageHash.Set(CombinedHash);
+			OutPackageHashes.Add(PackageNames[PackageIndex], LexToString(PackageHash));
+		}
+	}
+
+	// The source control validator's result depends on whether the package and its dependencies are source controlled, so that goes in the key too
+	static void AppendSourceControlState(IAssetRegistry& AssetRegistry, TMap<FName, FString>& InOutPackageHashes)
+	{
+		if (!ISourceControlModule::Get().IsEnabled())
+		{
+			return;
+		}
+
+		ISourceControlProvider& SourceControlProvider = ISourceControlModule::Get().GetProvider();
+		auto GetSourceControlledChar = [&SourceControlProvider](const FString& PackageName)
+		{
+			FSourceControlStatePtr State = SourceControlProvider.GetState(SourceControlHelpers::PackageFilename(PackageName), EStateCacheUsage::Use);
+			return !State.IsValid() ? TEXT('?') : (State->IsSourceControlled() ? TEXT('1') : TEXT('0'));
+		};
+
+		for (TPair<FName, FString>& KVP : InOutPackageHashes)
+		{
+			FString SourceControlState;
+			SourceControlState.AppendChar(GetSourceControlledChar(KVP.Key.ToString()));
+
+			TArray<FName> Dependencies;
+			AssetRegistry.GetDependencies(KVP.Key, Dependencies, UE::AssetRegistry::EDependencyCategory::Package);
+			Dependencies.Sort(FNameLexicalLess());
+			for (FName Dependency : Dependencies)
+			{
+				const FString DependencyString = Dependency.ToString();
+				if (!FPackageName::IsScriptPackage(DependencyString))
+				{
+					SourceControlState.AppendChar(GetSourceControlledChar(DependencyString));
+				}
+			}
+
+			KVP.Value += TEXT("-") + SourceControlState;
+		}
+	}
+}
 
 UEditorValidator::UEditorValidator()
 	: Super()
@@ -161,6 +372,11 @@ bool UEditorValidator::ValidatePackages(const TArray<FString>& ExistingPackageNa
 	IAssetRegistry& AssetRegistry = AssetRegistryModule.Get();
 
 	TArray<FString> AllPackagesToValidate = ExistingPackageNames;
+
+	// Packages that only need validating because something they use changed have the same hash as when they last passed, so never skip those
+	TSet<FName> UncachedPackageNames = MoveTemp(PackagesChangedByCode);
+	PackagesChangedByCode.Reset();
+
 	for (const FString& DeletedPackageName : DeletedPackageNames)
 	{
 		UE_LOG(LogLyraEditor, Display, TEXT("Adding referencers for deleted package %s to be verified"), *DeletedPackageName);
@@ -173,6 +389,7 @@ bool UEditorValidator::ValidatePackages(const TArray<FString>& ExistingPackageNa
 			{
 				UE_LOG(LogLyraEditor, Display, TEXT("    Deleted package referencer %s was added to the queue to be verified"), *ReferencerString);
 				AllPackagesToValidate.Add(ReferencerString);
+				UncachedPackageNames.Add(Referencer);
 			}
 		}
 	}
@@ -240,57 +457,254 @@ bool UEditorValidator::ValidatePackages(const TArray<FString>& ExistingPackageNa
 
 		if (AssetsToCheck.Num() > 0)
 		{
-			// Preload all assets to check, so load warnings can be handled separately from validation warnings
+			ValidatorTimings.Reset();
+
+			TMap<FString, double> PhaseSeconds;
+			TMap<FString, int32> Counts;
+			Counts.Add(TEXT("Assets"), AssetsToCheck.Num());
+
+			// Skip packages that passed before and haven't changed since
+			const FString CacheHeader = LyraValidationCache::GetCacheHeader(InValidationUsecase);
+			TMap<FName, FString> PassedPackageHashes;
+			TMap<FName, FString> CurrentPackageHashes;
+			if (GUseValidationResultCache)
 			{
+				const double HashStartTime = FPlatformTime::Seconds();
+
+				TArray<FName> PackageNames;
 				for (const FAssetData& AssetToCheck : AssetsToCheck)
 				{
-					if (!AssetToCheck.IsAssetLoaded())
+					PackageNames.AddUnique(AssetToCheck.PackageName);
+				}
+
+				LyraValidationCache::Load(CacheHeader, PassedPackageHashes);
+				LyraValidationCache::ComputePackageHashes(AssetRegistry, PackageNames, CurrentPackageHashes);
+				LyraValidationCache::AppendSourceControlState(AssetRegistry, CurrentPackageHashes);
+
+				const int32 NumAssetsBeforeCache = AssetsToCheck.Num();
+				AssetsToCheck.RemoveAll([&PassedPackageHashes, &CurrentPackageHashes, &UncachedPackageNames](const FAssetData& AssetToCheck)
+				{
+					if (UncachedPackageNames.Contains(AssetToCheck.PackageName))
 					{
-						UE_LOG(LogLyraEditor, Display, TEXT("Preloading %s..."), *AssetToCheck.ObjectPath.ToString());
+						return false;
+					}
+
+					const FString* PassedHash = PassedPackageHashes.Find(AssetToCheck.PackageName);
+					const FString* CurrentHash = CurrentPackageHashes.Find(AssetToCheck.PackageName);
+					return PassedHash && CurrentHash && (*PassedHash == *CurrentHash);
+				});
+
+				Counts.Add(TEXT("CachedAssets"), NumAssetsBeforeCache - AssetsToCheck.Num());
+				PhaseSeconds.Add(TEXT("Hash"), FPlatformTime::Seconds() - HashStartTime);
 
-						// Start listening for load warnings
-						FLyraValidationMessageGatherer ScopedPreloadMessageGatherer;
-						
-						// Load the asset
-						AssetToCheck.GetAsset();
+				UE_LOG(LogLyraEditor, Display, TEXT("Skipping %d assets that passed validation before and haven't changed"), NumAssetsBeforeCache - AssetsToCheck.Num());
+			}
+
+			// Work through the assets in batches, a package's assets are always in the same batch
+			const int32 PackagesPerBatch = FMath::Max(1, GValidationPackagesPerBatch);
+			int32 NumBatches = 0;
 
-						if (ScopedPreloadMessageGatherer.GetAllWarningsAndErrors().Num() > 0)
+			for (int32 BatchStart = 0; BatchStart < AssetsToCheck.Num(); )
+			{
+				int32 BatchEnd = BatchStart;
+				TArray<FName> BatchPackageNames;
+				while (BatchEnd < AssetsToCheck.Num())
+				{
+					const FName PackageName = AssetsToCheck[BatchEnd].PackageName;
+					if (!BatchPackageNames.Contains(PackageName))
+					{
+						if (BatchPackageNames.Num() >= PackagesPerBatch)
 						{
-							// Repeat all errant load warnings as errors, so other CIS systems can treat them more severely (i.e. Build health will create an issue and assign it to a developer)
-							for (const FString& LoadWarning : ScopedPreloadMessageGatherer.GetAllWarnings())
-							{
-								UE_LOG(LogLyraEditor, Error, TEXT("%s"), *LoadWarning);
-							}
+							break;
+						}
+						BatchPackageNames.Add(PackageName);
+					}
+					++BatchEnd;
+				}
+
+				TArray<FAssetData> BatchAssets(AssetsToCheck.GetData() + BatchStart, BatchEnd - BatchStart);
+				const bool bIsLastBatch = (BatchEnd == AssetsToCheck.Num());
+				BatchStart = BatchEnd;
+				NumBatches++;
+
+				bool bBatchPassed = true;
 
-							OutAllWarningsAndErrors.Append(ScopedPreloadMessageGatherer.GetAllWarningsAndErrors());
-							bAnyIssuesFound = true;
+				// Preload the batch, so load warnings can be handled separately from validation warnings
+				{
+					const double LoadStartTime = FPlatformTime::Seconds();
+
+					// Start listening for load warnings
+					FLyraValidationMessageGatherer ScopedPreloadMessageGatherer;
+
+					// Issue every load up front and let the loader work through them together
+					bool bAnyLoadsIssued = false;
+					for (const FName PackageName : BatchPackageNames)
+					{
+						if (!FindPackage(nullptr, *PackageName.ToString()))
+						{
+							UE_LOG(LogLyraEditor, Display, TEXT("Preloading %s..."), *PackageName.ToString());
+							LoadPackageAsync(PackageName.ToString());
+							bAnyLoadsIssued = true;
 						}
 					}
+
+					if (bAnyLoadsIssued)
+					{
+						FlushAsyncLoading();
+					}
+
+					// Anything that didn't come in with its package is loaded synchronously
+					for (const FAssetData& AssetToCheck : BatchAssets)
+					{
+						if (!AssetToCheck.IsAssetLoaded())
+						{
+							AssetToCheck.GetAsset();
+						}
+					}
+
+					if (ScopedPreloadMessageGatherer.GetAllWarningsAndErrors().Num() > 0)
+					{
+						// Repeat all errant load warnings as errors, so other CIS systems can treat them more severely (i.e. Build health will create an issue and assign it to a developer)
+						for (const FString& LoadWarning : ScopedPreloadMessageGatherer.GetAllWarnings())
+						{
+							UE_LOG(LogLyraEditor, Error, TEXT("%s"), *LoadWarning);
+						}
+
+						OutAllWarningsAndErrors.Append(ScopedPreloadMessageGatherer.GetAllWarningsAndErrors());
+						bAnyIssuesFound = true;
+						bBatchPassed = false;
+					}
+
+					PhaseSeconds.FindOrAdd(TEXT("Load")) += FPlatformTime::Seconds() - LoadStartTime;
 				}
-			}
 
-			// Run all validators now.
-			FLyraValidationMessageGatherer ScopedMessageGatherer;
-			FValidateAssetsSettings Settings;
-			FValidateAssetsResults Results;
+				// Run all validators on the batch now.
+				{
+					const double ValidateStartTime = FPlatformTime::Seconds();
+
+					FLyraValidationMessageGatherer ScopedMessageGatherer;
+					FValidateAssetsSettings Settings;
+					FValidateAssetsResults Results;
 
-			Settings.bSkipExcludedDirectories = true;
-			Settings.bShowIfNoFailures = true;
-			Settings.ValidationUsecase = InValidationUsecase;
+					Settings.bSkipExcludedDirectories = true;
+					Settings.bShowIfNoFailures = bIsLastBatch;
+					Settings.ValidationUsecase = InValidationUsecase;
 
-			const bool bHasInvalidFiles = GEditor->GetEditorSubsystem<UEditorValidatorSubsystem>()->ValidateAssetsWithSettings(AssetsToCheck, Settings, Results) > 0;
+					const bool bHasInvalidFiles = GEditor->GetEditorSubsystem<UEditorValidatorSubsystem>()->ValidateAssetsWithSettings(BatchAssets, Settings, Results) > 0;
 
-			if (bHasInvalidFiles || ScopedMessageGatherer.GetAllWarningsAndErrors().Num() > 0)
+					if (bHasInvalidFiles || ScopedMessageGatherer.GetAllWarningsAndErrors().Num() > 0)
+					{
+						OutAllWarningsAndErrors.Append(ScopedMessageGatherer.GetAllWarningsAndErrors());
+						bAnyIssuesFound = true;
+						bBatchPassed = false;
+					}
+
+					PhaseSeconds.FindOrAdd(TEXT("Validate")) += FPlatformTime::Seconds() - ValidateStartTime;
+				}
+
+				// Warnings can't be attributed to a single package, so only a clean batch is remembered as passing
+				if (bBatchPassed)
+				{
+					for (const FName PackageName : BatchPackageNames)
+					{
+						if (const FString* CurrentHash = CurrentPackageHashes.Find(PackageName))
+						{
+							PassedPackageHashes.Add(PackageName, *CurrentHash);
+						}
+					}
+				}
+				else
+				{
+					for (const FName PackageName : BatchPackageNames)
+					{
+						PassedPackageHashes.Remove(PackageName);
+					}
+				}
+
+				// Keep memory bounded before moving on to the next batch
+				if (!bIsLastBatch)
+				{
+					const uint64 UsedPhysicalMB = FPlatformMemory::GetStats().UsedPhysical / (1024 * 1024);
+					const bool bOverHighWaterMark = (GValidationMemoryHighWaterMarkMB > 0) && (UsedPhysicalMB > (uint64)GValidationMemoryHighWaterMarkMB);
+
+					if (IsRunningCommandlet() || bOverHighWaterMark)
+					{
+						const double GCStartTime = FPlatformTime::Seconds();
+
+						// Commandlets don't hold on to anything we loaded, so standalone assets can be purged as well
+						CollectGarbage(IsRunningCommandlet() ? RF_NoFlags : GARBAGE_COLLECTION_KEEPFLAGS);
+
+						PhaseSeconds.FindOrAdd(TEXT("GarbageCollection")) += FPlatformTime::Seconds() - GCStartTime;
+						Counts.FindOrAdd(TEXT("GarbageCollections"))++;
+					}
+				}
+			}
+
+			Counts.Add(TEXT("Batches"), NumBatches);
+
+			if (GUseValidationResultCache)
 			{
-				OutAllWarningsAndErrors.Append(ScopedMessageGatherer.GetAllWarningsAndErrors());
-				bAnyIssuesFound = true;
+				LyraValidationCache::Save(CacheHeader, PassedPackageHashes);
 			}
+
+			WriteTimingReport(PhaseSeconds, Counts);
 		}
 	}
 
 	return !bAnyIssuesFound;
 }
 
+void UEditorValidator::WriteTimingReport(const TMap<FString, double>& PhaseSeconds, const TMap<FString, int32>& Counts)
+{
+	FString ReportString;
+	TSharedRef<TJsonWriter<TCHAR, TPrettyJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TPrettyJsonPrintPolicy<TCHAR>>::Create(&ReportString);
+
+	Writer->WriteObjectStart();
+
+	Writer->WriteObjectStart(TEXT("Counts"));
+	for (const TPair<FString, int32>& KVP : Counts)
+	{
+		Writer->WriteValue(KVP.Key, KVP.Value);
+	}
+	Writer->WriteObjectEnd();
+
+	Writer->WriteObjectStart(TEXT("PhaseSeconds"));
+	for (const TPair<FString, double>& KVP : PhaseSeconds)
+	{
+		Writer->WriteValue(KVP.Key, KVP.Value);
+	}
+	Writer->WriteObjectEnd();
+
+	// Slowest validators first
+	TArray<FName> ValidatorNames;
+	ValidatorTimings.GetKeys(ValidatorNames);
+	ValidatorNames.Sort([](const FName& A, const FName& B) { return ValidatorTimings[A].TotalSeconds > ValidatorTimings[B].TotalSeconds; });
+
+	Writer->WriteArrayStart(TEXT("Validators"));
+	for (const FName ValidatorName : ValidatorNames)
+	{
+		const FLyraValidatorTiming& Timing = ValidatorTimings[ValidatorName];
+
+		Writer->WriteObjectStart();
+		Writer->WriteValue(TEXT("Name"), ValidatorName.ToString());
+		Writer->WriteValue(TEXT("Assets"), Timing.NumAssets);
+		Writer->WriteValue(TEXT("TotalSeconds"), Timing.TotalSeconds);
+		Writer->WriteValue(TEXT("MaxSeconds"), Timing.MaxSeconds);
+		Writer->WriteValue(TEXT("AverageSeconds"), (Timing.NumAssets > 0) ? (Timing.TotalSeconds / Timing.NumAssets) : 0.0);
+		Writer->WriteObjectEnd();
+	}
+	Writer->WriteArrayEnd();
+
+	Writer->WriteObjectEnd();
+	Writer->Close();
+
+	const FString ReportFilename = FPaths::ProjectSavedDir() / TEXT("Validation") / TEXT("ValidationTiming.json");
+	if (FFileHelper::SaveStringToFile(ReportString, *ReportFilename))
+	{
+		UE_LOG(LogLyraEditor, Display, TEXT("Wrote validation timing report to %s"), *FPaths::ConvertRelativePathToFull(ReportFilename));
+	}
+}
+
 bool UEditorValidator::ValidateProjectSettings()
 {
 	bool bSuccess = true;
@@ -485,6 +899,7 @@ void UEditorValidator::GetChangedAssetsForCode(IAssetRegistry& AssetRegistry, co
 		for (const FAssetData& BlueprintsDerivedFromNativeModifiedClass : BlueprintsDerivedFromNativeModifiedClasses)
 		{
 			OutChangedPackageNames.Add(BlueprintsDerivedFromNativeModifiedClass.PackageName.ToString());
+			PackagesChangedByCode.Add(BlueprintsDerivedFromNativeModifiedClass.PackageName);
 		}
 	}
 }
@@ -76,6 +76,26 @@ private:
 	static TArray<FString> IgnorePatterns;
 };
 
+/** Time spent in one validator while validating packages, see FLyraScopedValidatorTimer */
+struct FLyraValidatorTiming
+{
+	int32 NumAssets = 0;
+	double TotalSeconds = 0.0;
+	double MaxSeconds = 0.0;
+};
+
+/** Records how long a validator spends validating an asset, for the timing report written by UEditorValidator::ValidatePackages */
+class FLyraScopedValidatorTimer
+{
+public:
+	FLyraScopedValidatorTimer(const UObject* InValidator);
+	~FLyraScopedValidatorTimer();
+
+private:
+	FName ValidatorName;
+	double StartTime = 0.0;
+};
+
 UCLASS(Abstract)
 class UEditorValidator : public UEditorValidatorBase
 {
@@ -99,6 +119,16 @@ protected:
 	static TArray<FString> TestMapsFolders;
 
 private:
+	friend FLyraScopedValidatorTimer;
+
+	static void WriteTimingReport(const TMap<FString, double>& PhaseSeconds, const TMap<FString, int32>& Counts);
+
+	// Packages GetChangedAssetsForCode has returned since the last ValidatePackages, they are never skipped by the result cache
+	static TSet<FName> PackagesChangedByCode;
+
+	/** Per-validator timings for the current ValidatePackages call, keyed by validator class name */
+	static TMap<FName, FLyraValidatorTiming> ValidatorTimings;
+
 	/**
 	 * Used by some validators to determine if it is okay to load referencing assets or other slow tasks. 
 	 * This is not okay for fast operations like saving, but is fine for slower "check everything thoroughly" tests
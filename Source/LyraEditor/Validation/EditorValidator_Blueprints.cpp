@@ -22,6 +22,8 @@ bool UEditorValidator_Blueprints::CanValidateAsset_Implementation(UObject* InAss
 
 EDataValidationResult UEditorValidator_Blueprints::ValidateLoadedAsset_Implementation(UObject* InAsset, TArray<FText>& ValidationErrors)
 {
+	FLyraScopedValidatorTimer ValidatorTimer(this);
+
 	UBlueprint* Blueprint = Cast<UBlueprint>(InAsset);
 	check(Blueprint);
 
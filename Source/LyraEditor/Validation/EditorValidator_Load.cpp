@@ -35,6 +35,8 @@ bool UEditorValidator_Load::CanValidateAsset_Implementation(UObject* InAsset) co
 
 EDataValidationResult UEditorValidator_Load::ValidateLoadedAsset_Implementation(UObject* InAsset, TArray<FText>& ValidationErrors)
 {
+	FLyraScopedValidatorTimer ValidatorTimer(this);
+
 	check(InAsset);
 
 	TArray<FString> WarningsAndErrors;
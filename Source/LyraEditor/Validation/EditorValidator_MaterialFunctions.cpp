@@ -21,6 +21,8 @@ bool UEditorValidator_MaterialFunctions::CanValidateAsset_Implementation(UObject
 
 EDataValidationResult UEditorValidator_MaterialFunctions::ValidateLoadedAsset_Implementation(UObject* InAsset, TArray<FText>& ValidationErrors)
 {
+	FLyraScopedValidatorTimer ValidatorTimer(this);
+
 	UMaterialFunction* MaterialFunction = Cast<UMaterialFunction>(InAsset);
 	check(MaterialFunction);
 
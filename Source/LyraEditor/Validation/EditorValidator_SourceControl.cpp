@@ -23,6 +23,8 @@ bool UEditorValidator_SourceControl::CanValidateAsset_Implementation(UObject* In
 
 EDataValidationResult UEditorValidator_SourceControl::ValidateLoadedAsset_Implementation(UObject* InAsset, TArray<FText>& ValidationErrors)
 {
+	FLyraScopedValidatorTimer ValidatorTimer(this);
+
 	check(InAsset);
 
 	FName PackageFName = InAsset->GetOutermost()->GetFName();
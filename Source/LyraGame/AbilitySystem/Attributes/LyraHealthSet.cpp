@@ -8,6 +8,7 @@
 #include "GameplayEffectTypes.h"
 #include "Messages/LyraVerbMessage.h"
 #include "GameFramework/GameplayMessageSubsystem.h"
+#include "Weapons/LyraDamageTelemetrySubsystem.h"
 
 UE_DEFINE_GAMEPLAY_TAG(TAG_Gameplay_Damage, "Gameplay.Damage");
 UE_DEFINE_GAMEPLAY_TAG(TAG_Gameplay_DamageImmunity, "Gameplay.DamageImmunity");
@@ -103,10 +104,20 @@ void ULyraHealthSet::PostGameplayEffectExecute(const FGameplayEffectModCallbackD
 
 			UGameplayMessageSubsystem& MessageSystem = UGameplayMessageSubsystem::Get(GetWorld());
 			MessageSystem.BroadcastMessage(Message.Verb, Message);
+
+			if (ULyraDamageTelemetrySubsystem* DamageTelemetry = UWorld::GetSubsystem<ULyraDamageTelemetrySubsystem>(GetWorld()))
+			{
+				DamageTelemetry->RecordDamage(GetOwningActor(), Data.EffectSpec.GetEffectContext().GetSourceObject(), -Data.EvaluatedData.Magnitude);
+			}
 		}
 
 		if ((GetHealth() <= 0.0f) && !bOutOfHealth)
 		{
+			if (ULyraDamageTelemetrySubsystem* DamageTelemetry = UWorld::GetSubsystem<ULyraDamageTelemetrySubsystem>(GetWorld()))
+			{
+				DamageTelemetry->RecordKill(GetOwningActor(), Data.EffectSpec.GetEffectContext().GetSourceObject());
+			}
+
 			if (OnOutOfHealth.IsBound())
 			{
 				const FGameplayEffectContextHandle& EffectContext = Data.EffectSpec.GetEffectContext();
@@ -88,6 +88,72 @@ void ULyraAbilitySystemComponent::TryActivateAbilitiesOnSpawn()
 	}
 }
 
+void ULyraAbilitySystemComponent::OnGiveAbility(FGameplayAbilitySpec& AbilitySpec)
+{
+	Super::OnGiveAbility(AbilitySpec);
+
+	// Index the ability by its input tags so input events only visit the abilities bound to them.
+	for (const FGameplayTag& Tag : AbilitySpec.DynamicAbilityTags)
+	{
+		InputTagToSpecHandles.AddUnique(Tag, AbilitySpec.Handle);
+	}
+
+	CacheAbilitySpecIndex(AbilitySpec);
+}
+
+void ULyraAbilitySystemComponent::OnRemoveAbility(FGameplayAbilitySpec& AbilitySpec)
+{
+	for (const FGameplayTag& Tag : AbilitySpec.DynamicAbilityTags)
+	{
+		InputTagToSpecHandles.Remove(Tag, AbilitySpec.Handle);
+	}
+
+	SpecHandleToIndex.Remove(AbilitySpec.Handle);
+
+	Super::OnRemoveAbility(AbilitySpec);
+}
+
+void ULyraAbilitySystemComponent::CacheAbilitySpecIndex(const FGameplayAbilitySpec& AbilitySpec)
+{
+	const TArray<FGameplayAbilitySpec>& Items = ActivatableAbilities.Items;
+
+	int32 Index = INDEX_NONE;
+	if ((Items.Num() > 0) && (&AbilitySpec >= Items.GetData()) && (&AbilitySpec < (Items.GetData() + Items.Num())))
+	{
+		Index = (int32)(&AbilitySpec - Items.GetData());
+	}
+	else
+	{
+		Index = Items.IndexOfByPredicate([&AbilitySpec](const FGameplayAbilitySpec& Spec) { return (Spec.Handle == AbilitySpec.Handle); });
+	}
+
+	SpecHandleToIndex.Add(AbilitySpec.Handle, Index);
+}
+
+FGameplayAbilitySpec* ULyraAbilitySystemComponent::FindAbilitySpecFromHandleCached(FGameplayAbilitySpecHandle Handle)
+{
+	TArray<FGameplayAbilitySpec>& Items = ActivatableAbilities.Items;
+
+	int32* CachedIndex = SpecHandleToIndex.Find(Handle);
+	if (CachedIndex && Items.IsValidIndex(*CachedIndex) && (Items[*CachedIndex].Handle == Handle))
+	{
+		return &Items[*CachedIndex];
+	}
+
+	// The cache is stale (items were removed or reordered) or the handle was never cached, so search and refresh it.
+	FGameplayAbilitySpec* AbilitySpec = FindAbilitySpecFromHandle(Handle);
+	if (AbilitySpec)
+	{
+		CacheAbilitySpecIndex(*AbilitySpec);
+	}
+	else if (CachedIndex)
+	{
+		SpecHandleToIndex.Remove(Handle);
+	}
+
+	return AbilitySpec;
+}
+
 void ULyraAbilitySystemComponent::CancelAbilitiesByFunc(TShouldCancelAbilityFunc ShouldCancelFunc, bool bReplicateCancelAbility)
 {
 	ABILITYLIST_SCOPE_LOCK();
@@ -175,12 +241,13 @@ void ULyraAbilitySystemComponent::AbilityInputTagPressed(const FGameplayTag& Inp
 {
 	if (InputTag.IsValid())
 	{
-		for (const FGameplayAbilitySpec& AbilitySpec : ActivatableAbilities.Items)
+		for (TMultiMap<FGameplayTag, FGameplayAbilitySpecHandle>::TConstKeyIterator It = InputTagToSpecHandles.CreateConstKeyIterator(InputTag); It; ++It)
 		{
-			if (AbilitySpec.Ability && (AbilitySpec.DynamicAbilityTags.HasTagExact(InputTag)))
+			const FGameplayAbilitySpec* AbilitySpec = FindAbilitySpecFromHandleCached(It.Value());
+			if (AbilitySpec && AbilitySpec->Ability && (AbilitySpec->DynamicAbilityTags.HasTagExact(InputTag)))
 			{
-				InputPressedSpecHandles.AddUnique(AbilitySpec.Handle);
-				InputHeldSpecHandles.AddUnique(AbilitySpec.Handle);
+				InputPressedSpecHandles.AddUnique(AbilitySpec->Handle);
+				InputHeldSpecHandles.AddUnique(AbilitySpec->Handle);
 			}
 		}
 	}
@@ -190,12 +257,13 @@ void ULyraAbilitySystemComponent::AbilityInputTagReleased(const FGameplayTag& In
 {
 	if (InputTag.IsValid())
 	{
-		for (const FGameplayAbilitySpec& AbilitySpec : ActivatableAbilities.Items)
+		for (TMultiMap<FGameplayTag, FGameplayAbilitySpecHandle>::TConstKeyIterator It = InputTagToSpecHandles.CreateConstKeyIterator(InputTag); It; ++It)
 		{
-			if (AbilitySpec.Ability && (AbilitySpec.DynamicAbilityTags.HasTagExact(InputTag)))
+			const FGameplayAbilitySpec* AbilitySpec = FindAbilitySpecFromHandleCached(It.Value());
+			if (AbilitySpec && AbilitySpec->Ability && (AbilitySpec->DynamicAbilityTags.HasTagExact(InputTag)))
 			{
-				InputReleasedSpecHandles.AddUnique(AbilitySpec.Handle);
-				InputHeldSpecHandles.Remove(AbilitySpec.Handle);
+				InputReleasedSpecHandles.AddUnique(AbilitySpec->Handle);
+				InputHeldSpecHandles.Remove(AbilitySpec->Handle);
 			}
 		}
 	}
@@ -219,7 +287,7 @@ void ULyraAbilitySystemComponent::ProcessAbilityInput(float DeltaTime, bool bGam
 	//
 	for (const FGameplayAbilitySpecHandle& SpecHandle : InputHeldSpecHandles)
 	{
-		if (const FGameplayAbilitySpec* AbilitySpec = FindAbilitySpecFromHandle(SpecHandle))
+		if (const FGameplayAbilitySpec* AbilitySpec = FindAbilitySpecFromHandleCached(SpecHandle))
 		{
 			if (AbilitySpec->Ability && !AbilitySpec->IsActive())
 			{
@@ -238,7 +306,7 @@ void ULyraAbilitySystemComponent::ProcessAbilityInput(float DeltaTime, bool bGam
 	//
 	for (const FGameplayAbilitySpecHandle& SpecHandle : InputPressedSpecHandles)
 	{
-		if (FGameplayAbilitySpec* AbilitySpec = FindAbilitySpecFromHandle(SpecHandle))
+		if (FGameplayAbilitySpec* AbilitySpec = FindAbilitySpecFromHandleCached(SpecHandle))
 		{
 			if (AbilitySpec->Ability)
 			{
@@ -277,7 +345,7 @@ void ULyraAbilitySystemComponent::ProcessAbilityInput(float DeltaTime, bool bGam
 	//
 	for (const FGameplayAbilitySpecHandle& SpecHandle : InputReleasedSpecHandles)
 	{
-		if (FGameplayAbilitySpec* AbilitySpec = FindAbilitySpecFromHandle(SpecHandle))
+		if (FGameplayAbilitySpec* AbilitySpec = FindAbilitySpecFromHandleCached(SpecHandle))
 		{
 			if (AbilitySpec->Ability)
 			{
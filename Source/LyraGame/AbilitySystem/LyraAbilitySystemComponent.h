@@ -71,6 +71,14 @@ protected:
 
 	void TryActivateAbilitiesOnSpawn();
 
+	virtual void OnGiveAbility(FGameplayAbilitySpec& AbilitySpec) override;
+	virtual void OnRemoveAbility(FGameplayAbilitySpec& AbilitySpec) override;
+
+	// Finds the ability spec for the handle using the cached index, falling back to a linear search if the cache is stale.
+	FGameplayAbilitySpec* FindAbilitySpecFromHandleCached(FGameplayAbilitySpecHandle Handle);
+
+	void CacheAbilitySpecIndex(const FGameplayAbilitySpec& AbilitySpec);
+
 	virtual void AbilitySpecInputPressed(FGameplayAbilitySpec& Spec) override;
 	virtual void AbilitySpecInputReleased(FGameplayAbilitySpec& Spec) override;
 
@@ -100,6 +108,12 @@ protected:
 	// Handles to abilities that have their input held.
 	TArray<FGameplayAbilitySpecHandle> InputHeldSpecHandles;
 
+	// Input tags mapped to the handles of the granted abilities that are bound to them.
+	TMultiMap<FGameplayTag, FGameplayAbilitySpecHandle> InputTagToSpecHandles;
+
+	// Last known index of each granted ability in ActivatableAbilities.Items (validated on use since removals can shift items).
+	TMap<FGameplayAbilitySpecHandle, int32> SpecHandleToIndex;
+
 	// Number of abilities running in each activation group.
 	int32 ActivationGroupCounts[(uint8)ELyraAbilityActivationGroup::MAX];
 };
@@ -2,6 +2,206 @@
 
 #include "LyraGameplayAbilityTargetData_SingleTargetHit.h"
 #include "LyraGameplayEffectContext.h"
+#include "Engine/World.h"
+#include "Engine/NetDriver.h"
+#include "Engine/NetConnection.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+#include "Physics/LyraCollisionChannels.h"
+#include "UObject/CoreNet.h"
+
+//////////////////////////////////////////////////////////////////////
+
+namespace LyraTargetData
+{
+	static bool bCompactTargetData = true;
+	static FAutoConsoleVariableRef CVarCompactTargetData(
+		TEXT("lyra.Weapon.CompactTargetData"),
+		bCompactTargetData,
+		TEXT("Should hit target data be sent in the compact quantized format rather than as full hit results"),
+		ECVF_Default);
+
+	// Most bullets a packed cartridge will hold, the server can't confirm more than this many hits per shot anyway
+	static const int32 MaxCartridgeHits = 255;
+
+	// Traces that start within this distance of the shared trace start don't send their own
+	static const double TraceStartTolerance = 0.1;
+
+	// Trace ends that can be rebuilt to within this distance from the hit location and trace length don't send their own
+	static const double TraceEndTolerance = 1.0;
+
+	// Which parts of a hit result are sent (or can be rebuilt) in the compact format
+	enum ECompactHitFlags : uint16
+	{
+		CompactHit_BlockingHit = 1 << 0,
+		CompactHit_StartPenetrating = 1 << 1,
+		CompactHit_HitReplaced = 1 << 2,
+		CompactHit_OwnTraceStart = 1 << 3,
+		CompactHit_TraceEndAlongLocation = 1 << 4,
+		CompactHit_ImpactPointIsLocation = 1 << 5,
+		CompactHit_HasNormal = 1 << 6,
+		CompactHit_ImpactNormalIsNormal = 1 << 7,
+		CompactHit_HasHitObject = 1 << 8,
+		CompactHit_HasComponent = 1 << 9,
+		CompactHit_HasPhysMaterial = 1 << 10,
+		CompactHit_HasBoneName = 1 << 11,
+	};
+
+	static const int32 NumCompactHitFlagBits = 12;
+
+	// The value a location will have once it has been through FVector_NetQuantize10
+	static FVector QuantizeLocation(const FVector& Location)
+	{
+		return FVector(FMath::RoundToDouble(Location.X * 10.0), FMath::RoundToDouble(Location.Y * 10.0), FMath::RoundToDouble(Location.Z * 10.0)) / 10.0;
+	}
+
+	static FVector GetTraceEndAlongLocation(const FVector& TraceStart, const FVector& Location, double TraceLength)
+	{
+		return TraceStart + ((Location - TraceStart).GetSafeNormal() * TraceLength);
+	}
+
+	// Offsets along a shot are much smaller than world locations, so this gets 0.1 unit precision for fewer bits than FHitResult spends on 1 unit
+	static bool SerializeOffset(FArchive& Ar, FVector& InOutLocation, const FVector& Origin)
+	{
+		FVector_NetQuantize10 Offset(Ar.IsSaving() ? (InOutLocation - Origin) : FVector::ZeroVector);
+
+		bool bSuccess = true;
+		Offset.NetSerialize(Ar, nullptr, bSuccess);
+
+		if (Ar.IsLoading())
+		{
+			InOutLocation = Origin + Offset;
+		}
+
+		return bSuccess;
+	}
+
+	static bool SerializeNormal(FArchive& Ar, FVector& InOutNormal)
+	{
+		FVector_NetQuantizeNormal Normal(InOutNormal);
+
+		bool bSuccess = true;
+		Normal.NetSerialize(Ar, nullptr, bSuccess);
+
+		InOutNormal = Normal;
+
+		return bSuccess;
+	}
+
+	// Serializes the parts of a hit result the weapon code cares about, relative to a trace start the caller has already serialized
+	// (SharedTraceLength is only used to rebuild trace ends when it's positive)
+	static bool SerializeCompactHit(FArchive& Ar, UPackageMap* Map, FHitResult& Hit, bool& bHitReplaced, const FVector& SharedTraceStart, double SharedTraceLength)
+	{
+		uint16 Flags = 0;
+
+		if (Ar.IsSaving())
+		{
+			const bool bOwnTraceStart = !Hit.TraceStart.Equals(SharedTraceStart, TraceStartTolerance);
+			const FVector QuantizedLocation = SharedTraceStart + QuantizeLocation(Hit.Location - SharedTraceStart);
+			const bool bTraceEndAlongLocation = !bOwnTraceStart && (SharedTraceLength > 0.0) && GetTraceEndAlongLocation(SharedTraceStart, QuantizedLocation, SharedTraceLength).Equals(Hit.TraceEnd, TraceEndTolerance);
+
+			Flags |= Hit.bBlockingHit ? CompactHit_BlockingHit : 0;
+			Flags |= Hit.bStartPenetrating ? CompactHit_StartPenetrating : 0;
+			Flags |= bHitReplaced ? CompactHit_HitReplaced : 0;
+			Flags |= bOwnTraceStart ? CompactHit_OwnTraceStart : 0;
+			Flags |= bTraceEndAlongLocation ? CompactHit_TraceEndAlongLocation : 0;
+			Flags |= (Hit.ImpactPoint == Hit.Location) ? CompactHit_ImpactPointIsLocation : 0;
+			Flags |= !(Hit.Normal.IsZero() && Hit.ImpactNormal.IsZero()) ? CompactHit_HasNormal : 0;
+			Flags |= (Hit.ImpactNormal == Hit.Normal) ? CompactHit_ImpactNormalIsNormal : 0;
+			Flags |= Hit.HitObjectHandle.IsValid() ? CompactHit_HasHitObject : 0;
+			Flags |= Hit.Component.IsValid() ? CompactHit_HasComponent : 0;
+			Flags |= Hit.PhysMaterial.IsValid() ? CompactHit_HasPhysMaterial : 0;
+			Flags |= (Hit.BoneName != NAME_None) ? CompactHit_HasBoneName : 0;
+		}
+
+		Ar.SerializeBits(&Flags, NumCompactHitFlagBits);
+
+		bool bSuccess = true;
+
+		// Everything is relative to the shared trace start, even for hits that have their own
+		if (Flags & CompactHit_OwnTraceStart)
+		{
+			bSuccess &= SerializeOffset(Ar, Hit.TraceStart, SharedTraceStart);
+		}
+		else if (Ar.IsLoading())
+		{
+			Hit.TraceStart = SharedTraceStart;
+		}
+
+		bSuccess &= SerializeOffset(Ar, Hit.Location, SharedTraceStart);
+
+		if (!(Flags & CompactHit_ImpactPointIsLocation))
+		{
+			bSuccess &= SerializeOffset(Ar, Hit.ImpactPoint, SharedTraceStart);
+		}
+		else if (Ar.IsLoading())
+		{
+			Hit.ImpactPoint = Hit.Location;
+		}
+
+		if (!(Flags & CompactHit_TraceEndAlongLocation))
+		{
+			bSuccess &= SerializeOffset(Ar, Hit.TraceEnd, SharedTraceStart);
+		}
+		else if (Ar.IsLoading())
+		{
+			Hit.TraceEnd = GetTraceEndAlongLocation(Hit.TraceStart, Hit.Location, SharedTraceLength);
+		}
+
+		if (Flags & CompactHit_HasNormal)
+		{
+			bSuccess &= SerializeNormal(Ar, Hit.Normal);
+
+			if (!(Flags & CompactHit_ImpactNormalIsNormal))
+			{
+				bSuccess &= SerializeNormal(Ar, Hit.ImpactNormal);
+			}
+			else if (Ar.IsLoading())
+			{
+				Hit.ImpactNormal = Hit.Normal;
+			}
+		}
+		else if (Ar.IsLoading())
+		{
+			Hit.Normal = FVector::ZeroVector;
+			Hit.ImpactNormal = FVector::ZeroVector;
+		}
+
+		if (Flags & CompactHit_HasHitObject)
+		{
+			Ar << Hit.HitObjectHandle;
+		}
+
+		if (Flags & CompactHit_HasComponent)
+		{
+			Ar << Hit.Component;
+		}
+
+		if (Flags & CompactHit_HasPhysMaterial)
+		{
+			Ar << Hit.PhysMaterial;
+		}
+
+		if (Flags & CompactHit_HasBoneName)
+		{
+			Ar << Hit.BoneName;
+		}
+
+		if (Ar.IsLoading())
+		{
+			Hit.bBlockingHit = (Flags & CompactHit_BlockingHit) != 0;
+			Hit.bStartPenetrating = (Flags & CompactHit_StartPenetrating) != 0;
+			bHitReplaced = (Flags & CompactHit_HitReplaced) != 0;
+
+			// Rebuild what wasn't sent
+			const double TraceLength = (Hit.TraceEnd - Hit.TraceStart).Size();
+			Hit.Distance = (float)(Hit.Location - Hit.TraceStart).Size();
+			Hit.Time = (TraceLength > 0.0) ? (float)FMath::Clamp(Hit.Distance / TraceLength, 0.0, 1.0) : 0.0f;
+		}
+
+		return bSuccess && !Ar.IsError();
+	}
+}
 
 //////////////////////////////////////////////////////////////////////
 
@@ -17,6 +217,14 @@ void FLyraGameplayAbilityTargetData_SingleTargetHit::AddTargetDataToContext(FGam
 }
 
 bool FLyraGameplayAbilityTargetData_SingleTargetHit::NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess)
+{
+	uint8 bCompact = (Ar.IsSaving() && LyraTargetData::bCompactTargetData) ? 1 : 0;
+	Ar.SerializeBits(&bCompact, 1);
+
+	return bCompact ? NetSerializeCompact(Ar, Map, bOutSuccess) : NetSerializeFull(Ar, Map, bOutSuccess);
+}
+
+bool FLyraGameplayAbilityTargetData_SingleTargetHit::NetSerializeFull(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess)
 {
 	FGameplayAbilityTargetData_SingleTargetHit::NetSerialize(Ar, Map, bOutSuccess);
 
@@ -24,3 +232,290 @@ bool FLyraGameplayAbilityTargetData_SingleTargetHit::NetSerialize(FArchive& Ar,
 
 	return true;
 }
+
+bool FLyraGameplayAbilityTargetData_SingleTargetHit::NetSerializeCompact(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess)
+{
+	uint32 PackedCartridgeID = (uint32)CartridgeID;
+	Ar.SerializeIntPacked(PackedCartridgeID);
+	CartridgeID = (int32)PackedCartridgeID;
+
+	FVector_NetQuantize10 TraceStart(HitResult.TraceStart);
+	TraceStart.NetSerialize(Ar, Map, bOutSuccess);
+
+	bOutSuccess &= LyraTargetData::SerializeCompactHit(Ar, Map, HitResult, bHitReplaced, LyraTargetData::QuantizeLocation(TraceStart), /*SharedTraceLength=*/ 0.0);
+
+	return true;
+}
+
+//////////////////////////////////////////////////////////////////////
+
+void FLyraGameplayAbilityTargetData_CartridgeHits::PackCartridges(const FGameplayAbilityTargetDataHandle& TargetData, FGameplayAbilityTargetDataHandle& OutPackedTargetData)
+{
+	OutPackedTargetData.Clear();
+	OutPackedTargetData.UniqueId = TargetData.UniqueId;
+
+	FLyraGameplayAbilityTargetData_CartridgeHits* CurrentCartridge = nullptr;
+
+	for (const TSharedPtr<FGameplayAbilityTargetData>& Data : TargetData.Data)
+	{
+		if (Data.IsValid() && (Data->GetScriptStruct() == FLyraGameplayAbilityTargetData_SingleTargetHit::StaticStruct()))
+		{
+			const FLyraGameplayAbilityTargetData_SingleTargetHit* SingleTargetHit = static_cast<const FLyraGameplayAbilityTargetData_SingleTargetHit*>(Data.Get());
+
+			if ((CurrentCartridge == nullptr) || (CurrentCartridge->CartridgeID != SingleTargetHit->CartridgeID) || (CurrentCartridge->HitResults.Num() >= LyraTargetData::MaxCartridgeHits))
+			{
+				CurrentCartridge = new FLyraGameplayAbilityTargetData_CartridgeHits();
+				CurrentCartridge->CartridgeID = SingleTargetHit->CartridgeID;
+				OutPackedTargetData.Add(CurrentCartridge);
+			}
+
+			CurrentCartridge->HitResults.Add(SingleTargetHit->HitResult);
+			CurrentCartridge->HitReplaced.Add(SingleTargetHit->bHitReplaced);
+		}
+		else
+		{
+			CurrentCartridge = nullptr;
+			OutPackedTargetData.Data.Add(Data);
+		}
+	}
+}
+
+void FLyraGameplayAbilityTargetData_CartridgeHits::UnpackCartridges(FGameplayAbilityTargetDataHandle& InOutTargetData)
+{
+	const bool bHasPackedCartridges = InOutTargetData.Data.ContainsByPredicate([](const TSharedPtr<FGameplayAbilityTargetData>& Data)
+	{
+		return Data.IsValid() && (Data->GetScriptStruct() == FLyraGameplayAbilityTargetData_CartridgeHits::StaticStruct());
+	});
+
+	if (!bHasPackedCartridges)
+	{
+		return;
+	}
+
+	TArray<TSharedPtr<FGameplayAbilityTargetData>> UnpackedData;
+	UnpackedData.Reserve(InOutTargetData.Data.Num());
+
+	for (const TSharedPtr<FGameplayAbilityTargetData>& Data : InOutTargetData.Data)
+	{
+		if (Data.IsValid() && (Data->GetScriptStruct() == FLyraGameplayAbilityTargetData_CartridgeHits::StaticStruct()))
+		{
+			const FLyraGameplayAbilityTargetData_CartridgeHits* Cartridge = static_cast<const FLyraGameplayAbilityTargetData_CartridgeHits*>(Data.Get());
+
+			for (int32 HitIndex = 0; HitIndex < Cartridge->HitResults.Num(); ++HitIndex)
+			{
+				FLyraGameplayAbilityTargetData_SingleTargetHit* SingleTargetHit = new FLyraGameplayAbilityTargetData_SingleTargetHit();
+				SingleTargetHit->HitResult = Cartridge->HitResults[HitIndex];
+				SingleTargetHit->bHitReplaced = Cartridge->HitReplaced.IsValidIndex(HitIndex) && Cartridge->HitReplaced[HitIndex];
+				SingleTargetHit->CartridgeID = Cartridge->CartridgeID;
+
+				UnpackedData.Add(TSharedPtr<FGameplayAbilityTargetData>(SingleTargetHit));
+			}
+		}
+		else
+		{
+			UnpackedData.Add(Data);
+		}
+	}
+
+	InOutTargetData.Data = MoveTemp(UnpackedData);
+}
+
+TArray<TWeakObjectPtr<AActor>> FLyraGameplayAbilityTargetData_CartridgeHits::GetActors() const
+{
+	TArray<TWeakObjectPtr<AActor>> Actors;
+	for (const FHitResult& Hit : HitResults)
+	{
+		if (AActor* HitActor = Hit.HitObjectHandle.FetchActor())
+		{
+			Actors.AddUnique(HitActor);
+		}
+	}
+
+	return Actors;
+}
+
+FTransform FLyraGameplayAbilityTargetData_CartridgeHits::GetOrigin() const
+{
+	if (HitResults.Num() > 0)
+	{
+		const FHitResult& FirstHit = HitResults[0];
+		return FTransform((FirstHit.TraceEnd - FirstHit.TraceStart).Rotation(), FirstHit.TraceStart);
+	}
+
+	return FTransform::Identity;
+}
+
+void FLyraGameplayAbilityTargetData_CartridgeHits::AddTargetDataToContext(FGameplayEffectContextHandle& Context, bool bIncludeActorArray) const
+{
+	FGameplayAbilityTargetData::AddTargetDataToContext(Context, bIncludeActorArray);
+
+	if (FLyraGameplayEffectContext* TypedContext = FLyraGameplayEffectContext::ExtractEffectContext(Context))
+	{
+		TypedContext->CartridgeID = CartridgeID;
+	}
+}
+
+FString FLyraGameplayAbilityTargetData_CartridgeHits::ToString() const
+{
+	return FString::Printf(TEXT("FLyraGameplayAbilityTargetData_CartridgeHits (%d hits)"), HitResults.Num());
+}
+
+bool FLyraGameplayAbilityTargetData_CartridgeHits::NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess)
+{
+	bOutSuccess = true;
+
+	uint32 PackedCartridgeID = (uint32)CartridgeID;
+	Ar.SerializeIntPacked(PackedCartridgeID);
+	CartridgeID = (int32)PackedCartridgeID;
+
+	uint32 NumHits = HitResults.Num();
+	Ar.SerializeIntPacked(NumHits);
+
+	if (NumHits > (uint32)LyraTargetData::MaxCartridgeHits)
+	{
+		Ar.SetError();
+		bOutSuccess = false;
+		return false;
+	}
+
+	HitResults.SetNum(NumHits);
+	HitReplaced.SetNumZeroed(NumHits);
+
+	if (NumHits == 0)
+	{
+		return true;
+	}
+
+	// Every bullet of a cartridge starts at the same place and traces the same distance, only send that once
+	FVector_NetQuantize10 TraceStart(HitResults[0].TraceStart);
+	TraceStart.NetSerialize(Ar, Map, bOutSuccess);
+
+	uint32 TraceLength = Ar.IsSaving() ? (uint32)FMath::RoundToInt((HitResults[0].TraceEnd - HitResults[0].TraceStart).Size()) : 0;
+	Ar.SerializeIntPacked(TraceLength);
+
+	const FVector SharedTraceStart = LyraTargetData::QuantizeLocation(TraceStart);
+	for (uint32 HitIndex = 0; HitIndex < NumHits; ++HitIndex)
+	{
+		bOutSuccess &= LyraTargetData::SerializeCompactHit(Ar, Map, HitResults[HitIndex], HitReplaced[HitIndex], SharedTraceStart, (double)TraceLength);
+	}
+
+	return true;
+}
+
+//////////////////////////////////////////////////////////////////////
+
+#if !UE_BUILD_SHIPPING
+
+FAutoConsoleCommandWithWorldArgsAndOutputDevice GTargetDataBandwidthCmd(
+	TEXT("Lyra.Weapon.TargetDataBandwidth"),
+	TEXT("Usage:\n")
+	TEXT("  Lyra.Weapon.TargetDataBandwidth [NumBullets] [SpreadAngle]\n")
+	TEXT("\n")
+	TEXT("Traces a cartridge of bullets from the local player's view and reports the bytes per shot of each target data format,\n")
+	TEXT("and how far the received impact points end up from the real ones.\n")
+	TEXT("This needs a connection's package map, so run it on a client or on a listen server with a client connected"),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(
+		[](const TArray<FString>& Params, UWorld* World, FOutputDevice& Ar)
+{
+	const int32 NumBullets = FMath::Clamp((Params.Num() > 0) ? FCString::Atoi(*Params[0]) : 10, 1, LyraTargetData::MaxCartridgeHits);
+	const float SpreadAngle = (Params.Num() > 1) ? FCString::Atof(*Params[1]) : 10.0f;
+	const double TraceLength = 25000.0;
+
+	UNetDriver* NetDriver = (World != nullptr) ? World->GetNetDriver() : nullptr;
+	UNetConnection* Connection = (NetDriver == nullptr) ? nullptr : (NetDriver->ServerConnection ? NetDriver->ServerConnection : (NetDriver->ClientConnections.Num() > 0 ? NetDriver->ClientConnections[0] : nullptr));
+	UPackageMap* PackageMap = (Connection != nullptr) ? Connection->PackageMap : nullptr;
+	APlayerController* PC = (World != nullptr) ? World->GetFirstPlayerController() : nullptr;
+
+	if ((PackageMap == nullptr) || (PC == nullptr))
+	{
+		Ar.Logf(ELogVerbosity::Error, TEXT("Lyra.Weapon.TargetDataBandwidth needs a local player and a network connection"));
+		return;
+	}
+
+	FVector ViewLocation;
+	FRotator ViewRotation;
+	PC->GetPlayerViewPoint(/*out*/ ViewLocation, /*out*/ ViewRotation);
+
+	FCollisionQueryParams TraceParams(SCENE_QUERY_STAT(TargetDataBandwidth), /*bTraceComplex=*/ true, /*IgnoreActor=*/ PC->GetPawn());
+	TraceParams.bReturnPhysicalMaterial = true;
+
+	// Fixed seed so runs from the same view are comparable
+	FRandomStream RandomStream(NumBullets);
+
+	FGameplayAbilityTargetDataHandle TargetData;
+	const int32 CartridgeID = FMath::Rand();
+
+	for (int32 BulletIndex = 0; BulletIndex < NumBullets; ++BulletIndex)
+	{
+		const FVector BulletDir = RandomStream.VRandCone(ViewRotation.Vector(), FMath::DegreesToRadians(SpreadAngle * 0.5f));
+		const FVector TraceEnd = ViewLocation + (BulletDir * TraceLength);
+
+		FHitResult Hit;
+		if (!World->LineTraceSingleByChannel(/*out*/ Hit, ViewLocation, TraceEnd, Lyra_TraceChannel_Weapon, TraceParams))
+		{
+			// Misses are sent like ULyraGameplayAbility_RangedWeapon::TraceBulletsInCartridge does
+			Hit = FHitResult();
+			Hit.TraceStart = ViewLocation;
+			Hit.TraceEnd = TraceEnd;
+			Hit.Location = TraceEnd;
+			Hit.ImpactPoint = TraceEnd;
+		}
+
+		FLyraGameplayAbilityTargetData_SingleTargetHit* NewTargetData = new FLyraGameplayAbilityTargetData_SingleTargetHit();
+		NewTargetData->HitResult = Hit;
+		NewTargetData->CartridgeID = CartridgeID;
+		TargetData.Add(NewTargetData);
+	}
+
+	// Sends the target data through the handle like the ability system does, then reads it back to see what the server would get
+	auto MeasureFormat = [&](const TCHAR* FormatName, bool bCompact, bool bBatched)
+	{
+		TGuardValue<bool> CompactGuard(LyraTargetData::bCompactTargetData, bCompact);
+
+		FGameplayAbilityTargetDataHandle SentTargetData;
+		if (bBatched)
+		{
+			FLyraGameplayAbilityTargetData_CartridgeHits::PackCartridges(TargetData, /*out*/ SentTargetData);
+		}
+		else
+		{
+			SentTargetData = TargetData;
+		}
+
+		FNetBitWriter Writer(PackageMap, 1024 * 1024);
+		bool bWriteSuccess = true;
+		SentTargetData.NetSerialize(Writer, PackageMap, bWriteSuccess);
+
+		FNetBitReader Reader(PackageMap, Writer.GetData(), Writer.GetNumBits());
+		FGameplayAbilityTargetDataHandle ReceivedTargetData;
+		bool bReadSuccess = true;
+		ReceivedTargetData.NetSerialize(Reader, PackageMap, bReadSuccess);
+		FLyraGameplayAbilityTargetData_CartridgeHits::UnpackCartridges(ReceivedTargetData);
+
+		double MaxImpactError = 0.0;
+		double MaxTraceEndError = 0.0;
+		for (int32 Index = 0; (Index < TargetData.Num()) && (Index < ReceivedTargetData.Num()); ++Index)
+		{
+			const FHitResult* SentHit = TargetData.Get(Index)->GetHitResult();
+			const FHitResult* ReceivedHit = ReceivedTargetData.Get(Index)->GetHitResult();
+			if ((SentHit != nullptr) && (ReceivedHit != nullptr))
+			{
+				MaxImpactError = FMath::Max(MaxImpactError, FVector::Dist(SentHit->ImpactPoint, ReceivedHit->ImpactPoint));
+				MaxTraceEndError = FMath::Max(MaxTraceEndError, FVector::Dist(SentHit->TraceEnd, ReceivedHit->TraceEnd));
+			}
+		}
+
+		const bool bRoundTripped = bWriteSuccess && bReadSuccess && !Writer.IsError() && !Reader.IsError() && (ReceivedTargetData.Num() == TargetData.Num());
+
+		Ar.Logf(TEXT("  %-8s %5lld bits, %4lld bytes per shot, %5.1f bytes per bullet, max impact error %.2f, max trace end error %.2f%s"),
+			FormatName, Writer.GetNumBits(), Writer.GetNumBytes(), (double)Writer.GetNumBytes() / NumBullets, MaxImpactError, MaxTraceEndError,
+			bRoundTripped ? TEXT("") : TEXT(" (FAILED TO ROUND TRIP)"));
+	};
+
+	Ar.Logf(TEXT("Target data for a cartridge of %d bullets with a %.1f degree spread:"), NumBullets, SpreadAngle);
+	MeasureFormat(TEXT("Full"), /*bCompact=*/ false, /*bBatched=*/ false);
+	MeasureFormat(TEXT("Compact"), /*bCompact=*/ true, /*bBatched=*/ false);
+	MeasureFormat(TEXT("Batched"), /*bCompact=*/ true, /*bBatched=*/ true);
+}));
+
+#endif // !UE_BUILD_SHIPPING
@@ -23,8 +23,15 @@ struct FLyraGameplayAbilityTargetData_SingleTargetHit : public FGameplayAbilityT
 	UPROPERTY()
 	int32 CartridgeID;
 
+	/** Writes a leading bit saying which format follows, so the receiver doesn't need to agree with the sender about lyra.Weapon.CompactTargetData */
 	bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
 
+	/** The original format, the full hit result followed by the cartridge ID */
+	bool NetSerializeFull(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+
+	/** Only the parts of the hit result the weapon code uses, with locations quantized relative to the start of the trace */
+	bool NetSerializeCompact(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+
 	virtual UScriptStruct* GetScriptStruct() const override
 	{
 		return FLyraGameplayAbilityTargetData_SingleTargetHit::StaticStruct();
@@ -40,3 +47,59 @@ struct TStructOpsTypeTraits<FLyraGameplayAbilityTargetData_SingleTargetHit> : pu
 	};
 };
 
+
+/**
+ * Every bullet of one cartridge packed into a single target data entry, so the trace start and length are only sent once per shot.
+ * This is only a wire format, the server unpacks it back into FLyraGameplayAbilityTargetData_SingleTargetHit entries before using it.
+ */
+USTRUCT()
+struct FLyraGameplayAbilityTargetData_CartridgeHits : public FGameplayAbilityTargetData
+{
+	GENERATED_BODY()
+
+	FLyraGameplayAbilityTargetData_CartridgeHits()
+		: CartridgeID(-1)
+	{ }
+
+	/** Replaces runs of single target hits from the same cartridge with one packed entry each, other entries are shared as-is */
+	static void PackCartridges(const FGameplayAbilityTargetDataHandle& TargetData, FGameplayAbilityTargetDataHandle& OutPackedTargetData);
+
+	/** Expands any packed cartridges back into one single target hit per bullet, in their original order */
+	static void UnpackCartridges(FGameplayAbilityTargetDataHandle& InOutTargetData);
+
+	//~FGameplayAbilityTargetData interface
+	virtual TArray<TWeakObjectPtr<AActor>> GetActors() const override;
+	virtual bool HasOrigin() const override { return HitResults.Num() > 0; }
+	virtual FTransform GetOrigin() const override;
+	virtual void AddTargetDataToContext(FGameplayEffectContextHandle& Context, bool bIncludeActorArray) const override;
+	virtual FString ToString() const override;
+	//~End of FGameplayAbilityTargetData interface
+
+	/** One hit per bullet, all sharing a trace start */
+	UPROPERTY()
+	TArray<FHitResult> HitResults;
+
+	/** Parallel to HitResults, see FGameplayAbilityTargetData_SingleTargetHit::bHitReplaced */
+	UPROPERTY()
+	TArray<bool> HitReplaced;
+
+	/** ID to allow the identification of multiple bullets that were part of the same cartridge */
+	UPROPERTY()
+	int32 CartridgeID;
+
+	bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+
+	virtual UScriptStruct* GetScriptStruct() const override
+	{
+		return FLyraGameplayAbilityTargetData_CartridgeHits::StaticStruct();
+	}
+};
+
+template<>
+struct TStructOpsTypeTraits<FLyraGameplayAbilityTargetData_CartridgeHits> : public TStructOpsTypeTraitsBase2<FLyraGameplayAbilityTargetData_CartridgeHits>
+{
+	enum
+	{
+		WithNetSerializer = true	// For now this is REQUIRED for FGameplayAbilityTargetDataHandle net serialization to work
+	};
+};
@@ -9,6 +9,15 @@
 #include "UObject/UObjectThreadContext.h"
 #include "System/LyraAssetManager.h"
 #include "Async/Async.h"
+#include "GameplayEffect.h"
+#include "Abilities/GameplayAbility.h"
+#include "Engine/DataAsset.h"
+#include "GameFeatureAction.h"
+#include "GameModes/LyraExperienceDefinition.h"
+#include "Equipment/LyraEquipmentDefinition.h"
+#include "Equipment/LyraEquipmentInstance.h"
+#include "Inventory/LyraInventoryItemDefinition.h"
+#include "UObject/UObjectHash.h"
 
 //////////////////////////////////////////////////////////////////////
 
@@ -30,10 +39,46 @@ namespace LyraGameplayCueManagerCvars
 {
 	static FAutoConsoleCommand CVarDumpGameplayCues(
 		TEXT("Lyra.DumpGameplayCues"),
-		TEXT("Shows all assets that were loaded via LyraGameplayCueManager and are currently in memory."),
+		TEXT("Shows all assets that were loaded via LyraGameplayCueManager and are currently in memory, and the cue misses so far. Usage: Lyra.DumpGameplayCues [Refs] [ResetMisses]"),
 		FConsoleCommandWithArgsDelegate::CreateStatic(ULyraGameplayCueManager::DumpGameplayCues));
 
 	static ELyraEditorLoadMode LoadMode = ELyraEditorLoadMode::LoadUpfront;
+
+	static bool bPreloadCuesForExperience = true;
+	static FAutoConsoleVariableRef CVarPreloadCuesForExperience(
+		TEXT("Lyra.GameplayCues.PreloadForExperience"),
+		bPreloadCuesForExperience,
+		TEXT("When cues are preloaded as they are referenced, should the cues the experience's abilities, equipment and effects can trigger be preloaded when it loads"),
+		ECVF_Default);
+
+	static int32 MaxPreloadSearchDepth = 8;
+	static FAutoConsoleVariableRef CVarMaxPreloadSearchDepth(
+		TEXT("Lyra.GameplayCues.PreloadSearchDepth"),
+		MaxPreloadSearchDepth,
+		TEXT("How many references away from the experience to look for gameplay cue tags to preload"),
+		ECVF_Default);
+
+	// Returns true if cues are preloaded as they are referenced (ProcessTagToPreload does nothing otherwise)
+	static bool ShouldPreloadCuesAsReferenced()
+	{
+		switch (LoadMode)
+		{
+		case ELyraEditorLoadMode::LoadUpfront:
+			return false;
+		case ELyraEditorLoadMode::PreloadAsCuesAreReferenced_GameOnly:
+#if WITH_EDITOR
+			if (GIsEditor)
+			{
+				return false;
+			}
+#endif
+			break;
+		case ELyraEditorLoadMode::PreloadAsCuesAreReferenced:
+			break;
+		}
+
+		return true;
+	}
 }
 
 const bool bPreloadEvenInEditor = true;
@@ -50,6 +95,133 @@ struct FGameplayCueTagThreadSynchronizeGraphTask : public FAsyncGraphTaskBase
 
 //////////////////////////////////////////////////////////////////////
 
+// Walks the properties of gameplay data reachable from an experience, collecting the cue tags it contains and how far from the experience each was found
+// Only follows references to objects that are already loaded, and only into the kinds of objects that carry gameplay data (not actors, meshes, etc...)
+struct FLyraGameplayCuePreloadPlanner
+{
+	FLyraGameplayCuePreloadPlanner(const UGameplayCueSet& InCueSet, int32 InMaxDepth)
+		: CueSet(InCueSet)
+		, MaxDepth(InMaxDepth)
+		, CueRootTag(FGameplayTag::RequestGameplayTag(TEXT("GameplayCue"), /*ErrorIfNotFound=*/ false))
+	{
+	}
+
+	void VisitObject(const UObject* Object, int32 Depth)
+	{
+		if (const UClass* Class = Cast<UClass>(Object))
+		{
+			Object = Class->GetDefaultObject();
+		}
+
+		if ((Object == nullptr) || (Depth > MaxDepth) || !ShouldVisit(Object))
+		{
+			return;
+		}
+
+		// Revisit if this path is shorter, so each cue gets the depth of its closest referencer
+		int32& VisitedDepth = VisitedObjects.FindOrAdd(Object, MAX_int32);
+		if (VisitedDepth <= Depth)
+		{
+			return;
+		}
+		VisitedDepth = Depth;
+
+		VisitStruct(Object->GetClass(), Object, Depth);
+	}
+
+	// Cue tags in order of how close to the experience they were found
+	void GetCueTagsInPriorityOrder(TArray<TPair<FGameplayTag, int32>>& OutCueTags) const
+	{
+		for (const auto& KVP : CueTagDepths)
+		{
+			OutCueTags.Emplace(KVP.Key, KVP.Value);
+		}
+		OutCueTags.StableSort([](const TPair<FGameplayTag, int32>& A, const TPair<FGameplayTag, int32>& B) { return A.Value < B.Value; });
+	}
+
+private:
+	static bool ShouldVisit(const UObject* Object)
+	{
+		return Object->IsA<UDataAsset>() || Object->IsA<UGameFeatureAction>() || Object->IsA<UGameplayAbility>() || Object->IsA<UGameplayEffect>() ||
+			Object->IsA<ULyraEquipmentDefinition>() || Object->IsA<ULyraEquipmentInstance>() || Object->IsA<ULyraInventoryItemDefinition>() || Object->IsA<ULyraInventoryItemFragment>();
+	}
+
+	void VisitStruct(const UStruct* Struct, const void* Container, int32 Depth)
+	{
+		for (TFieldIterator<FProperty> PropIt(Struct); PropIt; ++PropIt)
+		{
+			for (int32 ArrayIndex = 0; ArrayIndex < PropIt->ArrayDim; ++ArrayIndex)
+			{
+				VisitValue(*PropIt, PropIt->ContainerPtrToValuePtr<void>(Container, ArrayIndex), Depth);
+			}
+		}
+	}
+
+	void VisitValue(const FProperty* Property, const void* Value, int32 Depth)
+	{
+		if (const FStructProperty* StructProperty = CastField<FStructProperty>(Property))
+		{
+			if (StructProperty->Struct == FGameplayTag::StaticStruct())
+			{
+				AddTag(*static_cast<const FGameplayTag*>(Value), Depth);
+			}
+			else if (StructProperty->Struct == FGameplayTagContainer::StaticStruct())
+			{
+				for (const FGameplayTag& Tag : *static_cast<const FGameplayTagContainer*>(Value))
+				{
+					AddTag(Tag, Depth);
+				}
+			}
+			else
+			{
+				VisitStruct(StructProperty->Struct, Value, Depth);
+			}
+		}
+		else if (const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Property))
+		{
+			FScriptArrayHelper ArrayHelper(ArrayProperty, Value);
+			for (int32 Index = 0; Index < ArrayHelper.Num(); ++Index)
+			{
+				VisitValue(ArrayProperty->Inner, ArrayHelper.GetRawPtr(Index), Depth);
+			}
+		}
+		else if (const FObjectPropertyBase* ObjectProperty = CastField<FObjectPropertyBase>(Property))
+		{
+			// Soft references resolve to null if they aren't loaded, we don't want to load anything here
+			VisitObject(ObjectProperty->GetObjectPropertyValue(Value), Depth + 1);
+		}
+	}
+
+	void AddTag(const FGameplayTag& Tag, int32 Depth)
+	{
+		if (!Tag.IsValid() || !Tag.MatchesTag(CueRootTag))
+		{
+			return;
+		}
+
+		// Cues without their own notify are handled by the closest parent that has one
+		for (FGameplayTag CueTag = Tag; CueTag.IsValid(); CueTag = CueTag.RequestDirectParent())
+		{
+			if (CueSet.GameplayCueDataMap.Contains(CueTag))
+			{
+				int32& CueDepth = CueTagDepths.FindOrAdd(CueTag, MAX_int32);
+				CueDepth = FMath::Min(CueDepth, Depth);
+				break;
+			}
+		}
+	}
+
+private:
+	const UGameplayCueSet& CueSet;
+	const int32 MaxDepth;
+	const FGameplayTag CueRootTag;
+
+	TMap<const UObject*, int32> VisitedObjects;
+	TMap<FGameplayTag, int32> CueTagDepths;
+};
+
+//////////////////////////////////////////////////////////////////////
+
 ULyraGameplayCueManager::ULyraGameplayCueManager(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
@@ -122,6 +294,65 @@ bool ULyraGameplayCueManager::ShouldAsyncLoadMissingGameplayCues() const
 	return true;
 }
 
+bool ULyraGameplayCueManager::HandleMissingGameplayCue(UGameplayCueSet* OwningSet, struct FGameplayCueNotifyData& CueData, AActor* TargetActor, EGameplayCueEvent::Type EventType, FGameplayCueParameters& Parameters)
+{
+	// Only count each invocation once, the WhileActive/OnActive/Executed events of one cue all come through here
+	if ((EventType == EGameplayCueEvent::OnActive) || (EventType == EGameplayCueEvent::Executed))
+	{
+		++NumCueMisses;
+		++CueMissCounts.FindOrAdd(CueData.GameplayCueTag);
+	}
+
+	return Super::HandleMissingGameplayCue(OwningSet, CueData, TargetActor, EventType, Parameters);
+}
+
+void ULyraGameplayCueManager::PreloadCuesForExperience(const ULyraExperienceDefinition* Experience)
+{
+	// Walking the experience is only worth it if the cues it finds will actually be preloaded
+	if (!LyraGameplayCueManagerCvars::bPreloadCuesForExperience || !LyraGameplayCueManagerCvars::ShouldPreloadCuesAsReferenced() || (Experience == nullptr) || !ShouldDelayLoadGameplayCues() || (RuntimeGameplayCueObjectLibrary.CueSet == nullptr))
+	{
+		PlannedCueTags.Reset();
+		return;
+	}
+
+	TRACE_CPUPROFILER_EVENT_SCOPE(ULyraGameplayCueManager::PreloadCuesForExperience);
+	const double StartTime = FPlatformTime::Seconds();
+
+	const int32 MaxDepth = FMath::Max(LyraGameplayCueManagerCvars::MaxPreloadSearchDepth, 1);
+	FLyraGameplayCuePreloadPlanner Planner(*RuntimeGameplayCueObjectLibrary.CueSet, MaxDepth);
+
+	// The experience reaches its pawn data, ability sets and actions
+	Planner.VisitObject(Experience, 0);
+
+	// Equipment is mostly granted by content the planner can't follow (spawners, pickups, blueprint logic), but whatever the experience
+	// bundles brought in is loaded now, so start from the loaded item and equipment definitions as well
+	TArray<UClass*> LoadedDefinitionClasses;
+	GetDerivedClasses(ULyraInventoryItemDefinition::StaticClass(), LoadedDefinitionClasses);
+	GetDerivedClasses(ULyraEquipmentDefinition::StaticClass(), LoadedDefinitionClasses);
+	for (UClass* DefinitionClass : LoadedDefinitionClasses)
+	{
+		if (!DefinitionClass->HasAnyClassFlags(CLASS_Abstract | CLASS_Deprecated | CLASS_NewerVersionExists))
+		{
+			Planner.VisitObject(DefinitionClass, 1);
+		}
+	}
+
+	TArray<TPair<FGameplayTag, int32>> CueTags;
+	Planner.GetCueTagsInPriorityOrder(CueTags);
+
+	PlannedCueTags.Reset();
+	for (const TPair<FGameplayTag, int32>& CueTag : CueTags)
+	{
+		PlannedCueTags.Add(CueTag.Key);
+
+		// The experience stays loaded for as long as it is in use, so it owns these preloads
+		const TAsyncLoadPriority Priority = FStreamableManager::DefaultAsyncLoadPriority + (MaxDepth - CueTag.Value);
+		ProcessTagToPreload(CueTag.Key, const_cast<ULyraExperienceDefinition*>(Experience), Priority);
+	}
+
+	UE_LOG(LogLyra, Log, TEXT("Preloading %d gameplay cues for experience %s (planned in %.2f ms)"), CueTags.Num(), *GetNameSafe(Experience), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+}
+
 void ULyraGameplayCueManager::DumpGameplayCues(const TArray<FString>& Args)
 {
 	ULyraGameplayCueManager* GCM = Cast<ULyraGameplayCueManager>(UAbilitySystemGlobals::Get().GetGameplayCueManager());
@@ -174,6 +405,24 @@ void ULyraGameplayCueManager::DumpGameplayCues(const TArray<FString>& Args)
 	UE_LOG(LogLyra, Log, TEXT("  ... %d cues in preloaded list"), GCM->PreloadedCues.Num());
 	UE_LOG(LogLyra, Log, TEXT("  ... %d cues loaded on demand"), NumMissingCuesLoaded);
 	UE_LOG(LogLyra, Log, TEXT("  ... %d cues in total"), GCM->AlwaysLoadedCues.Num() + GCM->PreloadedCues.Num() + NumMissingCuesLoaded);
+
+	// A miss is a cue that was invoked before it was loaded, planned misses were found by PreloadCuesForExperience but hadn't finished loading yet
+	UE_LOG(LogLyra, Log, TEXT("=========== Gameplay Cue misses ==========="));
+	int32 NumPlannedMissedCues = 0;
+	for (const auto& KVP : GCM->CueMissCounts)
+	{
+		const bool bPlanned = GCM->PlannedCueTags.Contains(KVP.Key);
+		NumPlannedMissedCues += bPlanned ? 1 : 0;
+		UE_LOG(LogLyra, Log, TEXT("  %s: %d misses%s"), *KVP.Key.ToString(), KVP.Value, bPlanned ? TEXT(" (planned)") : TEXT(""));
+	}
+	UE_LOG(LogLyra, Log, TEXT("  ... %d cue misses across %d cues (%d of them planned)"), GCM->NumCueMisses, GCM->CueMissCounts.Num(), NumPlannedMissedCues);
+	UE_LOG(LogLyra, Log, TEXT("  ... %d cues planned for the current experience"), GCM->PlannedCueTags.Num());
+
+	if (Args.Contains(TEXT("ResetMisses")))
+	{
+		GCM->CueMissCounts.Reset();
+		GCM->NumCueMisses = 0;
+	}
 }
 
 void ULyraGameplayCueManager::OnGameplayTagLoaded(const FGameplayTag& Tag)
@@ -248,22 +497,11 @@ void ULyraGameplayCueManager::ProcessLoadedTags()
 	}
 }
 
-void ULyraGameplayCueManager::ProcessTagToPreload(const FGameplayTag& Tag, UObject* OwningObject)
+void ULyraGameplayCueManager::ProcessTagToPreload(const FGameplayTag& Tag, UObject* OwningObject, TAsyncLoadPriority Priority)
 {
-	switch (LyraGameplayCueManagerCvars::LoadMode)
+	if (!LyraGameplayCueManagerCvars::ShouldPreloadCuesAsReferenced())
 	{
-	case ELyraEditorLoadMode::LoadUpfront:
 		return;
-	case ELyraEditorLoadMode::PreloadAsCuesAreReferenced_GameOnly:
-#if WITH_EDITOR
-		if (GIsEditor)
-		{
-			return;
-		}
-#endif
-		break;
-	case ELyraEditorLoadMode::PreloadAsCuesAreReferenced:
-		break;
 	}
 
 	check(RuntimeGameplayCueObjectLibrary.CueSet);
@@ -282,7 +520,7 @@ void ULyraGameplayCueManager::ProcessTagToPreload(const FGameplayTag& Tag, UObje
 		{
 			bool bAlwaysLoadedCue = OwningObject == nullptr;
 			TWeakObjectPtr<UObject> WeakOwner = OwningObject;
-			StreamableManager.RequestAsyncLoad(CueData.GameplayCueNotifyObj, FStreamableDelegate::CreateUObject(this, &ThisClass::OnPreloadCueComplete, CueData.GameplayCueNotifyObj, WeakOwner, bAlwaysLoadedCue), FStreamableManager::DefaultAsyncLoadPriority, false, false, TEXT("GameplayCueManager"));
+			StreamableManager.RequestAsyncLoad(CueData.GameplayCueNotifyObj, FStreamableDelegate::CreateUObject(this, &ThisClass::OnPreloadCueComplete, CueData.GameplayCueNotifyObj, WeakOwner, bAlwaysLoadedCue), Priority, false, false, TEXT("GameplayCueManager"));
 		}
 	}
 }
@@ -7,6 +7,8 @@
 
 #include "LyraGameplayCueManager.generated.h"
 
+class ULyraExperienceDefinition;
+
 /**
  * ULyraGameplayCueManager
  *
@@ -28,6 +30,7 @@ public:
 	virtual bool ShouldAsyncLoadRuntimeObjectLibraries() const override;
 	virtual bool ShouldSyncLoadMissingGameplayCues() const override;
 	virtual bool ShouldAsyncLoadMissingGameplayCues() const override;
+	virtual bool HandleMissingGameplayCue(UGameplayCueSet* OwningSet, struct FGameplayCueNotifyData& CueData, AActor* TargetActor, EGameplayCueEvent::Type EventType, FGameplayCueParameters& Parameters) override;
 	//~End of UGameplayCueManager interface
 
 	static void DumpGameplayCues(const TArray<FString>& Args);
@@ -40,11 +43,15 @@ public:
 	// 更新单一的游戏 cues 主要资产的包
 	void RefreshGameplayCuePrimaryAsset();
 
+	// Finds the cue tags the experience's pawn data, ability sets, equipment and gameplay effects can trigger and preloads those cues,
+	// closest to the experience first, so they are ready before their first use instead of being loaded on demand
+	void PreloadCuesForExperience(const ULyraExperienceDefinition* Experience);
+
 private:
 	void OnGameplayTagLoaded(const FGameplayTag& Tag);
 	void HandlePostGarbageCollect();
 	void ProcessLoadedTags();
-	void ProcessTagToPreload(const FGameplayTag& Tag, UObject* OwningObject);
+	void ProcessTagToPreload(const FGameplayTag& Tag, UObject* OwningObject, TAsyncLoadPriority Priority = FStreamableManager::DefaultAsyncLoadPriority);
 	void OnPreloadCueComplete(FSoftObjectPath Path, TWeakObjectPtr<UObject> OwningObject, bool bAlwaysLoadedCue);
 	void RegisterPreloadedCue(UClass* LoadedGameplayCueClass, UObject* OwningObject);
 	void HandlePostLoadMap(UWorld* NewWorld);
@@ -76,4 +83,11 @@ private:
 	TArray<FLoadedGameplayTagToProcessData> LoadedGameplayTagsToProcess;
 	FCriticalSection LoadedGameplayTagsToProcessCS;
 	bool bProcessLoadedTagsAfterGC = false;
+
+	// Cue tags the last call to PreloadCuesForExperience found
+	TSet<FGameplayTag> PlannedCueTags;
+
+	// How many times each cue was invoked before it was loaded (cue misses), see DumpGameplayCues
+	TMap<FGameplayTag, int32> CueMissCounts;
+	int32 NumCueMisses = 0;
 };
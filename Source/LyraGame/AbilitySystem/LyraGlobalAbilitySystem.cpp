@@ -3,36 +3,61 @@
 #include "LyraGlobalAbilitySystem.h"
 #include "Net/UnrealNetwork.h"
 #include "AbilitySystem/LyraAbilitySystemComponent.h"
+#include "GameModes/LyraGameState.h"
+#include "GameplayEffect.h"
+#include "GameplayEffectAggregator.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "TimerManager.h"
 
-void FGlobalAppliedAbilityList::AddToASC(TSubclassOf<UGameplayAbility> Ability, ULyraAbilitySystemComponent* ASC)
+namespace LyraGlobalAbilitySystemCVars
 {
-	if (FGameplayAbilitySpecHandle* SpecHandle = Handles.Find(ASC))
-	{
-		RemoveFromASC(ASC);
-	}
+	static bool bBatchedApply = true;
+	static FAutoConsoleVariableRef CVarBatchedApply(
+		TEXT("lyra.GlobalAbilitySystem.BatchedApply"),
+		bBatchedApply,
+		TEXT("If true, ApplyEffectToAll builds one spec (sourced from the game state) for every ASC and batches the attribute updates, instead of making a spec per ASC with the ASC as its own source"),
+		ECVF_Default);
+
+	static bool bDeferLateJoiners = true;
+	static FAutoConsoleVariableRef CVarDeferLateJoiners(
+		TEXT("lyra.GlobalAbilitySystem.DeferLateJoiners"),
+		bDeferLateJoiners,
+		TEXT("If true, ASCs that register while global abilities or effects are active get them on the next tick, together with any others registering that frame"),
+		ECVF_Default);
+}
+
+void FGlobalAppliedAbilityList::AddToASC(TSubclassOf<UGameplayAbility> Ability, ULyraAbilitySystemComponent* ASC, int32 Slot)
+{
+	RemoveFromASC(ASC, Slot);
 
 	UGameplayAbility* AbilityCDO = Ability->GetDefaultObject<UGameplayAbility>();
 	FGameplayAbilitySpec AbilitySpec(AbilityCDO);
 	const FGameplayAbilitySpecHandle AbilitySpecHandle = ASC->GiveAbility(AbilitySpec);
-	Handles.Add(ASC, AbilitySpecHandle);
+
+	if (!Handles.IsValidIndex(Slot))
+	{
+		Handles.SetNum(Slot + 1);
+	}
+	Handles[Slot] = AbilitySpecHandle;
 }
 
-void FGlobalAppliedAbilityList::RemoveFromASC(ULyraAbilitySystemComponent* ASC)
+void FGlobalAppliedAbilityList::RemoveFromASC(ULyraAbilitySystemComponent* ASC, int32 Slot)
 {
-	if (FGameplayAbilitySpecHandle* SpecHandle = Handles.Find(ASC))
+	if (Handles.IsValidIndex(Slot) && Handles[Slot].IsValid())
 	{
-		ASC->ClearAbility(*SpecHandle);
-		Handles.Remove(ASC);
+		ASC->ClearAbility(Handles[Slot]);
+		Handles[Slot] = FGameplayAbilitySpecHandle();
 	}
 }
 
-void FGlobalAppliedAbilityList::RemoveFromAll()
+void FGlobalAppliedAbilityList::RemoveFromAll(TArrayView<ULyraAbilitySystemComponent* const> ASCs)
 {
-	for (auto& KVP : Handles)
+	for (int32 Slot = 0; Slot < Handles.Num(); ++Slot)
 	{
-		if (KVP.Key != nullptr)
+		if (Handles[Slot].IsValid() && ASCs.IsValidIndex(Slot) && (ASCs[Slot] != nullptr))
 		{
-			KVP.Key->ClearAbility(KVP.Value);
+			ASCs[Slot]->ClearAbility(Handles[Slot]);
 		}
 	}
 	Handles.Empty();
@@ -40,37 +65,48 @@ void FGlobalAppliedAbilityList::RemoveFromAll()
 
 
 
-void FGlobalAppliedEffectList::AddToASC(TSubclassOf<UGameplayEffect> Effect, ULyraAbilitySystemComponent* ASC)
+void FGlobalAppliedEffectList::AddToASC(TSubclassOf<UGameplayEffect> Effect, ULyraAbilitySystemComponent* ASC, int32 Slot)
 {
-	if (FActiveGameplayEffectHandle* EffectHandle = Handles.Find(ASC))
+	RemoveFromASC(ASC, Slot);
+
+	FActiveGameplayEffectHandle GameplayEffectHandle;
+	if (SharedSpec.IsValid())
 	{
-		RemoveFromASC(ASC);
+		GameplayEffectHandle = ASC->ApplyGameplayEffectSpecToSelf(*SharedSpec.Data.Get());
+	}
+	else
+	{
+		const UGameplayEffect* GameplayEffectCDO = Effect->GetDefaultObject<UGameplayEffect>();
+		GameplayEffectHandle = ASC->ApplyGameplayEffectToSelf(GameplayEffectCDO, /*Level=*/ 1, ASC->MakeEffectContext());
 	}
 
-	const UGameplayEffect* GameplayEffectCDO = Effect->GetDefaultObject<UGameplayEffect>();
-	const FActiveGameplayEffectHandle GameplayEffectHandle = ASC->ApplyGameplayEffectToSelf(GameplayEffectCDO, /*Level=*/ 1, ASC->MakeEffectContext());
-	Handles.Add(ASC, GameplayEffectHandle);
+	if (!Handles.IsValidIndex(Slot))
+	{
+		Handles.SetNum(Slot + 1);
+	}
+	Handles[Slot] = GameplayEffectHandle;
 }
 
-void FGlobalAppliedEffectList::RemoveFromASC(ULyraAbilitySystemComponent* ASC)
+void FGlobalAppliedEffectList::RemoveFromASC(ULyraAbilitySystemComponent* ASC, int32 Slot)
 {
-	if (FActiveGameplayEffectHandle* EffectHandle = Handles.Find(ASC))
+	if (Handles.IsValidIndex(Slot) && Handles[Slot].IsValid())
 	{
-		ASC->RemoveActiveGameplayEffect(*EffectHandle);
-		Handles.Remove(ASC);
+		ASC->RemoveActiveGameplayEffect(Handles[Slot]);
+		Handles[Slot] = FActiveGameplayEffectHandle();
 	}
 }
 
-void FGlobalAppliedEffectList::RemoveFromAll()
+void FGlobalAppliedEffectList::RemoveFromAll(TArrayView<ULyraAbilitySystemComponent* const> ASCs)
 {
-	for (auto& KVP : Handles)
+	for (int32 Slot = 0; Slot < Handles.Num(); ++Slot)
 	{
-		if (KVP.Key != nullptr)
+		if (Handles[Slot].IsValid() && ASCs.IsValidIndex(Slot) && (ASCs[Slot] != nullptr))
 		{
-			KVP.Key->RemoveActiveGameplayEffect(KVP.Value);
+			ASCs[Slot]->RemoveActiveGameplayEffect(Handles[Slot]);
 		}
 	}
 	Handles.Empty();
+	SharedSpec.Clear();
 }
 
 ULyraGlobalAbilitySystem::ULyraGlobalAbilitySystem()
@@ -81,10 +117,17 @@ void ULyraGlobalAbilitySystem::ApplyAbilityToAll(TSubclassOf<UGameplayAbility> A
 {
 	if ((Ability.Get() != nullptr) && (!AppliedAbilities.Contains(Ability)))
 	{
-		FGlobalAppliedAbilityList& Entry = AppliedAbilities.Add(Ability);		
-		for (ULyraAbilitySystemComponent* ASC : RegisteredASCs)
+		// Anyone still waiting gets the existing globals first, so everyone ends up with them in the same order
+		ApplyGlobalsToPendingASCs();
+
+		FGlobalAppliedAbilityList& Entry = AppliedAbilities.Add(Ability);
+		Entry.Handles.SetNum(RegisteredASCs.Num());
+		for (int32 Slot = 0; Slot < RegisteredASCs.Num(); ++Slot)
 		{
-			Entry.AddToASC(Ability, ASC);
+			if (ULyraAbilitySystemComponent* ASC = RegisteredASCs[Slot])
+			{
+				Entry.AddToASC(Ability, ASC, Slot);
+			}
 		}
 	}
 }
@@ -93,10 +136,29 @@ void ULyraGlobalAbilitySystem::ApplyEffectToAll(TSubclassOf<UGameplayEffect> Eff
 {
 	if ((Effect.Get() != nullptr) && (!AppliedEffects.Contains(Effect)))
 	{
+		ApplyGlobalsToPendingASCs();
+
 		FGlobalAppliedEffectList& Entry = AppliedEffects.Add(Effect);
-		for (ULyraAbilitySystemComponent* ASC : RegisteredASCs)
+		Entry.Handles.SetNum(RegisteredASCs.Num());
+
+		if (LyraGlobalAbilitySystemCVars::bBatchedApply)
 		{
-			Entry.AddToASC(Effect, ASC);
+			Entry.SharedSpec = MakeSharedEffectSpec(Effect);
+		}
+
+		// Attribute aggregators only broadcast their changes once everyone has the effect
+		TOptional<FScopedAggregatorOnDirtyBatch> AggregatorOnDirtyBatch;
+		if (LyraGlobalAbilitySystemCVars::bBatchedApply)
+		{
+			AggregatorOnDirtyBatch.Emplace();
+		}
+
+		for (int32 Slot = 0; Slot < RegisteredASCs.Num(); ++Slot)
+		{
+			if (ULyraAbilitySystemComponent* ASC = RegisteredASCs[Slot])
+			{
+				Entry.AddToASC(Effect, ASC, Slot);
+			}
 		}
 	}
 }
@@ -106,7 +168,7 @@ void ULyraGlobalAbilitySystem::RemoveAbilityFromAll(TSubclassOf<UGameplayAbility
 	if ((Ability.Get() != nullptr) && AppliedAbilities.Contains(Ability))
 	{
 		FGlobalAppliedAbilityList& Entry = AppliedAbilities[Ability];
-		Entry.RemoveFromAll();
+		Entry.RemoveFromAll(RegisteredASCs);
 		AppliedAbilities.Remove(Ability);
 	}
 }
@@ -115,8 +177,14 @@ void ULyraGlobalAbilitySystem::RemoveEffectFromAll(TSubclassOf<UGameplayEffect>
 {
 	if ((Effect.Get() != nullptr) && AppliedEffects.Contains(Effect))
 	{
+		TOptional<FScopedAggregatorOnDirtyBatch> AggregatorOnDirtyBatch;
+		if (LyraGlobalAbilitySystemCVars::bBatchedApply)
+		{
+			AggregatorOnDirtyBatch.Emplace();
+		}
+
 		FGlobalAppliedEffectList& Entry = AppliedEffects[Effect];
-		Entry.RemoveFromAll();
+		Entry.RemoveFromAll(RegisteredASCs);
 		AppliedEffects.Remove(Effect);
 	}
 }
@@ -125,29 +193,223 @@ void ULyraGlobalAbilitySystem::RegisterASC(ULyraAbilitySystemComponent* ASC)
 {
 	check(ASC);
 
-	for (auto& Entry : AppliedAbilities)
+	// ASCs register again when they get a new pawn avatar, they keep their slot and have the globals reapplied
+	int32 Slot = RegisteredASCs.Find(ASC);
+	if (Slot == INDEX_NONE)
 	{
-		Entry.Value.AddToASC(Entry.Key, ASC);
+		Slot = (FreeASCSlots.Num() > 0) ? FreeASCSlots.Pop(/*bAllowShrinking=*/ false) : RegisteredASCs.AddDefaulted();
+		RegisteredASCs[Slot] = ASC;
 	}
-	for (auto& Entry : AppliedEffects)
+
+	if ((AppliedAbilities.Num() == 0) && (AppliedEffects.Num() == 0))
 	{
-		Entry.Value.AddToASC(Entry.Key, ASC);
+		return;
 	}
 
-	RegisteredASCs.AddUnique(ASC);
+	const bool bFlushScheduled = (PendingASCSlots.Num() > 0);
+	PendingASCSlots.AddUnique(Slot);
+
+	if (!LyraGlobalAbilitySystemCVars::bDeferLateJoiners)
+	{
+		ApplyGlobalsToPendingASCs();
+	}
+	else if (!bFlushScheduled)
+	{
+		GetWorld()->GetTimerManager().SetTimerForNextTick(FTimerDelegate::CreateUObject(this, &ThisClass::ApplyGlobalsToPendingASCs));
+	}
 }
 
 void ULyraGlobalAbilitySystem::UnregisterASC(ULyraAbilitySystemComponent* ASC)
 {
 	check(ASC);
+
+	const int32 Slot = RegisteredASCs.Find(ASC);
+	if (Slot == INDEX_NONE)
+	{
+		return;
+	}
+
 	for (auto& Entry : AppliedAbilities)
 	{
-		Entry.Value.RemoveFromASC(ASC);
+		Entry.Value.RemoveFromASC(ASC, Slot);
 	}
 	for (auto& Entry : AppliedEffects)
 	{
-		Entry.Value.RemoveFromASC(ASC);
+		Entry.Value.RemoveFromASC(ASC, Slot);
+	}
+
+	PendingASCSlots.Remove(Slot);
+	RegisteredASCs[Slot] = nullptr;
+	FreeASCSlots.Add(Slot);
+}
+
+FGameplayEffectSpecHandle ULyraGlobalAbilitySystem::MakeSharedEffectSpec(TSubclassOf<UGameplayEffect> Effect) const
+{
+	// Global effects don't have a natural instigator, so the game-wide ASC is the source for all of them
+	// (without one, each ASC gets its own spec with itself as the source like before)
+	const ALyraGameState* GameState = GetWorld()->GetGameState<ALyraGameState>();
+	ULyraAbilitySystemComponent* SourceASC = (GameState != nullptr) ? GameState->GetLyraAbilitySystemComponent() : nullptr;
+	if (SourceASC == nullptr)
+	{
+		return FGameplayEffectSpecHandle();
+	}
+
+	return SourceASC->MakeOutgoingSpec(Effect, /*Level=*/ 1.0f, SourceASC->MakeEffectContext());
+}
+
+void ULyraGlobalAbilitySystem::ApplyGlobalsToPendingASCs()
+{
+	if (PendingASCSlots.Num() == 0)
+	{
+		return;
+	}
+
+	const TArray<int32> Slots = MoveTemp(PendingASCSlots);
+	PendingASCSlots.Reset();
+
+	TOptional<FScopedAggregatorOnDirtyBatch> AggregatorOnDirtyBatch;
+	if (LyraGlobalAbilitySystemCVars::bBatchedApply)
+	{
+		AggregatorOnDirtyBatch.Emplace();
 	}
 
-	RegisteredASCs.Remove(ASC);
+	for (int32 Slot : Slots)
+	{
+		ULyraAbilitySystemComponent* ASC = RegisteredASCs[Slot];
+		if (ASC == nullptr)
+		{
+			continue;
+		}
+
+		for (auto& Entry : AppliedAbilities)
+		{
+			Entry.Value.AddToASC(Entry.Key, ASC, Slot);
+		}
+		for (auto& Entry : AppliedEffects)
+		{
+			Entry.Value.AddToASC(Entry.Key, ASC, Slot);
+		}
+	}
 }
+
+//////////////////////////////////////////////////////////////////////
+
+#if !UE_BUILD_SHIPPING
+
+FAutoConsoleCommandWithWorldArgsAndOutputDevice GGlobalAbilitySystemBenchmarkCmd(
+	TEXT("Lyra.GlobalAbilitySystem.Benchmark"),
+	TEXT("Usage:\n")
+	TEXT("  Lyra.GlobalAbilitySystem.Benchmark EffectClassPath [MaxASCs]\n")
+	TEXT("\n")
+	TEXT("Times applying and removing a global effect with and without lyra.GlobalAbilitySystem.BatchedApply,\n")
+	TEXT("doubling the number of ASCs from 8 up to MaxASCs (default 256). The effect needs a duration (or be infinite)\n")
+	TEXT("and at least one modifier for there to be anything to batch. Uses temporary actors and its own\n")
+	TEXT("global ability system, so the players in the world aren't affected. Needs authority (server or standalone)"),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(
+		[](const TArray<FString>& Params, UWorld* World, FOutputDevice& Ar)
+{
+	if ((World == nullptr) || (World->GetNetMode() == NM_Client))
+	{
+		Ar.Logf(ELogVerbosity::Error, TEXT("Lyra.GlobalAbilitySystem.Benchmark needs a world with authority"));
+		return;
+	}
+
+	if (Params.Num() == 0)
+	{
+		Ar.Logf(ELogVerbosity::Error, TEXT("Usage: Lyra.GlobalAbilitySystem.Benchmark EffectClassPath [MaxASCs]"));
+		return;
+	}
+
+	TSubclassOf<UGameplayEffect> EffectClass = FSoftClassPath(Params[0]).TryLoadClass<UGameplayEffect>();
+	if (EffectClass == nullptr)
+	{
+		Ar.Logf(ELogVerbosity::Error, TEXT("Couldn't load gameplay effect class %s"), *Params[0]);
+		return;
+	}
+
+	// Instant effects don't stay applied and effects without modifiers don't touch any aggregators, so neither would measure anything
+	const UGameplayEffect* EffectCDO = EffectClass->GetDefaultObject<UGameplayEffect>();
+	if ((EffectCDO->DurationPolicy == EGameplayEffectDurationType::Instant) || (EffectCDO->Modifiers.Num() == 0))
+	{
+		Ar.Logf(ELogVerbosity::Error, TEXT("%s needs a duration (or to be infinite) and at least one modifier to benchmark"), *GetNameSafe(EffectClass));
+		return;
+	}
+
+	// The ASCs need the attribute sets the modifiers change
+	TArray<TSubclassOf<UAttributeSet>> AttributeSetClasses;
+	for (const FGameplayModifierInfo& Modifier : EffectCDO->Modifiers)
+	{
+		if (UClass* AttributeSetClass = Modifier.Attribute.GetAttributeSetClass())
+		{
+			AttributeSetClasses.AddUnique(AttributeSetClass);
+		}
+	}
+
+	const int32 MaxASCs = FMath::Clamp((Params.Num() > 1) ? FCString::Atoi(*Params[1]) : 256, 8, 4096);
+	const int32 NumIterations = 8;
+
+	TGuardValue<bool> DeferGuard(LyraGlobalAbilitySystemCVars::bDeferLateJoiners, false);
+
+	ULyraGlobalAbilitySystem* BenchmarkSystem = NewObject<ULyraGlobalAbilitySystem>(World);
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.ObjectFlags |= RF_Transient;
+
+	TArray<AActor*> Actors;
+	for (int32 Index = 0; Index < MaxASCs; ++Index)
+	{
+		AActor* Actor = World->SpawnActor<AActor>(SpawnParams);
+		ULyraAbilitySystemComponent* ASC = NewObject<ULyraAbilitySystemComponent>(Actor);
+		ASC->RegisterComponent();
+		ASC->InitAbilityActorInfo(Actor, Actor);
+		for (const TSubclassOf<UAttributeSet>& AttributeSetClass : AttributeSetClasses)
+		{
+			ASC->InitStats(AttributeSetClass, nullptr);
+		}
+		Actors.Add(Actor);
+	}
+
+	Ar.Logf(TEXT("Applying and removing %s (average of %d runs)"), *GetNameSafe(EffectClass), NumIterations);
+
+	int32 NumRegistered = 0;
+	for (int32 NumASCs = 8; NumASCs <= MaxASCs; NumASCs *= 2)
+	{
+		for (; NumRegistered < NumASCs; ++NumRegistered)
+		{
+			BenchmarkSystem->RegisterASC(Actors[NumRegistered]->FindComponentByClass<ULyraAbilitySystemComponent>());
+		}
+
+		double ApplySeconds[2] = { 0.0, 0.0 };
+		double RemoveSeconds[2] = { 0.0, 0.0 };
+		for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+		{
+			// Alternate which mode goes first, so neither always runs with the caches warmed up by the other
+			for (int32 Pass = 0; Pass < 2; ++Pass)
+			{
+				const int32 Mode = (Iteration + Pass) % 2;
+				TGuardValue<bool> BatchedGuard(LyraGlobalAbilitySystemCVars::bBatchedApply, (Mode == 1));
+
+				const double ApplyStartTime = FPlatformTime::Seconds();
+				BenchmarkSystem->ApplyEffectToAll(EffectClass);
+				const double RemoveStartTime = FPlatformTime::Seconds();
+				BenchmarkSystem->RemoveEffectFromAll(EffectClass);
+				const double EndTime = FPlatformTime::Seconds();
+
+				ApplySeconds[Mode] += RemoveStartTime - ApplyStartTime;
+				RemoveSeconds[Mode] += EndTime - RemoveStartTime;
+			}
+		}
+
+		const double MsPerRun = 1000.0 / NumIterations;
+		Ar.Logf(TEXT("  %4d ASCs: per ASC apply %.3f ms, remove %.3f ms | batched apply %.3f ms, remove %.3f ms"),
+			NumASCs, ApplySeconds[0] * MsPerRun, RemoveSeconds[0] * MsPerRun, ApplySeconds[1] * MsPerRun, RemoveSeconds[1] * MsPerRun);
+	}
+
+	for (AActor* Actor : Actors)
+	{
+		BenchmarkSystem->UnregisterASC(Actor->FindComponentByClass<ULyraAbilitySystemComponent>());
+		Actor->Destroy();
+	}
+}));
+
+#endif
@@ -21,12 +21,13 @@ struct FGlobalAppliedAbilityList
 {
 	GENERATED_BODY()
 
+	// Indexed by ASC slot (see ULyraGlobalAbilitySystem::RegisteredASCs), grown as needed and invalid where the ability hasn't been given
 	UPROPERTY()
-	TMap<ULyraAbilitySystemComponent*, FGameplayAbilitySpecHandle> Handles;
+	TArray<FGameplayAbilitySpecHandle> Handles;
 
-	void AddToASC(TSubclassOf<UGameplayAbility> Ability, ULyraAbilitySystemComponent* ASC);
-	void RemoveFromASC(ULyraAbilitySystemComponent* ASC);
-	void RemoveFromAll();
+	void AddToASC(TSubclassOf<UGameplayAbility> Ability, ULyraAbilitySystemComponent* ASC, int32 Slot);
+	void RemoveFromASC(ULyraAbilitySystemComponent* ASC, int32 Slot);
+	void RemoveFromAll(TArrayView<ULyraAbilitySystemComponent* const> ASCs);
 };
 
 USTRUCT()
@@ -34,12 +35,16 @@ struct FGlobalAppliedEffectList
 {
 	GENERATED_BODY()
 
+	// Indexed by ASC slot (see ULyraGlobalAbilitySystem::RegisteredASCs), grown as needed and invalid where the effect hasn't been applied
 	UPROPERTY()
-	TMap<ULyraAbilitySystemComponent*, FActiveGameplayEffectHandle> Handles;
+	TArray<FActiveGameplayEffectHandle> Handles;
 
-	void AddToASC(TSubclassOf<UGameplayEffect> Effect, ULyraAbilitySystemComponent* ASC);
-	void RemoveFromASC(ULyraAbilitySystemComponent* ASC);
-	void RemoveFromAll();
+	// When valid, applied to every ASC (including ones that register later) instead of making a new spec for each
+	FGameplayEffectSpecHandle SharedSpec;
+
+	void AddToASC(TSubclassOf<UGameplayEffect> Effect, ULyraAbilitySystemComponent* ASC, int32 Slot);
+	void RemoveFromASC(ULyraAbilitySystemComponent* ASC, int32 Slot);
+	void RemoveFromAll(TArrayView<ULyraAbilitySystemComponent* const> ASCs);
 };
 
 UCLASS()
@@ -62,12 +67,19 @@ public:
 	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category = "Lyra")
 	void RemoveEffectFromAll(TSubclassOf<UGameplayEffect> Effect);
 
-	/** Register an ASC with global system and apply any active global effects/abilities. */
+	/** Register an ASC with global system and apply any active global effects/abilities (on the next tick if lyra.GlobalAbilitySystem.DeferLateJoiners is set). */
 	void RegisterASC(ULyraAbilitySystemComponent* ASC);
 
 	/** Removes an ASC from the global system, along with any active global effects/abilities. */
 	void UnregisterASC(ULyraAbilitySystemComponent* ASC);
 
+private:
+	// Builds the spec ApplyEffectToAll shares between every ASC, with the game state as the source
+	FGameplayEffectSpecHandle MakeSharedEffectSpec(TSubclassOf<UGameplayEffect> Effect) const;
+
+	// Applies the active global abilities and effects to ASCs that registered since they were applied
+	void ApplyGlobalsToPendingASCs();
+
 private:
 	UPROPERTY()
 	TMap<TSubclassOf<UGameplayAbility>, FGlobalAppliedAbilityList> AppliedAbilities;
@@ -75,6 +87,13 @@ private:
 	UPROPERTY()
 	TMap<TSubclassOf<UGameplayEffect>, FGlobalAppliedEffectList> AppliedEffects;
 
+	// Indexed by slot, slots stay put while an ASC is registered so the applied lists can store their handles in flat arrays
+	// (slots of unregistered ASCs are null until they are reused)
 	UPROPERTY()
 	TArray<ULyraAbilitySystemComponent*> RegisteredASCs;
+
+	TArray<int32> FreeASCSlots;
+
+	// Slots of ASCs that registered but haven't had the active globals applied yet
+	TArray<int32> PendingASCSlots;
 };
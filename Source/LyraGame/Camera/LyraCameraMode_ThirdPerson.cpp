@@ -8,9 +8,51 @@
 #include "GameFramework/Controller.h"
 #include "GameFramework/Character.h"
 
+DECLARE_STATS_GROUP(TEXT("LyraCamera"), STATGROUP_LyraCamera, STATCAT_Advanced);
+DECLARE_CYCLE_STAT(TEXT("Prevent Penetration"), STAT_LyraCamera_PreventPenetration, STATGROUP_LyraCamera);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Sync Feeler Sweeps"), STAT_LyraCamera_SyncFeelerSweeps, STATGROUP_LyraCamera);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Async Feeler Sweeps"), STAT_LyraCamera_AsyncFeelerSweeps, STATGROUP_LyraCamera);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Feeler Sweeps Deferred (Budget)"), STAT_LyraCamera_DeferredFeelerSweeps, STATGROUP_LyraCamera);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Async Feeler Latency (Frames)"), STAT_LyraCamera_AsyncFeelerLatency, STATGROUP_LyraCamera);
+
 namespace LyraCameraMode_ThirdPerson_Statics
 {
 	static const FName NAME_IgnoreCameraCollision = TEXT("IgnoreCameraCollision");
+
+	static bool bAllowAsyncPredictiveFeelers = true;
+	static FAutoConsoleVariableRef CVarAllowAsyncPredictiveFeelers(
+		TEXT("lyra.Camera.AllowAsyncPenetrationFeelers"),
+		bAllowAsyncPredictiveFeelers,
+		TEXT("Should third person cameras that request it trace their predictive penetration feelers asynchronously"),
+		ECVF_Default);
+
+	static int32 PredictiveFeelerTraceBudget = 12;
+	static FAutoConsoleVariableRef CVarPredictiveFeelerTraceBudget(
+		TEXT("lyra.Camera.PenetrationFeelerTraceBudget"),
+		PredictiveFeelerTraceBudget,
+		TEXT("Maximum number of predictive penetration feeler traces per frame, shared by all local cameras (0 = unlimited). The main feeler is never deferred."),
+		ECVF_Default);
+
+	static uint64 FeelerTraceBudgetFrame = 0;
+	static int32 FeelerTracesThisFrame = 0;
+
+	// Returns true if another predictive feeler can be traced this frame
+	static bool ConsumeFeelerTraceBudget()
+	{
+		if (FeelerTraceBudgetFrame != GFrameCounter)
+		{
+			FeelerTraceBudgetFrame = GFrameCounter;
+			FeelerTracesThisFrame = 0;
+		}
+
+		if ((PredictiveFeelerTraceBudget > 0) && (FeelerTracesThisFrame >= PredictiveFeelerTraceBudget))
+		{
+			return false;
+		}
+
+		++FeelerTracesThisFrame;
+		return true;
+	}
 }
 
 ULyraCameraMode_ThirdPerson::ULyraCameraMode_ThirdPerson()
@@ -109,6 +151,8 @@ void ULyraCameraMode_ThirdPerson::UpdatePreventPenetration(float DeltaTime)
 		return;
 	}
 
+	SCOPE_CYCLE_COUNTER(STAT_LyraCamera_PreventPenetration);
+
 	AActor* TargetActor = GetTargetActor();
 
 	APawn* TargetPawn = Cast<APawn>(TargetActor);
@@ -195,11 +239,62 @@ void ULyraCameraMode_ThirdPerson::PreventCameraPenetration(class AActor const& V
 	FCollisionShape SphereShape = FCollisionShape::MakeSphere(0.f);
 	UWorld* World = GetWorld();
 
+	const bool bAsyncFeelers = bUseAsyncPredictiveFeelers && LyraCameraMode_ThirdPerson_Statics::bAllowAsyncPredictiveFeelers;
+	if (PendingFeelerTraces.Num() != PenetrationAvoidanceFeelers.Num())
+	{
+		PendingFeelerTraces.SetNum(PenetrationAvoidanceFeelers.Num());
+	}
+
 	for (int32 RayIdx = 0; RayIdx < NumRaysToShoot; ++RayIdx)
 	{
 		FLyraPenetrationAvoidanceFeeler& Feeler = PenetrationAvoidanceFeelers[RayIdx];
+
+		// The main ray is always traced synchronously, the predictive ones only influence the soft blend so they can lag a frame
+		const bool bAsyncFeeler = bAsyncFeelers && (RayIdx > 0);
+		FPendingFeelerTrace& PendingTrace = PendingFeelerTraces[RayIdx];
+
+		if (PendingTrace.Handle.IsValid())
+		{
+			FTraceDatum TraceData;
+			if (!World->QueryTraceData(PendingTrace.Handle, TraceData))
+			{
+				// Still in flight (or the mode was toggled), keep waiting rather than issuing a duplicate
+				if (World->IsTraceHandleValid(PendingTrace.Handle, /*bOverlapTrace=*/ false))
+				{
+					continue;
+				}
+
+				PendingTrace.Handle = FTraceHandle();
+			}
+			else
+			{
+				PendingTrace.Handle = FTraceHandle();
+				SET_DWORD_STAT(STAT_LyraCamera_AsyncFeelerLatency, (uint32)(GFrameCounter - PendingTrace.IssueFrame));
+
+				// The result is for last frame's ray, use its blocked percentage as the prediction for this frame
+				const FHitResult* Hit = FHitResult::GetFirstBlockingHit(TraceData.OutHits);
+				float NewBlockPct = 1.f;
+				if (Hit && EvaluateFeelerHit(ViewTarget, Feeler, *Hit, TraceData.Start, TraceData.End, SphereParams, NewBlockPct))
+				{
+					DistBlockedPctThisFrame = FMath::Min(NewBlockPct, DistBlockedPctThisFrame);
+
+					// This feeler got a hit, so do another trace next frame
+					Feeler.FramesUntilNextTrace = 0;
+				}
+
+				SoftBlockedPct = DistBlockedPctThisFrame;
+			}
+		}
+
 		if (Feeler.FramesUntilNextTrace <= 0)
 		{
+			if ((RayIdx > 0) && !LyraCameraMode_ThirdPerson_Statics::ConsumeFeelerTraceBudget())
+			{
+				// Out of budget for this frame, try again next frame
+				INC_DWORD_STAT(STAT_LyraCamera_DeferredFeelerSweeps);
+				continue;
+			}
+
 			// calc ray target
 			FVector RayTarget;
 			{
@@ -213,12 +308,23 @@ void ULyraCameraMode_ThirdPerson::PreventCameraPenetration(class AActor const& V
 			SphereShape.Sphere.Radius = Feeler.Extent;
 			ECollisionChannel TraceChannel = ECC_Camera;		//(Feeler.PawnWeight > 0.f) ? ECC_Pawn : ECC_Camera;
 
+			Feeler.FramesUntilNextTrace = Feeler.TraceInterval;
+
+			if (bAsyncFeeler)
+			{
+				PendingTrace.Handle = World->AsyncSweepByChannel(EAsyncTraceType::Single, SafeLoc, RayTarget, FQuat::Identity, TraceChannel, SphereShape, SphereParams);
+				PendingTrace.IssueFrame = GFrameCounter;
+				INC_DWORD_STAT(STAT_LyraCamera_AsyncFeelerSweeps);
+				continue;
+			}
+
 			// do multi-line check to make sure the hits we throw out aren't
 			// masking real hits behind (these are important rays).
 
 			// MT-> passing camera as actor so that camerablockingvolumes know when it's the camera doing traces
 			FHitResult Hit;
 			const bool bHit = World->SweepSingleByChannel(Hit, SafeLoc, RayTarget, FQuat::Identity, TraceChannel, SphereShape, SphereParams);
+			INC_DWORD_STAT(STAT_LyraCamera_SyncFeelerSweeps);
 #if ENABLE_DRAW_DEBUG
 			if (World->TimeSince(LastDrawDebugTime) < 1.f)
 			{
@@ -228,59 +334,13 @@ void ULyraCameraMode_ThirdPerson::PreventCameraPenetration(class AActor const& V
 			}
 #endif // ENABLE_DRAW_DEBUG
 
-			Feeler.FramesUntilNextTrace = Feeler.TraceInterval;
-
-			const AActor* HitActor = Hit.GetActor();
-
-			if (bHit && HitActor)
+			float NewBlockPct = 1.f;
+			if (bHit && EvaluateFeelerHit(ViewTarget, Feeler, Hit, SafeLoc, RayTarget, SphereParams, NewBlockPct))
 			{
-				bool bIgnoreHit = false;
+				DistBlockedPctThisFrame = FMath::Min(NewBlockPct, DistBlockedPctThisFrame);
 
-				if (HitActor->ActorHasTag(LyraCameraMode_ThirdPerson_Statics::NAME_IgnoreCameraCollision))
-				{
-					bIgnoreHit = true;
-					SphereParams.AddIgnoredActor(HitActor);
-				}
-
-				// Ignore CameraBlockingVolume hits that occur in front of the ViewTarget.
-				if (!bIgnoreHit && HitActor->IsA<ACameraBlockingVolume>())
-				{
-					const FVector ViewTargetForwardXY = ViewTarget.GetActorForwardVector().GetSafeNormal2D();
-					const FVector ViewTargetLocation = ViewTarget.GetActorLocation();
-					const FVector HitOffset = Hit.Location - ViewTargetLocation;
-					const FVector HitDirectionXY = HitOffset.GetSafeNormal2D();
-					const float DotHitDirection = FVector::DotProduct(ViewTargetForwardXY, HitDirectionXY);
-					if (DotHitDirection > 0.0f)
-					{
-						bIgnoreHit = true;
-						// Ignore this CameraBlockingVolume on the remaining sweeps.
-						SphereParams.AddIgnoredActor(HitActor);
-					}
-					else
-					{
-#if ENABLE_DRAW_DEBUG
-						DebugActorsHitDuringCameraPenetration.AddUnique(TObjectPtr<const AActor>(HitActor));
-#endif
-					}
-				}
-				
-				if (!bIgnoreHit)
-				{
-					float const Weight = Cast<APawn>(Hit.GetActor()) ? Feeler.PawnWeight : Feeler.WorldWeight;
-					float NewBlockPct = Hit.Time;
-					NewBlockPct += (1.f - NewBlockPct) * (1.f - Weight);
-
-					// Recompute blocked pct taking into account pushout distance.
-					NewBlockPct = ((Hit.Location - SafeLoc).Size() - CollisionPushOutDistance) / (RayTarget - SafeLoc).Size();
-					DistBlockedPctThisFrame = FMath::Min(NewBlockPct, DistBlockedPctThisFrame);
-
-					// This feeler got a hit, so do another trace next frame
-					Feeler.FramesUntilNextTrace = 0;
-
-#if ENABLE_DRAW_DEBUG
-					DebugActorsHitDuringCameraPenetration.AddUnique(TObjectPtr<const AActor>(HitActor));
-#endif
-				}
+				// This feeler got a hit, so do another trace next frame
+				Feeler.FramesUntilNextTrace = 0;
 			}
 
 			if (RayIdx == 0)
@@ -343,6 +403,51 @@ void ULyraCameraMode_ThirdPerson::PreventCameraPenetration(class AActor const& V
 	}
 }
 
+bool ULyraCameraMode_ThirdPerson::EvaluateFeelerHit(class AActor const& ViewTarget, const FLyraPenetrationAvoidanceFeeler& Feeler, const FHitResult& Hit, FVector const& TraceStart, FVector const& TraceEnd, FCollisionQueryParams& SphereParams, float& OutBlockedPct)
+{
+	const AActor* HitActor = Hit.GetActor();
+	if (HitActor == nullptr)
+	{
+		return false;
+	}
+
+	if (HitActor->ActorHasTag(LyraCameraMode_ThirdPerson_Statics::NAME_IgnoreCameraCollision))
+	{
+		SphereParams.AddIgnoredActor(HitActor);
+		return false;
+	}
+
+	// Ignore CameraBlockingVolume hits that occur in front of the ViewTarget.
+	if (HitActor->IsA<ACameraBlockingVolume>())
+	{
+		const FVector ViewTargetForwardXY = ViewTarget.GetActorForwardVector().GetSafeNormal2D();
+		const FVector ViewTargetLocation = ViewTarget.GetActorLocation();
+		const FVector HitOffset = Hit.Location - ViewTargetLocation;
+		const FVector HitDirectionXY = HitOffset.GetSafeNormal2D();
+		const float DotHitDirection = FVector::DotProduct(ViewTargetForwardXY, HitDirectionXY);
+		if (DotHitDirection > 0.0f)
+		{
+			// Ignore this CameraBlockingVolume on the remaining sweeps.
+			SphereParams.AddIgnoredActor(HitActor);
+			return false;
+		}
+	}
+
+	float const Weight = Cast<APawn>(Hit.GetActor()) ? Feeler.PawnWeight : Feeler.WorldWeight;
+	float NewBlockPct = Hit.Time;
+	NewBlockPct += (1.f - NewBlockPct) * (1.f - Weight);
+
+	// Recompute blocked pct taking into account pushout distance.
+	NewBlockPct = ((Hit.Location - TraceStart).Size() - CollisionPushOutDistance) / (TraceEnd - TraceStart).Size();
+	OutBlockedPct = NewBlockPct;
+
+#if ENABLE_DRAW_DEBUG
+	DebugActorsHitDuringCameraPenetration.AddUnique(TObjectPtr<const AActor>(HitActor));
+#endif
+
+	return true;
+}
+
 void ULyraCameraMode_ThirdPerson::SetTargetCrouchOffset(FVector NewTargetOffset)
 {
 	CrouchOffsetBlendPct = 0.0f;
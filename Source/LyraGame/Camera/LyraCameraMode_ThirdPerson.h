@@ -7,6 +7,7 @@
 #include "Curves/CurveFloat.h"
 #include "LyraPenetrationAvoidanceFeeler.h"
 #include "DrawDebugHelpers.h"
+#include "WorldCollision.h"
 #include "LyraCameraMode_ThirdPerson.generated.h"
 
 class UCurveVector;
@@ -33,6 +34,9 @@ protected:
 	void UpdatePreventPenetration(float DeltaTime);
 	void PreventCameraPenetration(class AActor const& ViewTarget, FVector const& SafeLoc, FVector& CameraLoc, float const& DeltaTime, float& DistBlockedPct, bool bSingleRayOnly);
 
+	// Applies the ignore rules to a feeler hit, returning true (and the blocked percentage along the feeler) if the hit should pull the camera in
+	bool EvaluateFeelerHit(class AActor const& ViewTarget, const FLyraPenetrationAvoidanceFeeler& Feeler, const FHitResult& Hit, FVector const& TraceStart, FVector const& TraceEnd, FCollisionQueryParams& SphereParams, float& OutBlockedPct);
+
 	virtual void DrawDebug(UCanvas* Canvas) const override;
 
 protected:
@@ -75,6 +79,13 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Collision")
 	bool bDoPredictiveAvoidance = true;
 
+	/**
+	 * If true, the predictive feelers (index 1+) are traced asynchronously and their results are used one frame later.
+	 * The main feeler is always traced synchronously so the camera never ends up inside geometry.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Collision")
+	bool bUseAsyncPredictiveFeelers = true;
+
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Collision")
 	float CollisionPushOutDistance = 2.f;
 
@@ -102,6 +113,17 @@ public:
 	mutable float LastDrawDebugTime = -MAX_FLT;
 #endif
 
+protected:
+
+	struct FPendingFeelerTrace
+	{
+		FTraceHandle Handle;
+		uint64 IssueFrame = 0;
+	};
+
+	// In-flight async traces for the predictive feelers, indexed like PenetrationAvoidanceFeelers
+	TArray<FPendingFeelerTrace> PendingFeelerTraces;
+
 protected:
 	
 	void SetTargetCrouchOffset(FVector NewTargetOffset);
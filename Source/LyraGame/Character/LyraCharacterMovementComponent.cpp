@@ -14,6 +14,9 @@ namespace LyraCharacter
 {
 	static float GroundTraceDistance = 100000.0f;
 	FAutoConsoleVariableRef CVar_GroundTraceDistance(TEXT("LyraCharacter.GroundTraceDistance"), GroundTraceDistance, TEXT("Distance to trace down when generating ground information."), ECVF_Cheat);
+
+	static bool bAsyncGroundTraceForSimulatedProxies = true;
+	FAutoConsoleVariableRef CVar_AsyncGroundTraceForSimulatedProxies(TEXT("LyraCharacter.AsyncGroundTraceForSimulatedProxies"), bAsyncGroundTraceForSimulatedProxies, TEXT("If true, simulated proxies get their ground distance from an async trace issued the previous frame instead of a blocking trace."), ECVF_Default);
 };
 
 
@@ -75,6 +78,17 @@ const FLyraCharacterGroundInfo& ULyraCharacterMovementComponent::GetGroundInfo()
 		FCollisionResponseParams ResponseParam;
 		InitCollisionParams(QueryParams, ResponseParam);
 
+		if (LyraCharacter::bAsyncGroundTraceForSimulatedProxies && (CharacterOwner->GetLocalRole() == ROLE_SimulatedProxy) && (MovementMode != MOVE_NavWalking))
+		{
+			if (UpdateGroundInfoFromAsyncTrace(TraceStart, TraceEnd, CollisionChannel, QueryParams, ResponseParam, CapsuleHalfHeight))
+			{
+				CachedGroundInfo.LastUpdateFrame = GFrameCounter;
+				return CachedGroundInfo;
+			}
+
+			// Nothing traced last frame to use (e.g., the first frame off the ground), so fall back to a blocking trace
+		}
+
 		FHitResult HitResult;
 		GetWorld()->LineTraceSingleByChannel(HitResult, TraceStart, TraceEnd, CollisionChannel, QueryParams, ResponseParam);
 
@@ -96,6 +110,49 @@ const FLyraCharacterGroundInfo& ULyraCharacterMovementComponent::GetGroundInfo()
 	return CachedGroundInfo;
 }
 
+bool ULyraCharacterMovementComponent::UpdateGroundInfoFromAsyncTrace(const FVector& TraceStart, const FVector& TraceEnd, ECollisionChannel CollisionChannel, const FCollisionQueryParams& QueryParams, const FCollisionResponseParams& ResponseParam, float CapsuleHalfHeight)
+{
+	UWorld* World = GetWorld();
+	bool bUpdatedGroundInfo = false;
+
+	// Only a trace issued last frame is close enough to where we are now to use, anything older is dropped
+	if (PendingGroundTraceHandle.IsValid())
+	{
+		FTraceDatum TraceData;
+		if (((PendingGroundTraceFrame + 1) == GFrameCounter) && World->QueryTraceData(PendingGroundTraceHandle, TraceData))
+		{
+			CachedGroundInfo.GroundHitResult = (TraceData.OutHits.Num() > 0) ? TraceData.OutHits[0] : FHitResult();
+			CachedGroundInfo.GroundDistance = LyraCharacter::GroundTraceDistance;
+
+			// The ground height is still good, so measure from where we are now rather than where we were when it was traced
+			if (CachedGroundInfo.GroundHitResult.bBlockingHit)
+			{
+				const float HeightAboveGround = GetActorLocation().Z - CachedGroundInfo.GroundHitResult.ImpactPoint.Z;
+				CachedGroundInfo.GroundDistance = FMath::Max((HeightAboveGround - CapsuleHalfHeight), 0.0f);
+			}
+
+			bUpdatedGroundInfo = true;
+		}
+
+		PendingGroundTraceHandle = FTraceHandle();
+	}
+
+	// Trace from where we'll be when the result is read back next frame
+	const FVector PredictedOffset(Velocity.X * World->GetDeltaSeconds(), Velocity.Y * World->GetDeltaSeconds(), 0.0f);
+	PendingGroundTraceHandle = World->AsyncLineTraceByChannel(EAsyncTraceType::Single, TraceStart + PredictedOffset, TraceEnd + PredictedOffset, CollisionChannel, QueryParams, ResponseParam);
+	PendingGroundTraceFrame = GFrameCounter;
+
+	return bUpdatedGroundInfo;
+}
+
+void ULyraCharacterMovementComponent::OnMovementModeChanged(EMovementMode PreviousMovementMode, uint8 PreviousCustomMode)
+{
+	Super::OnMovementModeChanged(PreviousMovementMode, PreviousCustomMode);
+
+	// A ground trace issued in the old movement mode (e.g., before landing) doesn't describe the ground we're over now
+	PendingGroundTraceHandle = FTraceHandle();
+}
+
 void ULyraCharacterMovementComponent::SetReplicatedAcceleration(const FVector& InAcceleration)
 {
 	bHasReplicatedAcceleration = true;
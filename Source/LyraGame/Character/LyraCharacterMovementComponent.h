@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "NativeGameplayTags.h"
+#include "WorldCollision.h"
 #include "LyraCharacterMovementComponent.generated.h"
 
 LYRAGAME_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(TAG_Gameplay_MovementStopped);
@@ -63,15 +64,26 @@ public:
 	virtual float GetMaxSpeed() const override;
 	//~End of UMovementComponent interface
 
+	//~UCharacterMovementComponent interface
+	virtual void OnMovementModeChanged(EMovementMode PreviousMovementMode, uint8 PreviousCustomMode) override;
+	//~End of UCharacterMovementComponent interface
+
 protected:
 
 	virtual void InitializeComponent() override;
 
+	// Updates the ground info of a simulated proxy from the async trace issued last frame and issues the next one, returns false if there was no result from last frame to use
+	bool UpdateGroundInfoFromAsyncTrace(const FVector& TraceStart, const FVector& TraceEnd, ECollisionChannel CollisionChannel, const FCollisionQueryParams& QueryParams, const FCollisionResponseParams& ResponseParam, float CapsuleHalfHeight);
+
 protected:
 
 	// Cached ground info for the character.  Do not access this directly!  It's only updated when accessed via GetGroundInfo().
 	FLyraCharacterGroundInfo CachedGroundInfo;
 
+	// Ground trace issued for a simulated proxy, it runs at the end of the frame it was issued in and is only used if read back the next
+	FTraceHandle PendingGroundTraceHandle;
+	uint64 PendingGroundTraceFrame = 0;
+
 	UPROPERTY(Transient)
 	bool bHasReplicatedAcceleration = false;
 };
@@ -9,6 +9,8 @@
 #include "AttributeSet.h"
 #include "AbilitySystem/LyraAbilitySystemComponent.h"
 #include "Player/LyraPlayerState.h" //@TODO: For the fname
+#include "Engine/DataTable.h"
+#include "Engine/StreamableManager.h"
 
 #define LOCTEXT_NAMESPACE "GameFeatures"
 
@@ -24,6 +26,13 @@ void UGameFeatureAction_AddAbilities::OnGameFeatureActivating(FGameFeatureActiva
 	{
 		Reset(ActiveData);
 	}
+
+	// Get the grants loaded and resolved up front, so pawns spawning later don't pay for it
+	if (NumActiveContexts++ == 0)
+	{
+		StartPreloadingGrants();
+	}
+
 	Super::OnGameFeatureActivating(Context);
 }
 
@@ -36,6 +45,11 @@ void UGameFeatureAction_AddAbilities::OnGameFeatureDeactivating(FGameFeatureDeac
 	{
 		Reset(*ActiveData);
 	}
+
+	if (ensure(NumActiveContexts > 0) && (--NumActiveContexts == 0))
+	{
+		ReleaseGrants();
+	}
 }
 
 #if WITH_EDITOR
@@ -152,19 +166,18 @@ void UGameFeatureAction_AddAbilities::HandleActorExtension(AActor* Actor, FName
 	FPerContextData* ActiveData = ContextData.Find(ChangeContext);
 	if (AbilitiesList.IsValidIndex(EntryIndex) && ActiveData)
 	{
-		const FGameFeatureAbilitiesEntry& Entry = AbilitiesList[EntryIndex];
 		if ((EventName == UGameFrameworkComponentManager::NAME_ExtensionRemoved) || (EventName == UGameFrameworkComponentManager::NAME_ReceiverRemoved))
 		{
 			RemoveActorAbilities(Actor, *ActiveData);
 		}
 		else if ((EventName == UGameFrameworkComponentManager::NAME_ExtensionAdded) || (EventName == ALyraPlayerState::NAME_LyraAbilityReady))
 		{
-			AddActorAbilities(Actor, Entry, *ActiveData);
+			AddActorAbilities(Actor, EntryIndex, *ActiveData);
 		}
 	}
 }
 
-void UGameFeatureAction_AddAbilities::AddActorAbilities(AActor* Actor, const FGameFeatureAbilitiesEntry& AbilitiesEntry, FPerContextData& ActiveData)
+void UGameFeatureAction_AddAbilities::AddActorAbilities(AActor* Actor, int32 EntryIndex, FPerContextData& ActiveData)
 {
 	check(Actor);
 	if (!Actor->HasAuthority())
@@ -178,61 +191,234 @@ void UGameFeatureAction_AddAbilities::AddActorAbilities(AActor* Actor, const FGa
 		return;	
 	}
 
+	// Normally the preload has finished long before anything spawns, if not finish resolving now
+	if (!bGrantsResolved)
+	{
+		UE_LOG(LogGameFeatures, Log, TEXT("Granting abilities to '%s' before %s finished preloading its grants, resolving them now."), *Actor->GetPathName(), *GetPathNameSafe(this));
+		ResolveGrants();
+	}
+
+	const FGameFeatureAbilitiesEntry& AbilitiesEntry = AbilitiesList[EntryIndex];
+	const FResolvedAbilitiesEntry& ResolvedEntry = ResolvedEntries[EntryIndex];
+
 	if (UAbilitySystemComponent* AbilitySystemComponent = FindOrAddComponentForActor<UAbilitySystemComponent>(Actor, AbilitiesEntry, ActiveData))
 	{
 		FActorExtensions AddedExtensions;
-		AddedExtensions.Abilities.Reserve(AbilitiesEntry.GrantedAbilities.Num());
-		AddedExtensions.Attributes.Reserve(AbilitiesEntry.GrantedAttributes.Num());
-		AddedExtensions.AbilitySetHandles.Reserve(AbilitiesEntry.GrantedAbilitySets.Num());
+		AddedExtensions.Abilities.Reserve(ResolvedEntry.Abilities.Num());
+		AddedExtensions.Attributes.Reserve(ResolvedEntry.Attributes.Num());
+		AddedExtensions.AbilitySetHandles.Reserve(ResolvedEntry.AbilitySets.Num());
+
+		for (const TSubclassOf<UGameplayAbility>& AbilityType : ResolvedEntry.Abilities)
+		{
+			FGameplayAbilitySpec NewAbilitySpec(AbilityType);
+			FGameplayAbilitySpecHandle AbilityHandle = AbilitySystemComponent->GiveAbility(NewAbilitySpec);
+
+			AddedExtensions.Abilities.Add(AbilityHandle);
+		}
+
+		for (const FResolvedAttributeSetGrant& Attributes : ResolvedEntry.Attributes)
+		{
+			UAttributeSet* NewSet = NewObject<UAttributeSet>(AbilitySystemComponent->GetOwner(), Attributes.AttributeSetType);
+			ApplyAttributeInitialValues(NewSet, Attributes.InitialValues);
+
+			AddedExtensions.Attributes.Add(NewSet);
+			AbilitySystemComponent->AddAttributeSetSubobject(NewSet);
+		}
+
+		ULyraAbilitySystemComponent* LyraASC = CastChecked<ULyraAbilitySystemComponent>(AbilitySystemComponent);
+		for (const ULyraAbilitySet* Set : ResolvedEntry.AbilitySets)
+		{
+			Set->GiveToAbilitySystem(LyraASC, &AddedExtensions.AbilitySetHandles.AddDefaulted_GetRef());
+		}
+
+		ActiveData.ActiveExtensions.Add(Actor, AddedExtensions);
+	}
+	else
+	{
+		UE_LOG(LogGameFeatures, Error, TEXT("Failed to find/add an ability component to '%s'. Abilities will not be granted."), *Actor->GetPathName());
+	}
+}
 
-		for (const FLyraAbilityGrant& Ability : AbilitiesEntry.GrantedAbilities)
+void UGameFeatureAction_AddAbilities::StartPreloadingGrants()
+{
+	TArray<FSoftObjectPath> AssetsToLoad;
+	for (const FGameFeatureAbilitiesEntry& Entry : AbilitiesList)
+	{
+		for (const FLyraAbilityGrant& Ability : Entry.GrantedAbilities)
 		{
 			if (!Ability.AbilityType.IsNull())
 			{
-				FGameplayAbilitySpec NewAbilitySpec(Ability.AbilityType.LoadSynchronous());
-				FGameplayAbilitySpecHandle AbilityHandle = AbilitySystemComponent->GiveAbility(NewAbilitySpec);
+				AssetsToLoad.AddUnique(Ability.AbilityType.ToSoftObjectPath());
+			}
+		}
+
+		for (const FLyraAttributeSetGrant& Attributes : Entry.GrantedAttributes)
+		{
+			if (!Attributes.AttributeSetType.IsNull())
+			{
+				AssetsToLoad.AddUnique(Attributes.AttributeSetType.ToSoftObjectPath());
+			}
 
-				AddedExtensions.Abilities.Add(AbilityHandle);
+			if (!Attributes.InitializationData.IsNull())
+			{
+				AssetsToLoad.AddUnique(Attributes.InitializationData.ToSoftObjectPath());
 			}
 		}
 
-		for (const FLyraAttributeSetGrant& Attributes : AbilitiesEntry.GrantedAttributes)
+		for (const TSoftObjectPtr<const ULyraAbilitySet>& SetPtr : Entry.GrantedAbilitySets)
+		{
+			if (!SetPtr.IsNull())
+			{
+				AssetsToLoad.AddUnique(SetPtr.ToSoftObjectPath());
+			}
+		}
+	}
+
+	if (AssetsToLoad.Num() > 0)
+	{
+		PreloadHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(AssetsToLoad, FStreamableDelegate::CreateUObject(this, &ThisClass::ResolveGrants));
+	}
+
+	// The game feature's bundles are usually loaded already, in which case there's nothing to wait for
+	if (!PreloadHandle.IsValid() || PreloadHandle->HasLoadCompleted())
+	{
+		ResolveGrants();
+	}
+}
+
+void UGameFeatureAction_AddAbilities::ResolveGrants()
+{
+	if (bGrantsResolved)
+	{
+		return;
+	}
+
+	bGrantsResolved = true;
+
+	// Parse each attribute set's initialization table once, even when several entries use it
+	TMap<TPair<UClass*, const UDataTable*>, TArray<FAttributeInitialValue>> ParsedInitialValues;
+
+	ResolvedEntries.Reset(AbilitiesList.Num());
+	ResolvedObjects.Reset();
+	for (const FGameFeatureAbilitiesEntry& Entry : AbilitiesList)
+	{
+		FResolvedAbilitiesEntry& ResolvedEntry = ResolvedEntries.AddDefaulted_GetRef();
+
+		// These are only loaded here if the preload hasn't finished yet (or the assets weren't found)
+		for (const FLyraAbilityGrant& Ability : Entry.GrantedAbilities)
+		{
+			if (!Ability.AbilityType.IsNull())
+			{
+				if (TSubclassOf<UGameplayAbility> AbilityType = Ability.AbilityType.LoadSynchronous())
+				{
+					ResolvedEntry.Abilities.Add(AbilityType);
+					ResolvedObjects.Add(AbilityType.Get());
+				}
+			}
+		}
+
+		for (const FLyraAttributeSetGrant& Attributes : Entry.GrantedAttributes)
 		{
 			if (!Attributes.AttributeSetType.IsNull())
 			{
 				TSubclassOf<UAttributeSet> SetType = Attributes.AttributeSetType.LoadSynchronous();
 				if (SetType)
 				{
-					UAttributeSet* NewSet = NewObject<UAttributeSet>(AbilitySystemComponent->GetOwner(), SetType);
+					FResolvedAttributeSetGrant& ResolvedAttributes = ResolvedEntry.Attributes.AddDefaulted_GetRef();
+					ResolvedAttributes.AttributeSetType = SetType;
+					ResolvedObjects.Add(SetType.Get());
+
 					if (!Attributes.InitializationData.IsNull())
 					{
 						UDataTable* InitData = Attributes.InitializationData.LoadSynchronous();
 						if (InitData)
 						{
-							NewSet->InitFromMetaDataTable(InitData);
+							ResolvedObjects.Add(InitData);
+
+							TPair<UClass*, const UDataTable*> ParsedKey(SetType.Get(), InitData);
+							if (const TArray<FAttributeInitialValue>* ExistingValues = ParsedInitialValues.Find(ParsedKey))
+							{
+								ResolvedAttributes.InitialValues = *ExistingValues;
+							}
+							else
+							{
+								GatherAttributeInitialValues(SetType, InitData, ResolvedAttributes.InitialValues);
+								ParsedInitialValues.Add(ParsedKey, ResolvedAttributes.InitialValues);
+							}
 						}
 					}
-
-					AddedExtensions.Attributes.Add(NewSet);
-					AbilitySystemComponent->AddAttributeSetSubobject(NewSet);
 				}
 			}
 		}
 
-		ULyraAbilitySystemComponent* LyraASC = CastChecked<ULyraAbilitySystemComponent>(AbilitySystemComponent);
-		for (const TSoftObjectPtr<const ULyraAbilitySet>& SetPtr : AbilitiesEntry.GrantedAbilitySets)
+		for (const TSoftObjectPtr<const ULyraAbilitySet>& SetPtr : Entry.GrantedAbilitySets)
 		{
-			if (const ULyraAbilitySet* Set = SetPtr.Get())
+			if (!SetPtr.IsNull())
 			{
-				Set->GiveToAbilitySystem(LyraASC, &AddedExtensions.AbilitySetHandles.AddDefaulted_GetRef());
+				if (const ULyraAbilitySet* Set = SetPtr.LoadSynchronous())
+				{
+					ResolvedEntry.AbilitySets.Add(Set);
+					ResolvedObjects.Add(Set);
+				}
 			}
 		}
+	}
+}
 
-		ActiveData.ActiveExtensions.Add(Actor, AddedExtensions);
+void UGameFeatureAction_AddAbilities::ReleaseGrants()
+{
+	if (PreloadHandle.IsValid())
+	{
+		if (PreloadHandle->IsLoadingInProgress())
+		{
+			PreloadHandle->CancelHandle();
+		}
+		else
+		{
+			PreloadHandle->ReleaseHandle();
+		}
+		PreloadHandle.Reset();
 	}
-	else
+
+	ResolvedEntries.Reset();
+	ResolvedObjects.Reset();
+	bGrantsResolved = false;
+}
+
+void UGameFeatureAction_AddAbilities::GatherAttributeInitialValues(TSubclassOf<UAttributeSet> SetType, const UDataTable* InitData, TArray<FAttributeInitialValue>& OutInitialValues)
+{
+	static const FString Context = FString(TEXT("UGameFeatureAction_AddAbilities::GatherAttributeInitialValues"));
+
+	// Same rows UAttributeSet::InitFromMetaDataTable looks up, but done once instead of for every granted set
+	for (TFieldIterator<FProperty> It(SetType, EFieldIteratorFlags::IncludeSuper); It; ++It)
 	{
-		UE_LOG(LogGameFeatures, Error, TEXT("Failed to find/add an ability component to '%s'. Abilities will not be granted."), *Actor->GetPathName());
+		FProperty* Property = *It;
+		if (CastField<FNumericProperty>(Property) || FGameplayAttribute::IsGameplayAttributeDataProperty(Property))
+		{
+			const FString RowNameStr = FString::Printf(TEXT("%s.%s"), *Property->GetOwnerVariant().GetName(), *Property->GetName());
+			if (const FAttributeMetaData* MetaData = InitData->FindRow<FAttributeMetaData>(FName(*RowNameStr), Context, false))
+			{
+				OutInitialValues.Add({ Property, MetaData->BaseValue });
+			}
+		}
+	}
+}
+
+void UGameFeatureAction_AddAbilities::ApplyAttributeInitialValues(UAttributeSet* AttributeSet, TConstArrayView<FAttributeInitialValue> InitialValues)
+{
+	for (const FAttributeInitialValue& InitialValue : InitialValues)
+	{
+		if (FNumericProperty* NumericProperty = CastField<FNumericProperty>(InitialValue.Property))
+		{
+			void* Data = NumericProperty->ContainerPtrToValuePtr<void>(AttributeSet);
+			NumericProperty->SetFloatingPointPropertyValue(Data, InitialValue.BaseValue);
+		}
+		else if (FStructProperty* StructProperty = CastField<FStructProperty>(InitialValue.Property))
+		{
+			FGameplayAttributeData* DataPtr = StructProperty->ContainerPtrToValuePtr<FGameplayAttributeData>(AttributeSet);
+			DataPtr->SetBaseValue(InitialValue.BaseValue);
+			DataPtr->SetCurrentValue(InitialValue.BaseValue);
+		}
 	}
 }
 
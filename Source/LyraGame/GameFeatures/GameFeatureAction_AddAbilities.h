@@ -14,6 +14,7 @@ class UInputAction;
 class UAttributeSet;
 class UDataTable;
 struct FComponentRequestHandle;
+struct FStreamableHandle;
 class ULyraAbilitySet;
 
 USTRUCT(BlueprintType)
@@ -109,15 +110,56 @@ private:
 	
 	TMap<FGameFeatureStateChangeContext, FPerContextData> ContextData;	
 
+	// A base value from an attribute set's initialization data table
+	struct FAttributeInitialValue
+	{
+		FProperty* Property = nullptr;
+		float BaseValue = 0.0f;
+	};
+
+	struct FResolvedAttributeSetGrant
+	{
+		TSubclassOf<UAttributeSet> AttributeSetType;
+		TArray<FAttributeInitialValue> InitialValues;
+	};
+
+	// The loaded classes and assets of an AbilitiesList entry, so granting them doesn't have to load or parse anything
+	struct FResolvedAbilitiesEntry
+	{
+		TArray<TSubclassOf<UGameplayAbility>> Abilities;
+		TArray<FResolvedAttributeSetGrant> Attributes;
+		TArray<const ULyraAbilitySet*> AbilitySets;
+	};
+
+	// Resolved version of each AbilitiesList entry, valid while bGrantsResolved is set
+	TArray<FResolvedAbilitiesEntry> ResolvedEntries;
+	bool bGrantsResolved = false;
+
+	// Every class and asset referenced by ResolvedEntries, so they stay alive even if they were loaded outside of PreloadHandle
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<const UObject>> ResolvedObjects;
+
+	// Keeps everything in ResolvedEntries loaded while the feature is active
+	TSharedPtr<FStreamableHandle> PreloadHandle;
+	int32 NumActiveContexts = 0;
+
 	//~ Begin UGameFeatureAction_WorldActionBase interface
 	virtual void AddToWorld(const FWorldContext& WorldContext, const FGameFeatureStateChangeContext& ChangeContext) override;
 	//~ End UGameFeatureAction_WorldActionBase interface
 
 	void Reset(FPerContextData& ActiveData);
 	void HandleActorExtension(AActor* Actor, FName EventName, int32 EntryIndex, FGameFeatureStateChangeContext ChangeContext);
-	void AddActorAbilities(AActor* Actor, const FGameFeatureAbilitiesEntry& AbilitiesEntry, FPerContextData& ActiveData);
+	void AddActorAbilities(AActor* Actor, int32 EntryIndex, FPerContextData& ActiveData);
 	void RemoveActorAbilities(AActor* Actor, FPerContextData& ActiveData);
 
+	// Starts loading everything the entries grant, resolving them once it is loaded
+	void StartPreloadingGrants();
+	void ResolveGrants();
+	void ReleaseGrants();
+
+	static void GatherAttributeInitialValues(TSubclassOf<UAttributeSet> SetType, const UDataTable* InitData, TArray<FAttributeInitialValue>& OutInitialValues);
+	static void ApplyAttributeInitialValues(UAttributeSet* AttributeSet, TConstArrayView<FAttributeInitialValue> InitialValues);
+
 	template<class ComponentType>
 	ComponentType* FindOrAddComponentForActor(AActor* Actor, const FGameFeatureAbilitiesEntry& AbilitiesEntry, FPerContextData& ActiveData)
 	{
@@ -141,6 +141,9 @@ void UGameFeatureAction_AddWidgets::AddWidgets(AActor* Actor, FPerContextData& A
 		}
 
 		UUIExtensionSubsystem* ExtensionSubsystem = HUD->GetWorld()->GetSubsystem<UUIExtensionSubsystem>();
+
+		// Let each extension point hear about all of our widgets at once
+		FUIExtensionBatchScope ExtensionBatch(ExtensionSubsystem);
 		for (const FLyraHUDElementEntry& Entry : Widgets)
 		{
 			ActiveData.ExtensionHandles.Add(ExtensionSubsystem->RegisterExtensionAsWidgetForContext(Entry.SlotID, LocalPlayer, Entry.WidgetClass.Get(), -1));
@@ -161,9 +164,16 @@ void UGameFeatureAction_AddWidgets::RemoveWidgets(AActor* Actor, FPerContextData
 	}
 	ActiveData.LayoutsAdded.Reset();
 	
-	for (FUIExtensionHandle& Handle : ActiveData.ExtensionHandles)
+	if (UUIExtensionSubsystem* ExtensionSubsystem = HUD->GetWorld()->GetSubsystem<UUIExtensionSubsystem>())
 	{
-		Handle.Unregister();
+		ExtensionSubsystem->UnregisterExtensions(ActiveData.ExtensionHandles);
+	}
+	else
+	{
+		for (FUIExtensionHandle& Handle : ActiveData.ExtensionHandles)
+		{
+			Handle.Unregister();
+		}
 	}
 	ActiveData.ExtensionHandles.Reset();
 }
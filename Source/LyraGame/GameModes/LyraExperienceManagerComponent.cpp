@@ -7,13 +7,15 @@
 #include "LyraExperienceManager.h"
 #include "GameFeaturesSubsystem.h"
 #include "System/LyraAssetManager.h"
+#include "System/LyraSyncLoadProfiler.h"
 #include "GameFeatureAction.h"
 #include "GameFeaturesSubsystemSettings.h"
 #include "TimerManager.h"
 #include "Settings/LyraSettingsLocal.h"
+#include "AbilitySystem/LyraGameplayCueManager.h"
 #include "LyraLogChannels.h"
+#include "ProfilingDebugging/MiscTrace.h"
 
-//@TODO: Async load the experience definition itself
 //@TODO: Handle failures explicitly (go into a 'completed but failed' state rather than check()-ing)
 //@TODO: Do the action phases at the appropriate times instead of all at once
 //@TODO: Support deactivating an experience and do the unloading actions
@@ -42,6 +44,25 @@ namespace LyraConsoleVariables
 	{
 		return FMath::Max(0.0f, ExperienceLoadRandomDelayMin + FMath::FRand() * ExperienceLoadRandomDelayRange);
 	}
+
+	bool HasExperienceLoadDelay()
+	{
+		return (ExperienceLoadRandomDelayMin > 0.0f) || (ExperienceLoadRandomDelayRange > 0.0f);
+	}
+
+	static bool bPipelinedExperienceLoad = true;
+	static FAutoConsoleVariableRef CVarPipelinedExperienceLoad(
+		TEXT("lyra.Experience.PipelinedLoad"),
+		bPipelinedExperienceLoad,
+		TEXT("If true, the experience definition is loaded asynchronously, game feature plugins load while the experience bundles stream in, and action lists activate as soon as their plugins are ready"),
+		ECVF_Default);
+
+	static bool bPreloadLearnedAssets = true;
+	static FAutoConsoleVariableRef CVarPreloadLearnedAssets(
+		TEXT("lyra.Experience.PreloadLearnedAssets"),
+		bPreloadLearnedAssets,
+		TEXT("If true, assets that were synchronously loaded while playing an experience on earlier runs are streamed in (without blocking) when it loads (see lyra.SyncLoads.LearnPreloads)"),
+		ECVF_Default);
 }
 
 ULyraExperienceManagerComponent::ULyraExperienceManagerComponent(const FObjectInitializer& ObjectInitializer)
@@ -53,6 +74,35 @@ ULyraExperienceManagerComponent::ULyraExperienceManagerComponent(const FObjectIn
 #if WITH_SERVER_CODE
 void ULyraExperienceManagerComponent::ServerSetCurrentExperience(FPrimaryAssetId ExperienceId)
 {
+	check(CurrentExperience == nullptr);
+	check(LoadState == ELyraExperienceLoadState::Unloaded);
+
+	LoadStartTime = FPlatformTime::Seconds();
+	LoadState = ELyraExperienceLoadState::LoadingDefinition;
+
+	ULyraAssetManager& AssetManager = ULyraAssetManager::Get();
+	FSoftObjectPath AssetPath = AssetManager.GetPrimaryAssetPath(ExperienceId);
+
+	// Stream the definition in rather than blocking on it, unless it is already in memory
+	if (LyraConsoleVariables::bPipelinedExperienceLoad && (AssetPath.ResolveObject() == nullptr))
+	{
+		RecordLoadTimelineEvent(FString::Printf(TEXT("Loading definition %s"), *ExperienceId.ToString()));
+		AssetManager.GetStreamableManager().RequestAsyncLoad(AssetPath, FStreamableDelegate::CreateUObject(this, &ThisClass::OnExperienceDefinitionLoaded, ExperienceId), FStreamableManager::AsyncLoadHighPriority);
+	}
+	else
+	{
+		OnExperienceDefinitionLoaded(ExperienceId);
+	}
+}
+
+void ULyraExperienceManagerComponent::OnExperienceDefinitionLoaded(FPrimaryAssetId ExperienceId)
+{
+	// We may have ended play while the definition was loading
+	if (LoadState != ELyraExperienceLoadState::LoadingDefinition)
+	{
+		return;
+	}
+
 	ULyraAssetManager& AssetManager = ULyraAssetManager::Get();
 	FSoftObjectPath AssetPath = AssetManager.GetPrimaryAssetPath(ExperienceId);
 	TSubclassOf<ULyraExperienceDefinition> AssetClass = Cast<UClass>(AssetPath.TryLoad());
@@ -134,13 +184,27 @@ void ULyraExperienceManagerComponent::OnRep_CurrentExperience()
 void ULyraExperienceManagerComponent::StartExperienceLoad()
 {
 	check(CurrentExperience != nullptr);
-	check(LoadState == ELyraExperienceLoadState::Unloaded);
+	check((LoadState == ELyraExperienceLoadState::Unloaded) || (LoadState == ELyraExperienceLoadState::LoadingDefinition));
 
 	UE_LOG(LogLyraExperience, Log, TEXT("EXPERIENCE: StartExperienceLoad(CurrentExperience = %s, %s)"),
 		*CurrentExperience->GetPrimaryAssetId().ToString(),
 		*GetClientServerContextString(this));
 
+	if (LoadState == ELyraExperienceLoadState::Unloaded)
+	{
+		LoadStartTime = FPlatformTime::Seconds();
+	}
+
 	LoadState = ELyraExperienceLoadState::Loading;
+	bPipelinedLoad = LyraConsoleVariables::bPipelinedExperienceLoad;
+	bExperienceAssetsLoaded = false;
+	NumActionListsActivated = 0;
+	ReadyGameFeaturePluginURLs.Reset();
+
+	RecordLoadTimelineEvent(TEXT("Loading experience assets"));
+
+	// Sync loads from here on count towards this experience's learned preloads
+	FLyraSyncLoadProfiler::Get().SetCurrentExperience(GetWorld(), CurrentExperience->GetPrimaryAssetId());
 
 	ULyraAssetManager& AssetManager = ULyraAssetManager::Get();
 
@@ -188,6 +252,12 @@ void ULyraExperienceManagerComponent::StartExperienceLoad()
 		Handle = BundleLoadHandle.IsValid() ? BundleLoadHandle : RawLoadHandle;
 	}
 
+	// The plugin list only needs the definition and its action sets, which are loaded already, so the plugins can load while the bundles stream
+	if (bPipelinedLoad)
+	{
+		StartLoadingGameFeaturePlugins();
+	}
+
 	FStreamableDelegate OnAssetsLoadedDelegate = FStreamableDelegate::CreateUObject(this, &ThisClass::OnExperienceLoadComplete);
 	if (!Handle.IsValid() || Handle->HasLoadCompleted())
 	{
@@ -211,6 +281,18 @@ void ULyraExperienceManagerComponent::StartExperienceLoad()
 	{
 		AssetManager.ChangeBundleStateForPrimaryAssets(PreloadAssetList.Array(), BundlesToLoad, {});
 	}
+
+	// Assets that earlier runs of this experience had to sync load, also not blocking (the handle keeps them in memory until the experience ends)
+	if (LyraConsoleVariables::bPreloadLearnedAssets)
+	{
+		TArray<FSoftObjectPath> LearnedPreloads;
+		FLyraSyncLoadProfiler::Get().GetLearnedPreloads(CurrentExperience->GetPrimaryAssetId(), /*out*/ LearnedPreloads);
+		if (LearnedPreloads.Num() > 0)
+		{
+			RecordLoadTimelineEvent(FString::Printf(TEXT("Preloading %d learned assets"), LearnedPreloads.Num()));
+			LearnedPreloadHandle = AssetManager.LoadAssetList(LearnedPreloads, FStreamableDelegate(), FStreamableManager::DefaultAsyncLoadPriority, TEXT("LearnedPreloads"));
+		}
+	}
 }
 
 void ULyraExperienceManagerComponent::OnExperienceLoadComplete()
@@ -222,22 +304,45 @@ void ULyraExperienceManagerComponent::OnExperienceLoadComplete()
 		*CurrentExperience->GetPrimaryAssetId().ToString(),
 		*GetClientServerContextString(this));
 
+	RecordLoadTimelineEvent(TEXT("Experience assets loaded"));
+	bExperienceAssetsLoaded = true;
+
+	if (!bPipelinedLoad)
+	{
+		StartLoadingGameFeaturePlugins();
+	}
+
+	if ((LoadState == ELyraExperienceLoadState::Loading) && (NumGameFeaturePluginsLoading > 0))
+	{
+		LoadState = ELyraExperienceLoadState::LoadingGameFeatures;
+	}
+
+	ActivateReadyActionLists();
+}
+
+void ULyraExperienceManagerComponent::StartLoadingGameFeaturePlugins()
+{
 	// find the URLs for our GameFeaturePlugins - filtering out dupes and ones that don't have a valid mapping
 	// 为 GameFeaturePlugins 找到 URLs - 过滤掉重复的和无效的映射
 	GameFeaturePluginURLs.Reset();
+	ActionListPluginURLs.Reset();
 
 	auto CollectGameFeaturePluginURLs = [This=this](const UPrimaryDataAsset* Context, const TArray<FString>& FeaturePluginList)
 	{
+		// Each action list waits on the plugins its owner asked for
+		TArray<FString>& ActionListURLs = This->ActionListPluginURLs.AddDefaulted_GetRef();
+
 		for (const FString& PluginName : FeaturePluginList)
 		{
 			FString PluginURL;
 			if (UGameFeaturesSubsystem::Get().GetPluginURLForBuiltInPluginByName(PluginName, /*out*/ PluginURL))
 			{
 				This->GameFeaturePluginURLs.AddUnique(PluginURL);
+				ActionListURLs.AddUnique(PluginURL);
 			}
 			else
 			{
-				ensureMsgf(false, TEXT("OnExperienceLoadComplete failed to find plugin URL from PluginName %s for experience %s - fix data, ignoring for this run"), *PluginName, *Context->GetPrimaryAssetId().ToString());
+				ensureMsgf(false, TEXT("StartLoadingGameFeaturePlugins failed to find plugin URL from PluginName %s for experience %s - fix data, ignoring for this run"), *PluginName, *Context->GetPrimaryAssetId().ToString());
 			}
 		}
 
@@ -263,25 +368,53 @@ void ULyraExperienceManagerComponent::OnExperienceLoadComplete()
 
 	// Load and activate the features	
 	NumGameFeaturePluginsLoading = GameFeaturePluginURLs.Num();
-	if (NumGameFeaturePluginsLoading > 0)
-	{
-		LoadState = ELyraExperienceLoadState::LoadingGameFeatures;
-		for (const FString& PluginURL : GameFeaturePluginURLs)
-		{
-			ULyraExperienceManager::NotifyOfPluginActivation(PluginURL);
-			UGameFeaturesSubsystem::Get().LoadAndActivateGameFeaturePlugin(PluginURL, FGameFeaturePluginLoadComplete::CreateUObject(this, &ThisClass::OnGameFeaturePluginLoadComplete));
-		}
-	}
-	else
+	for (const FString& PluginURL : GameFeaturePluginURLs)
 	{
-		OnExperienceFullLoadCompleted();
+		RecordLoadTimelineEvent(FString::Printf(TEXT("Loading plugin %s"), *PluginURL));
+		ULyraExperienceManager::NotifyOfPluginActivation(PluginURL);
+		UGameFeaturesSubsystem::Get().LoadAndActivateGameFeaturePlugin(PluginURL, FGameFeaturePluginLoadComplete::CreateUObject(this, &ThisClass::OnGameFeaturePluginLoadComplete, PluginURL));
 	}
 }
 
-void ULyraExperienceManagerComponent::OnGameFeaturePluginLoadComplete(const UE::GameFeatures::FResult& Result)
+void ULyraExperienceManagerComponent::OnGameFeaturePluginLoadComplete(const UE::GameFeatures::FResult& Result, FString PluginURL)
 {
 	// decrement the number of plugins that are loading
 	NumGameFeaturePluginsLoading--;
+	ReadyGameFeaturePluginURLs.Add(PluginURL);
+
+	RecordLoadTimelineEvent(FString::Printf(TEXT("Plugin ready %s%s"), *PluginURL, Result.HasError() ? TEXT(" (failed)") : TEXT("")));
+
+	ActivateReadyActionLists();
+}
+
+void ULyraExperienceManagerComponent::ActivateReadyActionLists()
+{
+	// Nothing to do if we're not waiting on loads (e.g., a plugin finished after we ended play)
+	if ((LoadState != ELyraExperienceLoadState::Loading) && (LoadState != ELyraExperienceLoadState::LoadingGameFeatures))
+	{
+		return;
+	}
+
+	if (!bExperienceAssetsLoaded)
+	{
+		return;
+	}
+
+	// Activate the action lists in order as soon as the plugins each one needs are ready, instead of waiting for every plugin.
+	// The chaos testing delay is meant to hold back all of the actions, so don't start any early when it is on.
+	if (bPipelinedLoad && !LyraConsoleVariables::HasExperienceLoadDelay())
+	{
+		while (ActionListPluginURLs.IsValidIndex(NumActionListsActivated))
+		{
+			const bool bPluginsReady = !ActionListPluginURLs[NumActionListsActivated].ContainsByPredicate([this](const FString& PluginURL) { return !ReadyGameFeaturePluginURLs.Contains(PluginURL); });
+			if (!bPluginsReady)
+			{
+				break;
+			}
+
+			ActivateNextActionList();
+		}
+	}
 
 	if (NumGameFeaturePluginsLoading == 0)
 	{
@@ -310,7 +443,46 @@ void ULyraExperienceManagerComponent::OnExperienceFullLoadCompleted()
 
 	LoadState = ELyraExperienceLoadState::ExecutingActions;
 
-	// Execute the actions
+	// Execute the actions that haven't been activated early
+	TArray<const TArray<UGameFeatureAction*>*> ActionLists;
+	GetActionLists(ActionLists);
+	while (NumActionListsActivated < ActionLists.Num())
+	{
+		ActivateNextActionList();
+	}
+
+	LoadState = ELyraExperienceLoadState::Loaded;
+	RecordLoadTimelineEvent(TEXT("Experience loaded"));
+
+	OnExperienceLoaded_HighPriority.Broadcast(CurrentExperience);
+	OnExperienceLoaded_HighPriority.Clear();
+
+	OnExperienceLoaded.Broadcast(CurrentExperience);
+	OnExperienceLoaded.Clear();
+
+	OnExperienceLoaded_LowPriority.Broadcast(CurrentExperience);
+	OnExperienceLoaded_LowPriority.Clear();
+
+	// Apply any necessary scalability settings
+#if !UE_SERVER
+	ULyraSettingsLocal::Get()->OnExperienceLoaded();
+
+	// Get the cues this experience can trigger loading before they are first used
+	if (ULyraGameplayCueManager* GameplayCueManager = ULyraGameplayCueManager::Get())
+	{
+		GameplayCueManager->PreloadCuesForExperience(CurrentExperience);
+	}
+#endif
+}
+
+void ULyraExperienceManagerComponent::ActivateNextActionList()
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(ULyraExperienceManagerComponent::ActivateNextActionList);
+
+	TArray<const TArray<UGameFeatureAction*>*> ActionLists;
+	GetActionLists(ActionLists);
+	check(ActionLists.IsValidIndex(NumActionListsActivated));
+
 	FGameFeatureActivatingContext Context;
 
 	// Only apply to our specific world context if set
@@ -320,46 +492,42 @@ void ULyraExperienceManagerComponent::OnExperienceFullLoadCompleted()
 		Context.SetRequiredWorldContextHandle(ExistingWorldContext->ContextHandle);
 	}
 
-	auto ActivateListOfActions = [&Context](const TArray<UGameFeatureAction*>& ActionList)
+	for (UGameFeatureAction* Action : *ActionLists[NumActionListsActivated])
 	{
-		for (UGameFeatureAction* Action : ActionList)
+		if (Action != nullptr)
 		{
-			if (Action != nullptr)
-			{
-				//@TODO: The fact that these don't take a world are potentially problematic in client-server PIE
-				// The current behavior matches systems like gameplay tags where loading and registering apply to the entire process,
-				// but actually applying the results to actors is restricted to a specific world
-				Action->OnGameFeatureRegistering();
-				Action->OnGameFeatureLoading();
-				Action->OnGameFeatureActivating(Context);
-			}
+			//@TODO: The fact that these don't take a world are potentially problematic in client-server PIE
+			// The current behavior matches systems like gameplay tags where loading and registering apply to the entire process,
+			// but actually applying the results to actors is restricted to a specific world
+			Action->OnGameFeatureRegistering();
+			Action->OnGameFeatureLoading();
+			Action->OnGameFeatureActivating(Context);
 		}
-	};
+	}
+
+	++NumActionListsActivated;
+	RecordLoadTimelineEvent(FString::Printf(TEXT("Activated action list %d of %d"), NumActionListsActivated, ActionLists.Num()));
+}
+
+void ULyraExperienceManagerComponent::GetActionLists(TArray<const TArray<UGameFeatureAction*>*>& OutActionLists) const
+{
+	check(CurrentExperience != nullptr);
 
-	ActivateListOfActions(CurrentExperience->Actions);
+	OutActionLists.Add(&CurrentExperience->Actions);
 	for (const TObjectPtr<ULyraExperienceActionSet>& ActionSet : CurrentExperience->ActionSets)
 	{
 		if (ActionSet != nullptr)
 		{
-			ActivateListOfActions(ActionSet->Actions);
+			OutActionLists.Add(&ActionSet->Actions);
 		}
 	}
+}
 
-	LoadState = ELyraExperienceLoadState::Loaded;
-
-	OnExperienceLoaded_HighPriority.Broadcast(CurrentExperience);
-	OnExperienceLoaded_HighPriority.Clear();
-
-	OnExperienceLoaded.Broadcast(CurrentExperience);
-	OnExperienceLoaded.Clear();
-
-	OnExperienceLoaded_LowPriority.Broadcast(CurrentExperience);
-	OnExperienceLoaded_LowPriority.Clear();
-
-	// Apply any necessary scalability settings
-#if !UE_SERVER
-	ULyraSettingsLocal::Get()->OnExperienceLoaded();
-#endif
+void ULyraExperienceManagerComponent::RecordLoadTimelineEvent(const FString& Event) const
+{
+	const double ElapsedSeconds = (LoadStartTime > 0.0) ? (FPlatformTime::Seconds() - LoadStartTime) : 0.0;
+	UE_LOG(LogLyraExperience, Log, TEXT("EXPERIENCE: [+%.3fs] %s (%s)"), ElapsedSeconds, *Event, *GetClientServerContextString(this));
+	TRACE_BOOKMARK(TEXT("Experience: %s"), *Event);
 }
 
 void ULyraExperienceManagerComponent::OnActionDeactivationCompleted()
@@ -394,8 +562,23 @@ void ULyraExperienceManagerComponent::EndPlay(const EEndPlayReason::Type EndPlay
 		}
 	}
 
+	// Save what this run learned and let go of the learned preloads
+	FLyraSyncLoadProfiler::Get().SetCurrentExperience(GetWorld(), FPrimaryAssetId());
+	if (LearnedPreloadHandle.IsValid())
+	{
+		LearnedPreloadHandle->ReleaseHandle();
+		LearnedPreloadHandle.Reset();
+	}
+
+	// Drop the definition load if it hasn't finished yet
+	if (LoadState == ELyraExperienceLoadState::LoadingDefinition)
+	{
+		LoadState = ELyraExperienceLoadState::Unloaded;
+	}
+
 	//@TODO: Ensure proper handling of a partially-loaded state too
-	if (LoadState == ELyraExperienceLoadState::Loaded)
+	// (action lists that were activated early while the rest of the experience was loading get deactivated below)
+	if ((LoadState == ELyraExperienceLoadState::Loaded) || (NumActionListsActivated > 0))
 	{
 		LoadState = ELyraExperienceLoadState::Deactivating;
 
@@ -424,14 +607,13 @@ void ULyraExperienceManagerComponent::EndPlay(const EEndPlayReason::Type EndPlay
 			}
 		};
 
-		DeactivateListOfActions(CurrentExperience->Actions);
-		for (const TObjectPtr<ULyraExperienceActionSet>& ActionSet : CurrentExperience->ActionSets)
+		TArray<const TArray<UGameFeatureAction*>*> ActionLists;
+		GetActionLists(ActionLists);
+		for (int32 ActionListIndex = 0; ActionListIndex < NumActionListsActivated; ++ActionListIndex)
 		{
-			if (ActionSet != nullptr)
-			{
-				DeactivateListOfActions(ActionSet->Actions);
-			}
+			DeactivateListOfActions(*ActionLists[ActionListIndex]);
 		}
+		NumActionListsActivated = 0;
 
 		NumExpectedPausers = Context.GetNumPausers();
 
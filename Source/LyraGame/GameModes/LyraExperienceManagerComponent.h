@@ -10,12 +10,15 @@
 #include "LyraExperienceManagerComponent.generated.h"
 
 class ULyraExperienceDefinition;
+class UGameFeatureAction;
+struct FStreamableHandle;
 
 DECLARE_MULTICAST_DELEGATE_OneParam(FOnLyraExperienceLoaded, const ULyraExperienceDefinition* /*Experience*/);
 
 enum class ELyraExperienceLoadState
 {
 	Unloaded,
+	LoadingDefinition,
 	Loading,
 	LoadingGameFeatures,
 	LoadingChaosTestingDelay,
@@ -79,15 +82,33 @@ private:
 	UFUNCTION()
 	void OnRep_CurrentExperience();
 
+#if WITH_SERVER_CODE
+	// Called once the experience definition has streamed in
+	void OnExperienceDefinitionLoaded(FPrimaryAssetId ExperienceId);
+#endif
+
 	// 开始加载体验
 	void StartExperienceLoad();
 	// 体验加载完成
 	void OnExperienceLoadComplete();
+	// Finds the plugins the experience and its action sets need and starts loading and activating them
+	void StartLoadingGameFeaturePlugins();
 	// 加载游戏特性完成
-	void OnGameFeaturePluginLoadComplete(const UE::GameFeatures::FResult& Result);
+	void OnGameFeaturePluginLoadComplete(const UE::GameFeatures::FResult& Result, FString PluginURL);
+	// Activates the action lists whose assets and plugins are ready, finishing the load once everything is
+	void ActivateReadyActionLists();
 	// 游戏体验完全加载
 	void OnExperienceFullLoadCompleted();
 
+	// Activates the next action list (the experience's own actions first, then each action set in order)
+	void ActivateNextActionList();
+
+	// Returns the action lists of the experience in activation order
+	void GetActionLists(TArray<const TArray<UGameFeatureAction*>*>& OutActionLists) const;
+
+	// Logs a point in the experience load, and adds it to the trace timeline
+	void RecordLoadTimelineEvent(const FString& Event) const;
+
 	// 行动取消完成
 	void OnActionDeactivationCompleted();
 	// 所有行动取消完成
@@ -106,6 +127,27 @@ private:
 	// 游戏特性的 URL 路径 - 本地的话，为文件的相对路径
 	TArray<FString> GameFeaturePluginURLs;
 
+	// The plugins each action list needs, in the same order as GetActionLists
+	TArray<TArray<FString>> ActionListPluginURLs;
+
+	// Plugins that have finished loading and activating
+	TSet<FString> ReadyGameFeaturePluginURLs;
+
+	// How many of the action lists have been activated so far
+	int32 NumActionListsActivated = 0;
+
+	// Whether the experience's bundles have finished streaming in
+	bool bExperienceAssetsLoaded = false;
+
+	// Whether plugin loads and action activation overlap with the bundle streaming for this load
+	bool bPipelinedLoad = false;
+
+	// When the load started, for the timeline
+	double LoadStartTime = 0.0;
+
+	// Keeps the assets learned by FLyraSyncLoadProfiler for this experience in memory
+	TSharedPtr<FStreamableHandle> LearnedPreloadHandle;
+
 	// 暂停的观察者的数量
 	int32 NumObservedPausers = 0;
 	// 期望的暂停的观察者的数量
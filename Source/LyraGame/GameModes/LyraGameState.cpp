@@ -6,9 +6,22 @@
 #include "GameModes/LyraExperienceManagerComponent.h"
 #include "GameFramework/PlayerState.h"
 #include "GameFramework/GameplayMessageSubsystem.h"
+#include "Player/LyraPlayerState.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
 
 extern ENGINE_API float GAverageFPS;
 
+namespace LyraGameStateCVars
+{
+	static bool bBudgetedVerbMessageReplication = true;
+	static FAutoConsoleVariableRef CVarBudgetedVerbMessageReplication(
+		TEXT("lyra.VerbMessages.BudgetedReplication"),
+		bBudgetedVerbMessageReplication,
+		TEXT("Should MulticastReliableMessageToClients go through each relevant player's budgeted verb message replication instead of a reliable multicast"),
+		ECVF_Default);
+}
+
 
 ALyraGameState::ALyraGameState(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
@@ -85,7 +98,36 @@ void ALyraGameState::MulticastMessageToClients_Implementation(const FLyraVerbMes
 	}
 }
 
-void ALyraGameState::MulticastReliableMessageToClients_Implementation(const FLyraVerbMessage Message)
+void ALyraGameState::MulticastReliableMessageToClients(const FLyraVerbMessage Message)
+{
+	if (!HasAuthority())
+	{
+		// Same as a multicast called on a client, it only runs locally
+		MulticastMessageToClients_Implementation(Message);
+	}
+	else if (!LyraGameStateCVars::bBudgetedVerbMessageReplication)
+	{
+		MulticastReliableMessageToAllClients(Message);
+	}
+	else
+	{
+		for (FConstPlayerControllerIterator Iterator = GetWorld()->GetPlayerControllerIterator(); Iterator; ++Iterator)
+		{
+			APlayerController* PC = Iterator->Get();
+
+			// Like the multicast, this doesn't broadcast to local players on the server
+			if ((PC != nullptr) && !PC->IsLocalController() && FLyraVerbMessageReplication::IsMessageRelevantTo(Message, PC))
+			{
+				if (ALyraPlayerState* LyraPS = PC->GetPlayerState<ALyraPlayerState>())
+				{
+					LyraPS->AddReplicatedVerbMessage(Message);
+				}
+			}
+		}
+	}
+}
+
+void ALyraGameState::MulticastReliableMessageToAllClients_Implementation(const FLyraVerbMessage Message)
 {
 	MulticastMessageToClients_Implementation(Message);
 }
\ No newline at end of file
@@ -59,9 +59,16 @@ public:
 	// (use only for client notifications that cannot handle being lost)
 	// 发送一个全部客户端都会获得的消息
 	// （用于客户端通知，例如消灭，服务器加入消息，等等，不能处理丢失）
-	UFUNCTION(NetMulticast, Reliable, BlueprintCallable, Category = "Lyra|GameState")
+	// When lyra.VerbMessages.BudgetedReplication is set this goes through each relevant player's verb message replication
+	// instead (see ALyraPlayerState::AddReplicatedVerbMessage), which never drops a message but may hold it back for the byte budget
+	UFUNCTION(BlueprintCallable, Category = "Lyra|GameState")
 	void MulticastReliableMessageToClients(const FLyraVerbMessage Message);
 
+private:
+	// The reliable multicast MulticastReliableMessageToClients uses when budgeted replication is off
+	UFUNCTION(NetMulticast, Reliable)
+	void MulticastReliableMessageToAllClients(const FLyraVerbMessage Message);
+
 private:
 	UPROPERTY()
 	ULyraExperienceManagerComponent* ExperienceManagerComponent;
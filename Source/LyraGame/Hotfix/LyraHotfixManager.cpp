@@ -14,9 +14,28 @@
 #include "Settings/LyraSettingsLocal.h"
 #include "TimerManager.h"
 #include "HAL/MemoryMisc.h"
+#include "HAL/IConsoleManager.h"
+#include "UObject/SoftObjectPath.h"
 
 int32 ULyraHotfixManager::GameHotfixCounter = 0;
 
+namespace LyraHotfixManagerCVars
+{
+	static bool bIncrementalAssetPatching = true;
+	static FAutoConsoleVariableRef CVarIncrementalAssetPatching(
+		TEXT("Lyra.Hotfix.IncrementalAssetPatching"),
+		bIncrementalAssetPatching,
+		TEXT("If true, only the assets whose AssetHotfix entries changed since the last hotfix are patched, spread across frames"),
+		ECVF_Default);
+
+	static float AssetPatchBudgetMs = 2.0f;
+	static FAutoConsoleVariableRef CVarAssetPatchBudgetMs(
+		TEXT("Lyra.Hotfix.AssetPatchBudgetMs"),
+		AssetPatchBudgetMs,
+		TEXT("How many milliseconds per frame can be spent patching assets from the AssetHotfix section (0 patches everything in one frame)"),
+		ECVF_Default);
+}
+
 ULyraHotfixManager::ULyraHotfixManager()
 {
 #if !UE_BUILD_SHIPPING
@@ -63,6 +82,7 @@ void ULyraHotfixManager::OnHotfixCompleted(EHotfixResult HotfixResult)
 ULyraHotfixManager::~ULyraHotfixManager()
 {
 	ClearOnHotfixCompleteDelegate_Handle(HotfixCompleteDelegateHandle);
+	FTSTicker::GetCoreTicker().RemoveTicker(PendingAssetPatchesHandle);
 
 #if !UE_BUILD_SHIPPING
 	FCoreDelegates::OnGetOnScreenMessages.Remove(OnScreenMessageHandle);
@@ -155,8 +175,191 @@ void ULyraHotfixManager::PatchAssetsFromIniFiles()
 	FSharedMemoryTracker::PrintMemoryDiff(TEXT("Start - PatchAssetsFromIniFiles"));
 #endif
 
+	// A new pass replaces any that is still in flight, sections it didn't get to are still unapplied so they get picked up again below
+	FTSTicker::GetCoreTicker().RemoveTicker(PendingAssetPatchesHandle);
+	PendingAssetPatchesHandle.Reset();
+	PendingAssetPatches.Reset();
+	NextPendingAssetPatch = 0;
+
+	AssetPatchReport = FLyraHotfixAssetPatchReport();
+	AssetPatchReport.StartTime = FPlatformTime::Seconds();
+
+	if (!LyraHotfixManagerCVars::bIncrementalAssetPatching)
+	{
+		Super::PatchAssetsFromIniFiles();
+
+		// Nothing is known to be applied anymore, so the next incremental pass patches everything
+		AppliedAssetSectionSignatures.Reset();
+		IncrementallyPatchedAssets.Reset();
+
+		AssetPatchReport.NumFrames = 1;
+		AssetPatchReport.PatchSeconds = FPlatformTime::Seconds() - AssetPatchReport.StartTime;
+		FinishAssetPatching();
+		return;
+	}
+
+	// Group the entries by the asset they patch so each asset can be compared against what was last applied to it
+	TMap<FString, int32> AssetPathToSection;
+	TArray<FAssetPatchSection> CurrentSections;
+	if (const FConfigSection* AssetHotfixSection = GConfig->GetSectionPrivate(TEXT("AssetHotfix"), false, true, GGameIni))
+	{
+		for (FConfigSection::TConstIterator It(*AssetHotfixSection); It; ++It)
+		{
+			const FString& DataLine = It.Value().GetValue();
+
+			FString AssetPath;
+			if (!DataLine.Split(TEXT(";"), &AssetPath, nullptr))
+			{
+				AssetPath = DataLine;
+			}
+
+			int32& SectionIndex = AssetPathToSection.FindOrAdd(AssetPath, INDEX_NONE);
+			if (SectionIndex == INDEX_NONE)
+			{
+				SectionIndex = CurrentSections.AddDefaulted();
+				CurrentSections[SectionIndex].AssetPath = AssetPath;
+			}
+
+			FAssetPatchSection& Section = CurrentSections[SectionIndex];
+			Section.Signature += It.Key().ToString() + TEXT("=") + DataLine + TEXT("\n");
+			Section.Entries.Emplace(It.Key(), It.Value());
+		}
+	}
+
+	// Sections that were removed can't be unpatched (the full pass can't either), just forget about them
+	for (auto It = AppliedAssetSectionSignatures.CreateIterator(); It; ++It)
+	{
+		if (!AssetPathToSection.Contains(It.Key()))
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	for (FAssetPatchSection& Section : CurrentSections)
+	{
+		const FString* AppliedSignature = AppliedAssetSectionSignatures.Find(Section.AssetPath);
+		if ((AppliedSignature == nullptr) || (*AppliedSignature != Section.Signature))
+		{
+			PendingAssetPatches.Add(MoveTemp(Section));
+		}
+	}
+
+	AssetPatchReport.NumAssetSections = CurrentSections.Num();
+	AssetPatchReport.NumChangedAssetSections = PendingAssetPatches.Num();
+
+	UE_LOG(LogHotfixManager, Display, TEXT("Patching %d of %d asset sections from AssetHotfix that changed since the last hotfix"), AssetPatchReport.NumChangedAssetSections, AssetPatchReport.NumAssetSections);
+
+	// Patch what fits in this frame right away, so small hotfixes still apply immediately
+	if (TickPendingAssetPatches(0.0f))
+	{
+		PendingAssetPatchesHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &ThisClass::TickPendingAssetPatches));
+	}
+}
+
+bool ULyraHotfixManager::TickPendingAssetPatches(float DeltaTime)
+{
+	const double BudgetSeconds = FMath::Max(LyraHotfixManagerCVars::AssetPatchBudgetMs, 0.0f) / 1000.0;
+	const double FrameStartTime = FPlatformTime::Seconds();
+
+	AssetPatchReport.NumFrames++;
+
+	bool bPatchedThisFrame = false;
+	while (NextPendingAssetPatch < PendingAssetPatches.Num())
+	{
+		const double ElapsedSeconds = FPlatformTime::Seconds() - FrameStartTime;
+		if (bPatchedThisFrame && (BudgetSeconds > 0.0) && (ElapsedSeconds >= BudgetSeconds))
+		{
+			break;
+		}
+
+		// Size the slice from how long sections have been taking, so the base class pass runs as few times as possible
+		const int32 NumRemaining = PendingAssetPatches.Num() - NextPendingAssetPatch;
+		int32 NumToPatch = 1;
+		if (BudgetSeconds <= 0.0)
+		{
+			NumToPatch = NumRemaining;
+		}
+		else if (AverageSecondsPerAssetSection > 0.0)
+		{
+			NumToPatch = FMath::Clamp((int32)((BudgetSeconds - ElapsedSeconds) / AverageSecondsPerAssetSection), 1, NumRemaining);
+		}
+
+		const double SliceStartTime = FPlatformTime::Seconds();
+		PatchAssetSections(NextPendingAssetPatch, NumToPatch);
+		const double SliceSeconds = FPlatformTime::Seconds() - SliceStartTime;
+
+		const double SecondsPerSection = SliceSeconds / NumToPatch;
+		AverageSecondsPerAssetSection = (AverageSecondsPerAssetSection > 0.0) ? (AverageSecondsPerAssetSection + SecondsPerSection) * 0.5 : SecondsPerSection;
+
+		AssetPatchReport.PatchSeconds += SliceSeconds;
+		NextPendingAssetPatch += NumToPatch;
+		bPatchedThisFrame = true;
+	}
+
+	if (NextPendingAssetPatch < PendingAssetPatches.Num())
+	{
+		return true;
+	}
+
+	PendingAssetPatchesHandle.Reset();
+	FinishAssetPatching();
+	return false;
+}
+
+void ULyraHotfixManager::PatchAssetSections(int32 FirstPendingIndex, int32 NumToPatch)
+{
+	FConfigSection* AssetHotfixSection = GConfig->GetSectionPrivate(TEXT("AssetHotfix"), true, false, GGameIni);
+	if (AssetHotfixSection == nullptr)
+	{
+		return;
+	}
+
+	// The base class patches everything in the AssetHotfix section, so hand it only the entries for these assets
+	FConfigSection FullSection = MoveTemp(*AssetHotfixSection);
+	AssetHotfixSection->Empty();
+	for (int32 PendingIndex = FirstPendingIndex; PendingIndex < FirstPendingIndex + NumToPatch; ++PendingIndex)
+	{
+		for (const TPair<FName, FConfigValue>& Entry : PendingAssetPatches[PendingIndex].Entries)
+		{
+			AssetHotfixSection->Add(Entry.Key, Entry.Value);
+		}
+	}
+
 	Super::PatchAssetsFromIniFiles();
 
+	AssetHotfixSection = GConfig->GetSectionPrivate(TEXT("AssetHotfix"), true, false, GGameIni);
+	*AssetHotfixSection = MoveTemp(FullSection);
+
+	for (int32 PendingIndex = FirstPendingIndex; PendingIndex < FirstPendingIndex + NumToPatch; ++PendingIndex)
+	{
+		const FAssetPatchSection& Section = PendingAssetPatches[PendingIndex];
+
+		// Assets that couldn't be found (e.g. their plugin isn't mounted yet) stay unapplied so a later pass retries them
+		if (UObject* PatchedAsset = FSoftObjectPath(Section.AssetPath).ResolveObject())
+		{
+			AppliedAssetSectionSignatures.Add(Section.AssetPath, Section.Signature);
+			IncrementallyPatchedAssets.AddUnique(PatchedAsset);
+			AssetPatchReport.NumAssetsPatched++;
+		}
+		else
+		{
+			AppliedAssetSectionSignatures.Remove(Section.AssetPath);
+		}
+	}
+}
+
+void ULyraHotfixManager::FinishAssetPatching()
+{
+	PendingAssetPatches.Reset();
+	NextPendingAssetPatch = 0;
+
+	AssetPatchReport.EndTime = FPlatformTime::Seconds();
+	AssetPatchReport.bComplete = true;
+
+	UE_LOG(LogHotfixManager, Display, TEXT("Finished patching assets from AssetHotfix: %d of %d asset sections changed, %d assets patched over %d frames, %.2f ms patching (%.2f ms total)"),
+		AssetPatchReport.NumChangedAssetSections, AssetPatchReport.NumAssetSections, AssetPatchReport.NumAssetsPatched, AssetPatchReport.NumFrames,
+		AssetPatchReport.PatchSeconds * 1000.0, (AssetPatchReport.EndTime - AssetPatchReport.StartTime) * 1000.0);
+
 #if ENABLE_SHARED_MEMORY_TRACKER
 	FSharedMemoryTracker::PrintMemoryDiff(TEXT("End - PatchAssetsFromIniFiles"));
 #endif
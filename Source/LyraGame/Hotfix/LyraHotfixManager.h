@@ -12,8 +12,26 @@
 #include "Tickable.h"
 #include "Misc/CoreDelegates.h"
 #include "Containers/Ticker.h"
+#include "Misc/ConfigCacheIni.h"
 #include "LyraHotfixManager.generated.h"
 
+/** Summary of the most recent asset patching pass, see ULyraHotfixManager::PatchAssetsFromIniFiles */
+struct FLyraHotfixAssetPatchReport
+{
+	// Assets referenced by the AssetHotfix section, and how many of them changed since the last pass
+	int32 NumAssetSections = 0;
+	int32 NumChangedAssetSections = 0;
+
+	// Assets that were found and patched
+	int32 NumAssetsPatched = 0;
+
+	int32 NumFrames = 0;
+	double PatchSeconds = 0.0;
+	double StartTime = 0.0;
+	double EndTime = 0.0;
+	bool bComplete = false;
+};
+
 UCLASS()
 class ULyraHotfixManager : public UOnlineHotfixManager
 {
@@ -28,6 +46,9 @@ public:
 
 	void RequestPatchAssetsFromIniFiles();
 
+	/** Returns the report for the current (or most recently finished) asset patching pass */
+	const FLyraHotfixAssetPatchReport& GetLastAssetPatchReport() const { return AssetPatchReport; }
+
 protected:
 	void OnHotfixCompleted(EHotfixResult HotfixResult);
 
@@ -65,6 +86,40 @@ private:
 
 	void Init() override;
 
+	/** Patches some of the pending asset sections, returns true while there are more left */
+	bool TickPendingAssetPatches(float DeltaTime);
+
+	/** Patches the given asset sections by narrowing the AssetHotfix section down to them for the base implementation */
+	void PatchAssetSections(int32 FirstPendingIndex, int32 NumToPatch);
+
+	void FinishAssetPatching();
+
+private:
+	// The AssetHotfix entries for one asset, in the order they appear in the ini
+	struct FAssetPatchSection
+	{
+		FString AssetPath;
+		FString Signature;
+		TArray<TPair<FName, FConfigValue>> Entries;
+	};
+
+	// Signature of each asset section as of the last time it was patched
+	TMap<FString, FString> AppliedAssetSectionSignatures;
+
+	// Changed sections waiting to be patched, and how far through them we are
+	TArray<FAssetPatchSection> PendingAssetPatches;
+	int32 NextPendingAssetPatch = 0;
+
+	// Running average cost of patching one asset section, used to size each frame's slice
+	double AverageSecondsPerAssetSection = 0.0;
+
+	FTSTicker::FDelegateHandle PendingAssetPatchesHandle;
+	FLyraHotfixAssetPatchReport AssetPatchReport;
+
+	// The base class only keeps the assets of its most recent pass alive, so patched assets are kept here across slices
+	UPROPERTY(Transient)
+	TArray<UObject*> IncrementallyPatchedAssets;
+
 private:
 	FTSTicker::FDelegateHandle RequestPatchAssetsHandle;
 	FDelegateHandle HotfixCompleteDelegateHandle;
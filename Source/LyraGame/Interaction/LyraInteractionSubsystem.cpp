@@ -0,0 +1,353 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "LyraInteractionSubsystem.h"
+#include "Interaction/IInteractableTarget.h"
+#include "Interaction/InteractionStatics.h"
+#include "GameFramework/Actor.h"
+#include "GameFramework/Controller.h"
+#include "Engine/World.h"
+#include "TimerManager.h"
+
+namespace LyraInteraction
+{
+	static bool bUseInteractionRegistry = false;
+	static FAutoConsoleVariableRef CVarUseInteractionRegistry(
+		TEXT("lyra.Interaction.UseRegistry"),
+		bUseInteractionRegistry,
+		TEXT("Should nearby-interaction scans use the interactable registry instead of a physics overlap per pawn (only enable it once every interactable registers itself, unregistered ones can't be found)"),
+		ECVF_Default);
+
+	static float GridCellSize = 1000.0f;
+	static FAutoConsoleVariableRef CVarGridCellSize(
+		TEXT("lyra.Interaction.GridCellSize"),
+		GridCellSize,
+		TEXT("Size (in uu) of the cells of the interactable registry grid (takes effect on the next world)"),
+		ECVF_Default);
+
+	static float ScanPassInterval = 0.05f;
+	static FAutoConsoleVariableRef CVarScanPassInterval(
+		TEXT("lyra.Interaction.ScanPassInterval"),
+		ScanPassInterval,
+		TEXT("How often (in seconds) the batched nearby-interaction scan pass runs, each scan still runs at its own rate"),
+		ECVF_Default);
+}
+
+//////////////////////////////////////////////////////////////////////
+
+ULyraInteractionSubsystem::ULyraInteractionSubsystem()
+{
+	CellSize = FMath::Max(LyraInteraction::GridCellSize, 100.0f);
+}
+
+void ULyraInteractionSubsystem::Deinitialize()
+{
+	if (UWorld* World = GetWorld())
+	{
+		World->GetTimerManager().ClearTimer(ScanTimerHandle);
+	}
+
+	Scans.Reset();
+	Grid.Reset();
+	EntryIndexByTarget.Reset();
+	Entries.Empty();
+
+	Super::Deinitialize();
+}
+
+bool ULyraInteractionSubsystem::IsRegistryEnabled()
+{
+	return LyraInteraction::bUseInteractionRegistry;
+}
+
+FIntVector ULyraInteractionSubsystem::GetCell(const FVector& Location) const
+{
+	return FIntVector(
+		FMath::FloorToInt(Location.X / CellSize),
+		FMath::FloorToInt(Location.Y / CellSize),
+		FMath::FloorToInt(Location.Z / CellSize));
+}
+
+void ULyraInteractionSubsystem::AddToGrid(int32 EntryIndex)
+{
+	FInteractableEntry& Entry = Entries[EntryIndex];
+	Entry.Cell = GetCell(Entry.Location);
+	Grid.FindOrAdd(Entry.Cell).Add(EntryIndex);
+}
+
+void ULyraInteractionSubsystem::RemoveFromGrid(int32 EntryIndex)
+{
+	const FIntVector Cell = Entries[EntryIndex].Cell;
+	if (TArray<int32>* CellEntries = Grid.Find(Cell))
+	{
+		CellEntries->RemoveSingleSwap(EntryIndex);
+		if (CellEntries->Num() == 0)
+		{
+			Grid.Remove(Cell);
+		}
+	}
+}
+
+bool ULyraInteractionSubsystem::RefreshEntry(int32 EntryIndex)
+{
+	FInteractableEntry& Entry = Entries[EntryIndex];
+
+	const AActor* TargetActor = Entry.TargetActor.Get();
+	if ((TargetActor == nullptr) || !Entry.TargetObject.IsValid())
+	{
+		return false;
+	}
+
+	Entry.Location = TargetActor->GetActorLocation();
+	Entry.Radius = TargetActor->GetSimpleCollisionRadius();
+	MaxEntryRadius = FMath::Max(MaxEntryRadius, Entry.Radius);
+
+	const FIntVector NewCell = GetCell(Entry.Location);
+	if (NewCell != Entry.Cell)
+	{
+		RemoveFromGrid(EntryIndex);
+		AddToGrid(EntryIndex);
+	}
+
+	return true;
+}
+
+void ULyraInteractionSubsystem::RegisterInteractableTarget(TScriptInterface<IInteractableTarget> Target, bool bCacheOptions)
+{
+	AActor* TargetActor = UInteractionStatics::GetActorFromInteractableTarget(Target);
+	if (TargetActor == nullptr)
+	{
+		return;
+	}
+
+	const FObjectKey TargetKey(Target.GetObject());
+	if (EntryIndexByTarget.Contains(TargetKey))
+	{
+		return;
+	}
+
+	FInteractableEntry NewEntry;
+	NewEntry.Target = Target;
+	NewEntry.TargetKey = TargetKey;
+	NewEntry.TargetObject = Target.GetObject();
+	NewEntry.TargetActor = TargetActor;
+	NewEntry.Location = TargetActor->GetActorLocation();
+	NewEntry.Radius = TargetActor->GetSimpleCollisionRadius();
+	NewEntry.bCacheOptions = bCacheOptions;
+	MaxEntryRadius = FMath::Max(MaxEntryRadius, NewEntry.Radius);
+
+	const int32 EntryIndex = Entries.Add(MoveTemp(NewEntry));
+	EntryIndexByTarget.Add(TargetKey, EntryIndex);
+	AddToGrid(EntryIndex);
+}
+
+void ULyraInteractionSubsystem::UnregisterInteractableTarget(TScriptInterface<IInteractableTarget> Target)
+{
+	int32 EntryIndex = INDEX_NONE;
+	if (EntryIndexByTarget.RemoveAndCopyValue(FObjectKey(Target.GetObject()), /*out*/ EntryIndex))
+	{
+		RemoveFromGrid(EntryIndex);
+		Entries.RemoveAt(EntryIndex);
+	}
+}
+
+void ULyraInteractionSubsystem::NotifyInteractionOptionsChanged(TScriptInterface<IInteractableTarget> Target)
+{
+	if (const int32* EntryIndex = EntryIndexByTarget.Find(FObjectKey(Target.GetObject())))
+	{
+		FInteractableEntry& Entry = Entries[*EntryIndex];
+		Entry.bCachedOptionsValid = false;
+		Entry.CachedOptions.Reset();
+	}
+}
+
+void ULyraInteractionSubsystem::NotifyInteractableTargetMoved(TScriptInterface<IInteractableTarget> Target)
+{
+	if (const int32* EntryIndex = EntryIndexByTarget.Find(FObjectKey(Target.GetObject())))
+	{
+		RefreshEntry(*EntryIndex);
+	}
+}
+
+FLyraInteractionScanHandle ULyraInteractionSubsystem::RegisterScan(AActor* Avatar, float Range, float ScanRate, FLyraInteractionScanResultDelegate Callback)
+{
+	FLyraInteractionScanHandle Handle;
+	if (Avatar == nullptr)
+	{
+		return Handle;
+	}
+
+	FInteractionScan& NewScan = Scans.AddDefaulted_GetRef();
+	NewScan.Id = NextScanId++;
+	NewScan.Avatar = Avatar;
+	NewScan.Range = Range;
+	NewScan.ScanRate = ScanRate;
+	NewScan.NextScanTime = GetWorld()->GetTimeSeconds() + ScanRate;
+	NewScan.Callback = MoveTemp(Callback);
+
+	Handle.Id = NewScan.Id;
+
+	FTimerManager& TimerManager = GetWorld()->GetTimerManager();
+	if (!TimerManager.IsTimerActive(ScanTimerHandle))
+	{
+		TimerManager.SetTimer(ScanTimerHandle, this, &ThisClass::ProcessScans, FMath::Max(LyraInteraction::ScanPassInterval, 0.01f), /*bLoop=*/ true);
+	}
+
+	return Handle;
+}
+
+void ULyraInteractionSubsystem::UnregisterScan(FLyraInteractionScanHandle& Handle)
+{
+	if (Handle.IsValid())
+	{
+		Scans.RemoveAll([Id = Handle.Id](const FInteractionScan& Scan) { return Scan.Id == Id; });
+		Handle.Reset();
+	}
+
+	if (Scans.Num() == 0)
+	{
+		if (UWorld* World = GetWorld())
+		{
+			World->GetTimerManager().ClearTimer(ScanTimerHandle);
+		}
+	}
+}
+
+template <typename FuncType>
+void ULyraInteractionSubsystem::ForEachEntryInRange(const FVector& Location, float Range, FuncType Func) const
+{
+	// Entries are bucketed by their center, so widen the cell range by the largest radius they can reach out with
+	const float CellRange = Range + MaxEntryRadius;
+	const FIntVector MinCell = GetCell(Location - FVector(CellRange));
+	const FIntVector MaxCell = GetCell(Location + FVector(CellRange));
+
+	for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+	{
+		for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+		{
+			for (int32 Z = MinCell.Z; Z <= MaxCell.Z; ++Z)
+			{
+				if (const TArray<int32>* CellEntries = Grid.Find(FIntVector(X, Y, Z)))
+				{
+					for (const int32 EntryIndex : *CellEntries)
+					{
+						const FInteractableEntry& Entry = Entries[EntryIndex];
+
+						// Treat the target as a sphere, approximating the overlap against its collision
+						const float MaxDistance = Range + Entry.Radius;
+						if (FVector::DistSquared(Location, Entry.Location) <= FMath::Square(MaxDistance))
+						{
+							if (!Func(EntryIndex))
+							{
+								return;
+							}
+						}
+					}
+				}
+			}
+		}
+	}
+}
+
+void ULyraInteractionSubsystem::GatherEntryOptions(const FInteractionQuery& Query, FInteractableEntry& Entry, TArray<FInteractionOption>& OutOptions)
+{
+	if (Entry.bCacheOptions)
+	{
+		if (!Entry.bCachedOptionsValid)
+		{
+			Entry.CachedOptions.Reset();
+			FInteractionOptionBuilder InteractionBuilder(Entry.Target, Entry.CachedOptions);
+			Entry.Target->GatherInteractionOptions(Query, InteractionBuilder);
+			Entry.bCachedOptionsValid = true;
+		}
+
+		OutOptions.Append(Entry.CachedOptions);
+	}
+	else
+	{
+		FInteractionOptionBuilder InteractionBuilder(Entry.Target, OutOptions);
+		Entry.Target->GatherInteractionOptions(Query, InteractionBuilder);
+	}
+}
+
+void ULyraInteractionSubsystem::GatherInteractionOptions(const FInteractionQuery& Query, TScriptInterface<IInteractableTarget> Target, TArray<FInteractionOption>& OutOptions)
+{
+	if (const int32* EntryIndex = EntryIndexByTarget.Find(FObjectKey(Target.GetObject())))
+	{
+		GatherEntryOptions(Query, Entries[*EntryIndex], OutOptions);
+	}
+	else if (Target)
+	{
+		FInteractionOptionBuilder InteractionBuilder(Target, OutOptions);
+		Target->GatherInteractionOptions(Query, InteractionBuilder);
+	}
+}
+
+void ULyraInteractionSubsystem::ProcessScans()
+{
+	const double CurrentTime = GetWorld()->GetTimeSeconds();
+
+	bool bAnyScanDue = false;
+	for (const FInteractionScan& Scan : Scans)
+	{
+		bAnyScanDue |= (CurrentTime >= Scan.NextScanTime);
+	}
+
+	if (!bAnyScanDue)
+	{
+		return;
+	}
+
+	// Refresh the grid once for the whole pass, dropping targets that were destroyed without unregistering
+	TArray<int32, TInlineAllocator<8>> StaleEntries;
+	MaxEntryRadius = 0.0f;
+	for (auto It = Entries.CreateConstIterator(); It; ++It)
+	{
+		if (!RefreshEntry(It.GetIndex()))
+		{
+			StaleEntries.Add(It.GetIndex());
+		}
+	}
+
+	for (const int32 StaleIndex : StaleEntries)
+	{
+		EntryIndexByTarget.Remove(Entries[StaleIndex].TargetKey);
+		RemoveFromGrid(StaleIndex);
+		Entries.RemoveAt(StaleIndex);
+	}
+
+	// Callbacks may register or unregister scans, so walk a copy of the ids that are due
+	TArray<int32, TInlineAllocator<16>> DueScanIds;
+	for (FInteractionScan& Scan : Scans)
+	{
+		if (CurrentTime >= Scan.NextScanTime)
+		{
+			Scan.NextScanTime = CurrentTime + Scan.ScanRate;
+			DueScanIds.Add(Scan.Id);
+		}
+	}
+
+	for (const int32 ScanId : DueScanIds)
+	{
+		FInteractionScan* Scan = Scans.FindByPredicate([ScanId](const FInteractionScan& Candidate) { return Candidate.Id == ScanId; });
+		AActor* Avatar = Scan ? Scan->Avatar.Get() : nullptr;
+		if (Avatar == nullptr)
+		{
+			continue;
+		}
+
+		FInteractionQuery InteractionQuery;
+		InteractionQuery.RequestingAvatar = Avatar;
+		InteractionQuery.RequestingController = Cast<AController>(Avatar->GetOwner());
+
+		ScratchOptions.Reset();
+		ForEachEntryInRange(Avatar->GetActorLocation(), Scan->Range, [this, &InteractionQuery](int32 EntryIndex)
+		{
+			GatherEntryOptions(InteractionQuery, Entries[EntryIndex], ScratchOptions);
+			return true;
+		});
+
+		// Copy the delegate, the callback is allowed to unregister its own scan
+		const FLyraInteractionScanResultDelegate Callback = Scan->Callback;
+		Callback.ExecuteIfBound(ScratchOptions);
+	}
+}
@@ -0,0 +1,134 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "Interaction/InteractionOption.h"
+#include "Interaction/InteractionQuery.h"
+
+#include "LyraInteractionSubsystem.generated.h"
+
+class IInteractableTarget;
+
+DECLARE_DELEGATE_OneParam(FLyraInteractionScanResultDelegate, const TArray<FInteractionOption>& /*Options*/);
+
+/** Handle to a nearby-interaction scan registered with ULyraInteractionSubsystem */
+struct FLyraInteractionScanHandle
+{
+	bool IsValid() const { return Id != INDEX_NONE; }
+	void Reset() { Id = INDEX_NONE; }
+
+private:
+	friend class ULyraInteractionSubsystem;
+
+	int32 Id = INDEX_NONE;
+};
+
+/**
+ * ULyraInteractionSubsystem
+ *
+ * World-level registry of interactable targets, bucketed in a uniform spatial grid so that
+ * nearby-interaction scans don't need physics overlaps. All registered scans are serviced in a
+ * single pass on a shared timer, and the options of targets that opt in to caching are only
+ * gathered again once the target calls NotifyInteractionOptionsChanged.
+ *
+ * Only registered targets are visible to registry scans, so lyra.Interaction.UseRegistry is off by default
+ * and should only be enabled once every interactable registers itself on BeginPlay.
+ */
+UCLASS()
+class LYRAGAME_API ULyraInteractionSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	ULyraInteractionSubsystem();
+
+	//~USubsystem interface
+	virtual void Deinitialize() override;
+	//~End of USubsystem interface
+
+	/** Returns true if nearby-interaction scans should use this registry instead of physics overlaps */
+	static bool IsRegistryEnabled();
+
+	/**
+	 * Adds an interactable target to the registry (usually from BeginPlay).
+	 * If bCacheOptions is set, the target's options must not depend on the query, and it must call NotifyInteractionOptionsChanged when they change.
+	 */
+	void RegisterInteractableTarget(TScriptInterface<IInteractableTarget> Target, bool bCacheOptions);
+
+	/** Removes an interactable target from the registry (usually from EndPlay) */
+	void UnregisterInteractableTarget(TScriptInterface<IInteractableTarget> Target);
+
+	/** Invalidates the cached options for a target, they will be gathered again on the next scan that reaches it */
+	void NotifyInteractionOptionsChanged(TScriptInterface<IInteractableTarget> Target);
+
+	/** Notifies the registry that a target moved or changed size, the grid is otherwise only refreshed once per scan pass */
+	void NotifyInteractableTargetMoved(TScriptInterface<IInteractableTarget> Target);
+
+	/** Starts periodically scanning for interaction options within Range of Avatar, the callback receives the options found by each scan */
+	FLyraInteractionScanHandle RegisterScan(AActor* Avatar, float Range, float ScanRate, FLyraInteractionScanResultDelegate Callback);
+
+	/** Stops a scan started by RegisterScan */
+	void UnregisterScan(FLyraInteractionScanHandle& Handle);
+
+	/** Gathers the interaction options of a single target, using the cached options when the target allows it */
+	void GatherInteractionOptions(const FInteractionQuery& Query, TScriptInterface<IInteractableTarget> Target, TArray<FInteractionOption>& OutOptions);
+
+private:
+	struct FInteractableEntry
+	{
+		TScriptInterface<IInteractableTarget> Target;
+		FObjectKey TargetKey;
+		TWeakObjectPtr<UObject> TargetObject;
+		TWeakObjectPtr<AActor> TargetActor;
+		FVector Location = FVector::ZeroVector;
+		float Radius = 0.0f;
+		FIntVector Cell = FIntVector::ZeroValue;
+		bool bCacheOptions = false;
+		bool bCachedOptionsValid = false;
+		TArray<FInteractionOption> CachedOptions;
+	};
+
+	struct FInteractionScan
+	{
+		int32 Id = INDEX_NONE;
+		TWeakObjectPtr<AActor> Avatar;
+		float Range = 0.0f;
+		float ScanRate = 0.0f;
+		double NextScanTime = 0.0;
+		FLyraInteractionScanResultDelegate Callback;
+	};
+
+	FIntVector GetCell(const FVector& Location) const;
+	void AddToGrid(int32 EntryIndex);
+	void RemoveFromGrid(int32 EntryIndex);
+	bool RefreshEntry(int32 EntryIndex);
+
+	template <typename FuncType>
+	void ForEachEntryInRange(const FVector& Location, float Range, FuncType Func) const;
+
+	void GatherEntryOptions(const FInteractionQuery& Query, FInteractableEntry& Entry, TArray<FInteractionOption>& OutOptions);
+
+	void ProcessScans();
+
+private:
+	TSparseArray<FInteractableEntry> Entries;
+	TMap<FObjectKey, int32> EntryIndexByTarget;
+	TMap<FIntVector, TArray<int32>> Grid;
+
+	TArray<FInteractionScan> Scans;
+	int32 NextScanId = 0;
+
+	// Largest collision radius of the registered targets as of the last refresh, widens the cells a query visits
+	float MaxEntryRadius = 0.0f;
+
+	// Grid cell size, latched when the subsystem is created since changing it would invalidate the grid
+	float CellSize = 0.0f;
+
+	// Reused between scans so a pass doesn't reallocate the option list for each avatar
+	TArray<FInteractionOption> ScratchOptions;
+
+	FTimerHandle ScanTimerHandle;
+};
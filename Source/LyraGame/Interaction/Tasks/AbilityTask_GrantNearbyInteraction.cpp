@@ -28,7 +28,18 @@ void UAbilityTask_GrantNearbyInteraction::Activate()
 	SetWaitingOnAvatar();
 
 	UWorld* World = GetWorld();
-	World->GetTimerManager().SetTimer(QueryTimerHandle, this, &ThisClass::QueryInteractables, InteractionScanRate, true);
+
+	// Prefer the batched registry scan, which avoids a physics overlap per pawn
+	ULyraInteractionSubsystem* InteractionSubsystem = UWorld::GetSubsystem<ULyraInteractionSubsystem>(World);
+	if (InteractionSubsystem && ULyraInteractionSubsystem::IsRegistryEnabled())
+	{
+		ScanHandle = InteractionSubsystem->RegisterScan(GetAvatarActor(), InteractionScanRange, InteractionScanRate, FLyraInteractionScanResultDelegate::CreateUObject(this, &ThisClass::OnInteractablesScanned));
+	}
+
+	if (!ScanHandle.IsValid())
+	{
+		World->GetTimerManager().SetTimer(QueryTimerHandle, this, &ThisClass::QueryInteractables, InteractionScanRate, true);
+	}
 }
 
 void UAbilityTask_GrantNearbyInteraction::OnDestroy(bool AbilityEnded)
@@ -37,6 +48,16 @@ void UAbilityTask_GrantNearbyInteraction::OnDestroy(bool AbilityEnded)
 
 	UWorld* World = GetWorld();
 	World->GetTimerManager().ClearTimer(QueryTimerHandle);
+
+	if (ULyraInteractionSubsystem* InteractionSubsystem = UWorld::GetSubsystem<ULyraInteractionSubsystem>(World))
+	{
+		InteractionSubsystem->UnregisterScan(ScanHandle);
+	}
+}
+
+void UAbilityTask_GrantNearbyInteraction::OnInteractablesScanned(const TArray<FInteractionOption>& Options)
+{
+	GrantInteractionAbilities(Options);
 }
 
 void UAbilityTask_GrantNearbyInteraction::QueryInteractables()
@@ -67,20 +88,25 @@ void UAbilityTask_GrantNearbyInteraction::QueryInteractables()
 				InteractiveTarget->GatherInteractionOptions(InteractionQuery, InteractionBuilder);
 			}
 
-			// Check if any of the options need to grant the ability to the user before they can be used.
-			for (FInteractionOption& Option : Options)
+			GrantInteractionAbilities(Options);
+		}
+	}
+}
+
+void UAbilityTask_GrantNearbyInteraction::GrantInteractionAbilities(const TArray<FInteractionOption>& Options)
+{
+	// Check if any of the options need to grant the ability to the user before they can be used.
+	for (const FInteractionOption& Option : Options)
+	{
+		if (Option.InteractionAbilityToGrant)
+		{
+			// Grant the ability to the GAS, otherwise it won't be able to do whatever the interaction is.
+			FObjectKey ObjectKey(Option.InteractionAbilityToGrant);
+			if (!InteractionAbilityCache.Find(ObjectKey))
 			{
-				if (Option.InteractionAbilityToGrant)
-				{
-					// Grant the ability to the GAS, otherwise it won't be able to do whatever the interaction is.
-					FObjectKey ObjectKey(Option.InteractionAbilityToGrant);
-					if (!InteractionAbilityCache.Find(ObjectKey))
-					{
-						FGameplayAbilitySpec Spec(Option.InteractionAbilityToGrant, 1, INDEX_NONE, this);
-						FGameplayAbilitySpecHandle Handle = AbilitySystemComponent->GiveAbility(Spec);
-						InteractionAbilityCache.Add(ObjectKey, Handle);
-					}
-				}
+				FGameplayAbilitySpec Spec(Option.InteractionAbilityToGrant, 1, INDEX_NONE, this);
+				FGameplayAbilitySpecHandle Handle = AbilitySystemComponent->GiveAbility(Spec);
+				InteractionAbilityCache.Add(ObjectKey, Handle);
 			}
 		}
 	}
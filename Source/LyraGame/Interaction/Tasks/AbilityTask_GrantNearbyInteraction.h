@@ -4,6 +4,7 @@
 #include "CoreMinimal.h"
 #include "UObject/ObjectMacros.h"
 #include "Abilities/Tasks/AbilityTask.h"
+#include "Interaction/LyraInteractionSubsystem.h"
 #include "AbilityTask_GrantNearbyInteraction.generated.h"
 
 class AActor;
@@ -26,10 +27,17 @@ private:
 
 	void QueryInteractables();
 
+	// Called by the interaction subsystem's batched scan with the options near our avatar
+	void OnInteractablesScanned(const TArray<FInteractionOption>& Options);
+
+	void GrantInteractionAbilities(const TArray<FInteractionOption>& Options);
+
 	float InteractionScanRange = 100;
 	float InteractionScanRate = 0.100;
 
 	FTimerHandle QueryTimerHandle;
 
+	FLyraInteractionScanHandle ScanHandle;
+
 	TMap<FObjectKey, FGameplayAbilitySpecHandle> InteractionAbilityCache;
 };
@@ -6,6 +6,7 @@
 #include "Interaction/IInteractableTarget.h"
 #include "Interaction/InteractionStatics.h"
 #include "Interaction/InteractionQuery.h"
+#include "Interaction/LyraInteractionSubsystem.h"
 #include "AbilitySystemComponent.h"
 #include "GameFramework/PlayerController.h"
 
@@ -106,11 +107,21 @@ void UAbilityTask_WaitForInteractableTargets::UpdateInteractableOptions(const FI
 {
 	TArray<FInteractionOption> NewOptions;
 
+	ULyraInteractionSubsystem* InteractionSubsystem = UWorld::GetSubsystem<ULyraInteractionSubsystem>(GetWorld());
+
 	for (const TScriptInterface<IInteractableTarget>& InteractiveTarget : InteractableTargets)
 	{
 		TArray<FInteractionOption> TempOptions;
-		FInteractionOptionBuilder InteractionBuilder(InteractiveTarget, TempOptions);
-		InteractiveTarget->GatherInteractionOptions(InteractQuery, InteractionBuilder);
+		if (InteractionSubsystem)
+		{
+			// Uses the target's cached options when it allows it
+			InteractionSubsystem->GatherInteractionOptions(InteractQuery, InteractiveTarget, TempOptions);
+		}
+		else
+		{
+			FInteractionOptionBuilder InteractionBuilder(InteractiveTarget, TempOptions);
+			InteractiveTarget->GatherInteractionOptions(InteractQuery, InteractionBuilder);
+		}
 
 		for (FInteractionOption& Option : TempOptions)
 		{
@@ -2,6 +2,53 @@
 
 #include "LyraVerbMessageReplication.h"
 #include "GameFramework/GameplayMessageSubsystem.h"
+#include "GameFramework/PlayerController.h"
+#include "Components/ActorComponent.h"
+#include "HAL/IConsoleManager.h"
+
+namespace LyraVerbMessageReplication
+{
+	static bool bFilterByRelevancy = true;
+	static FAutoConsoleVariableRef CVarFilterByRelevancy(
+		TEXT("lyra.VerbMessages.FilterByRelevancy"),
+		bFilterByRelevancy,
+		TEXT("Should replicated verb messages only be sent to players their instigator or target is relevant to"),
+		ECVF_Default);
+
+	static int32 BytesPerSecond = 2048;
+	static FAutoConsoleVariableRef CVarBytesPerSecond(
+		TEXT("lyra.VerbMessages.BytesPerSecond"),
+		BytesPerSecond,
+		TEXT("Budget (in estimated bytes per second) for replicated verb messages to each player, messages over budget wait for the next net update (0 = unlimited)"),
+		ECVF_Default);
+
+	static float MaxAge = 5.0f;
+	static FAutoConsoleVariableRef CVarMaxAge(
+		TEXT("lyra.VerbMessages.MaxAge"),
+		MaxAge,
+		TEXT("How long (in seconds) replicated verb messages are kept after they are sent before they are removed (0 = forever)"),
+		ECVF_Default);
+
+	static bool AreSameMessage(const FLyraVerbMessage& A, const FLyraVerbMessage& B)
+	{
+		return (A.Verb == B.Verb) && (A.Instigator == B.Instigator) && (A.Target == B.Target) && (A.Magnitude == B.Magnitude) &&
+			(A.InstigatorTags == B.InstigatorTags) && (A.TargetTags == B.TargetTags) && (A.ContextTags == B.ContextTags);
+	}
+
+	static const AActor* GetMessageActor(const UObject* Object)
+	{
+		if (const AActor* Actor = Cast<const AActor>(Object))
+		{
+			return Actor;
+		}
+		else if (const UActorComponent* Component = Cast<const UActorComponent>(Object))
+		{
+			return Component->GetOwner();
+		}
+
+		return nullptr;
+	}
+}
 
 //////////////////////////////////////////////////////////////////////
 // FLyraVerbMessageReplicationEntry
@@ -11,22 +58,146 @@ FString FLyraVerbMessageReplicationEntry::GetDebugString() const
 	return Message.ToString();
 }
 
+int32 FLyraVerbMessageReplicationEntry::EstimateNetSize() const
+{
+	// Item ID and key, the verb, two object references, the tag containers and the magnitude
+	// (assumes fast replicated tags and packed NetGUIDs, which is what a shipping game would be using)
+	auto GetTagContainerSize = [](const FGameplayTagContainer& Tags) { return 1 + (2 * Tags.Num()); };
+
+	return 4 + 2 + (2 * 4) + GetTagContainerSize(Message.InstigatorTags) + GetTagContainerSize(Message.TargetTags) + GetTagContainerSize(Message.ContextTags) + sizeof(Message.Magnitude);
+}
+
 //////////////////////////////////////////////////////////////////////
 // FLyraVerbMessageReplication
 
 void FLyraVerbMessageReplication::AddMessage(const FLyraVerbMessage& Message)
 {
-	FLyraVerbMessageReplicationEntry& NewStack = CurrentMessages.Emplace_GetRef(Message);
-	MarkItemDirty(NewStack);
+	// Coalesce duplicates raised during the same net update (e.g., several systems reporting the same elimination),
+	// messages still waiting from earlier updates were separate events even if they look the same
+	bool bAlreadyPending = false;
+	for (int32 PendingIndex = FirstPendingMessageThisUpdate; PendingIndex < PendingMessages.Num(); ++PendingIndex)
+	{
+		if (LyraVerbMessageReplication::AreSameMessage(PendingMessages[PendingIndex].Message, Message))
+		{
+			bAlreadyPending = true;
+			break;
+		}
+	}
+
+	if (!bAlreadyPending)
+	{
+		PendingMessages.Emplace(Message);
+	}
+}
+
+void FLyraVerbMessageReplication::FlushPendingMessages(double CurrentTime)
+{
+	// Expire entries that have been replicating for a while so the array stays small, queued messages are never dropped
+	if (LyraVerbMessageReplication::MaxAge > 0.0f)
+	{
+		auto IsExpired = [CurrentTime](const FLyraVerbMessageReplicationEntry& Entry)
+		{
+			return (CurrentTime - Entry.TimeSent) > LyraVerbMessageReplication::MaxAge;
+		};
+
+		if (CurrentMessages.RemoveAll(IsExpired) > 0)
+		{
+			MarkArrayDirty();
+		}
+	}
+
+	// Refill the budget
+	const double BytesPerSecond = (double)LyraVerbMessageReplication::BytesPerSecond;
+	const bool bUnlimitedBudget = (BytesPerSecond <= 0.0);
+	if (!bUnlimitedBudget)
+	{
+		const double TimeSinceLastFlush = (LastFlushTime >= 0.0) ? (CurrentTime - LastFlushTime) : 1.0;
+		AvailableBudgetBytes = FMath::Min(AvailableBudgetBytes + (TimeSinceLastFlush * BytesPerSecond), BytesPerSecond);
+	}
+	LastFlushTime = CurrentTime;
+
+	// Send in order until we run out, a message bigger than a whole second of budget still goes out once the budget is full
+	int32 NumSent = 0;
+	for (; NumSent < PendingMessages.Num(); ++NumSent)
+	{
+		const FLyraVerbMessageReplicationEntry& PendingEntry = PendingMessages[NumSent];
+		const int32 EstimatedSize = PendingEntry.EstimateNetSize();
+
+		if (!bUnlimitedBudget)
+		{
+			if ((AvailableBudgetBytes < EstimatedSize) && (AvailableBudgetBytes < BytesPerSecond))
+			{
+				break;
+			}
+
+			AvailableBudgetBytes -= EstimatedSize;
+		}
+
+		FLyraVerbMessageReplicationEntry& NewEntry = CurrentMessages.Add_GetRef(PendingEntry);
+		NewEntry.TimeSent = CurrentTime;
+		MarkItemDirty(NewEntry);
+
+		RecordBytes(EstimatedSize);
+	}
+
+	PendingMessages.RemoveAt(0, NumSent, /*bAllowShrinking=*/ false);
+	FirstPendingMessageThisUpdate = PendingMessages.Num();
+}
+
+float FLyraVerbMessageReplication::GetBytesPerSecond() const
+{
+	const double TimeInWindow = FPlatformTime::Seconds() - BytesWindowStartTime;
+	if (TimeInWindow >= 2.0)
+	{
+		return 0.0f;
+	}
+
+	return (TimeInWindow >= 1.0) ? (float)BytesInCurrentWindow : (float)BytesInPreviousWindow;
+}
+
+void FLyraVerbMessageReplication::RecordBytes(int32 NumBytes)
+{
+	const double CurrentTime = FPlatformTime::Seconds();
+	const double TimeInWindow = CurrentTime - BytesWindowStartTime;
+	if (TimeInWindow >= 1.0)
+	{
+		BytesInPreviousWindow = (TimeInWindow < 2.0) ? BytesInCurrentWindow : 0;
+		BytesInCurrentWindow = 0;
+		BytesWindowStartTime = CurrentTime;
+	}
+
+	BytesInCurrentWindow += NumBytes;
+}
+
+bool FLyraVerbMessageReplication::IsMessageRelevantTo(const FLyraVerbMessage& Message, const APlayerController* PC)
+{
+	if (!LyraVerbMessageReplication::bFilterByRelevancy || (PC == nullptr))
+	{
+		return true;
+	}
+
+	const AActor* InstigatorActor = LyraVerbMessageReplication::GetMessageActor(Message.Instigator);
+	const AActor* TargetActor = LyraVerbMessageReplication::GetMessageActor(Message.Target);
+
+	// Messages that aren't about anything in the world go to everyone
+	if ((InstigatorActor == nullptr) && (TargetActor == nullptr))
+	{
+		return true;
+	}
+
+	FVector ViewLocation;
+	FRotator ViewRotation;
+	PC->GetPlayerViewPoint(/*out*/ ViewLocation, /*out*/ ViewRotation);
+	const AActor* ViewTarget = PC->GetViewTarget();
+
+	// Player states are always relevant, so messages about players (like eliminations) still reach everyone
+	return ((InstigatorActor != nullptr) && InstigatorActor->IsNetRelevantFor(PC, ViewTarget, ViewLocation)) ||
+		((TargetActor != nullptr) && TargetActor->IsNetRelevantFor(PC, ViewTarget, ViewLocation));
 }
 
 void FLyraVerbMessageReplication::PreReplicatedRemove(const TArrayView<int32> RemovedIndices, int32 FinalSize)
 {
-// 	for (int32 Index : RemovedIndices)
-// 	{
-// 		const FGameplayTag Tag = CurrentMessages[Index].Tag;
-// 		TagToCountMap.Remove(Tag);
-// 	}
+	// Removals are just old messages expiring, they have already been broadcast
 }
 
 void FLyraVerbMessageReplication::PostReplicatedAdd(const TArrayView<int32> AddedIndices, int32 FinalSize)
@@ -34,6 +205,7 @@ void FLyraVerbMessageReplication::PostReplicatedAdd(const TArrayView<int32> Adde
 	for (int32 Index : AddedIndices)
 	{
 		const FLyraVerbMessageReplicationEntry& Entry = CurrentMessages[Index];
+		RecordBytes(Entry.EstimateNetSize());
 		RebroadcastMessage(Entry.Message);
 	}
 }
@@ -7,6 +7,7 @@
 #include "LyraVerbMessage.h"
 #include "LyraVerbMessageReplication.generated.h"
 
+class APlayerController;
 struct FLyraVerbMessageReplication;
 
 /**
@@ -27,14 +28,27 @@ struct FLyraVerbMessageReplicationEntry : public FFastArraySerializerItem
 
 	FString GetDebugString() const;
 
+	// Rough number of bytes this message takes up on the wire, used for the byte budget and stats
+	int32 EstimateNetSize() const;
+
 private:
 	friend FLyraVerbMessageReplication;
 
 	UPROPERTY()
 	FLyraVerbMessage Message;
+
+	// Server time this entry was moved into the replicated array, used to expire it (not replicated)
+	double TimeSent = 0.0;
 };
 
-/** Container of verb messages to replicate */
+/**
+ * Container of verb messages to replicate
+ *
+ * Messages are queued with AddMessage, duplicates queued during the same net update are coalesced, and the owner
+ * calls FlushPendingMessages once per net update to move as many as the byte budget allows into the replicated array.
+ * Queued messages are never dropped, they just wait for budget. Entries are removed from the replicated array once they
+ * have been in it for lyra.VerbMessages.MaxAge, so it only ever holds the last few seconds of messages.
+ */
 USTRUCT(BlueprintType)
 struct FLyraVerbMessageReplication : public FFastArraySerializer
 {
@@ -47,9 +61,18 @@ struct FLyraVerbMessageReplication : public FFastArraySerializer
 public:
 	void SetOwner(UObject* InOwner) { Owner = InOwner; }
 
-	// Broadcasts a message from server to clients
+	// Queues a message to be sent from server to clients on the next net update
 	void AddMessage(const FLyraVerbMessage& Message);
 
+	// Expires old entries and sends as many queued messages as the byte budget allows, call this once per net update
+	void FlushPendingMessages(double CurrentTime);
+
+	// Returns the estimated bytes per second of messages sent (on the server) or received (on clients) over the last second
+	float GetBytesPerSecond() const;
+
+	// Returns true if the instigator or target of the message is relevant to the player (or it has neither), see lyra.VerbMessages.FilterByRelevancy
+	static bool IsMessageRelevantTo(const FLyraVerbMessage& Message, const APlayerController* PC);
+
 	//~FFastArraySerializer contract
 	void PreReplicatedRemove(const TArrayView<int32> RemovedIndices, int32 FinalSize);
 	void PostReplicatedAdd(const TArrayView<int32> AddedIndices, int32 FinalSize);
@@ -64,14 +87,31 @@ public:
 private:
 	void RebroadcastMessage(const FLyraVerbMessage& Message);
 
+	void RecordBytes(int32 NumBytes);
+
 private:
 	// Replicated list of gameplay tag stacks
 	UPROPERTY()
 	TArray<FLyraVerbMessageReplicationEntry> CurrentMessages;
-	
+
 	// Owner (for a route to a world)
 	UPROPERTY()
 	UObject* Owner = nullptr;
+
+	// Messages waiting for the next net update (or for budget), in the order they were added (server only)
+	TArray<FLyraVerbMessageReplicationEntry> PendingMessages;
+
+	// Index of the first pending message added since the last flush, only those are coalesced with new messages
+	int32 FirstPendingMessageThisUpdate = 0;
+
+	// Bytes that can be sent right now, refilled at lyra.VerbMessages.BytesPerSecond up to one second's worth
+	double AvailableBudgetBytes = 0.0;
+	double LastFlushTime = -1.0;
+
+	// Bytes sent or received in the current and previous one second windows
+	double BytesWindowStartTime = 0.0;
+	int32 BytesInCurrentWindow = 0;
+	int32 BytesInPreviousWindow = 0;
 };
 
 template<>
@@ -7,6 +7,7 @@
 #include "Engine/Engine.h"
 #include "Engine/NetConnection.h"
 #include "GameModes/LyraGameState.h"
+#include "Player/LyraPlayerState.h"
 
 //////////////////////////////////////////////////////////////////////
 // FLyraPerformanceStatCache
@@ -26,6 +27,7 @@ void FLyraPerformanceStatCache::ProcessFrame(const FFrameData& FrameData)
 	CachedPacketRateOutgoing = 0.0f;
 	CachedPacketSizeIncoming = 0.0f;
 	CachedPacketSizeOutgoing = 0.0f;
+	CachedVerbMessageBytesIncoming = 0.0f;
 
 	if (UWorld* World = MySubsystem->GetGameInstance()->GetWorld())
 	{
@@ -41,6 +43,11 @@ void FLyraPerformanceStatCache::ProcessFrame(const FFrameData& FrameData)
 				CachedPingMS = PS->GetPingInMilliseconds();
 			}
 
+			if (const ALyraPlayerState* LyraPS = LocalPC->GetPlayerState<ALyraPlayerState>())
+			{
+				CachedVerbMessageBytesIncoming = LyraPS->GetVerbMessageBytesPerSecond();
+			}
+
 			if (UNetConnection* NetConnection = LocalPC->GetNetConnection())
 			{
 				const UNetConnection::FNetConnectionPacketLoss& InLoss = NetConnection->GetInLossPercentage();
@@ -64,7 +71,7 @@ void FLyraPerformanceStatCache::StopCharting()
 
 double FLyraPerformanceStatCache::GetCachedStat(ELyraDisplayablePerformanceStat Stat) const
 {
-	static_assert((int32)ELyraDisplayablePerformanceStat::Count == 15, "Need to update this function to deal with new performance stats");
+	static_assert((int32)ELyraDisplayablePerformanceStat::Count == 16, "Need to update this function to deal with new performance stats");
 	switch (Stat)
 	{
 	case ELyraDisplayablePerformanceStat::ClientFPS:
@@ -97,6 +104,8 @@ double FLyraPerformanceStatCache::GetCachedStat(ELyraDisplayablePerformanceStat
 		return CachedPacketSizeIncoming;
 	case ELyraDisplayablePerformanceStat::PacketSize_Outgoing:
 		return CachedPacketSizeOutgoing;
+	case ELyraDisplayablePerformanceStat::VerbMessageBytes_Incoming:
+		return CachedVerbMessageBytesIncoming;
 	}
 
 	return 0.0f;
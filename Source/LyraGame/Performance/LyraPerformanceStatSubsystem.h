@@ -41,6 +41,7 @@ protected:
 	float CachedPacketRateOutgoing = 0.0f;
 	float CachedPacketSizeIncoming = 0.0f;
 	float CachedPacketSizeOutgoing = 0.0f;
+	float CachedVerbMessageBytesIncoming = 0.0f;
 };
 
 //////////////////////////////////////////////////////////////////////
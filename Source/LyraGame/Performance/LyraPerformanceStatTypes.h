@@ -77,6 +77,9 @@ enum class ELyraDisplayablePerformanceStat : uint8
 	// The avg. size (in bytes) of packets sent
 	PacketSize_Outgoing,
 
+	// The estimated bytes of verb messages replicated to this player in the last second
+	VerbMessageBytes_Incoming,
+
 	// New stats should go above here
 	Count UMETA(Hidden)
 };
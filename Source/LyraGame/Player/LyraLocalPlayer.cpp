@@ -7,6 +7,17 @@
 #include "InputMappingContext.h"
 #include "AudioMixerBlueprintLibrary.h"
 #include "GameFramework/PlayerController.h"
+#include "Async/Async.h"
+
+namespace LyraLocalPlayer
+{
+	static bool bPrefetchSharedSettings = true;
+	static FAutoConsoleVariableRef CVarPrefetchSharedSettings(
+		TEXT("Lyra.Settings.PrefetchSharedSettings"),
+		bPrefetchSharedSettings,
+		TEXT("Should local players start reading their shared settings in the background as soon as they're created?"),
+		ECVF_Default);
+}
 
 ULyraLocalPlayer::ULyraLocalPlayer()
 {
@@ -22,6 +33,27 @@ void ULyraLocalPlayer::PostInitProperties()
 	}
 }
 
+void ULyraLocalPlayer::PlayerAdded(class UGameViewportClient* InViewportClient, int32 InControllerID)
+{
+	Super::PlayerAdded(InViewportClient, InControllerID);
+
+	// Start reading the shared settings now that our player index is known, so they're usually ready by the time anything asks for them
+	if (!SharedSettings && !SharedSettingsReadFuture.IsValid() && LyraLocalPlayer::bPrefetchSharedSettings)
+	{
+		TWeakObjectPtr<ULyraLocalPlayer> WeakThis(this);
+		SharedSettingsReadFuture = ULyraSettingsShared::AsyncReadSettingsData(this, [WeakThis]()
+		{
+			AsyncTask(ENamedThreads::GameThread, [WeakThis]()
+			{
+				if (ULyraLocalPlayer* StrongThis = WeakThis.Get())
+				{
+					StrongThis->FinishLoadingSharedSettings();
+				}
+			});
+		});
+	}
+}
+
 void ULyraLocalPlayer::SwitchController(class APlayerController* PC)
 {
 	Super::SwitchController(PC);
@@ -98,12 +130,50 @@ ULyraSettingsShared* ULyraLocalPlayer::GetSharedSettings() const
 {
 	if (!SharedSettings)
 	{
-		SharedSettings = ULyraSettingsShared::LoadOrCreateSettings(this);
+		if (SharedSettingsReadFuture.IsValid())
+		{
+			// Blocks until the background read is done
+			FinishLoadingSharedSettings();
+		}
+		else
+		{
+			SharedSettings = ULyraSettingsShared::LoadOrCreateSettings(this);
+			OnSharedSettingsLoaded.Broadcast(SharedSettings);
+			OnSharedSettingsLoaded.Clear();
+		}
 	}
 
 	return SharedSettings;
 }
 
+void ULyraLocalPlayer::CallOrRegister_OnSharedSettingsLoaded(FOnLyraSharedSettingsLoaded::FDelegate&& Delegate)
+{
+	if (SharedSettings)
+	{
+		Delegate.Execute(SharedSettings);
+	}
+	else
+	{
+		OnSharedSettingsLoaded.Add(MoveTemp(Delegate));
+	}
+}
+
+void ULyraLocalPlayer::FinishLoadingSharedSettings() const
+{
+	if (SharedSettings || !SharedSettingsReadFuture.IsValid())
+	{
+		return;
+	}
+
+	const TArray<uint8> SaveData = SharedSettingsReadFuture.Get();
+	SharedSettingsReadFuture.Reset();
+
+	SharedSettings = ULyraSettingsShared::CreateSettingsFromData(this, SaveData);
+
+	OnSharedSettingsLoaded.Broadcast(SharedSettings);
+	OnSharedSettingsLoaded.Clear();
+}
+
 void ULyraLocalPlayer::OnAudioOutputDeviceChanged(const FString& InAudioOutputDeviceId)
 {
 	FOnCompletedDeviceSwap DevicesSwappedCallback;
@@ -6,12 +6,15 @@
 #include "CommonLocalPlayer.h"
 #include "AudioMixerBlueprintLibrary.h"
 #include "Teams/LyraTeamAgentInterface.h"
+#include "Async/Future.h"
 #include "LyraLocalPlayer.generated.h"
 
 class ULyraSettingsLocal;
 class ULyraSettingsShared;
 class UInputMappingContext;
 
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnLyraSharedSettingsLoaded, ULyraSettingsShared* /*SharedSettings*/);
+
 /**
  * ULyraLocalPlayer
  */
@@ -33,6 +36,7 @@ public:
 	//~End of UPlayer interface
 
 	//~ULocalPlayer interface
+	virtual void PlayerAdded(class UGameViewportClient* InViewportClient, int32 InControllerID) override;
 	virtual bool SpawnPlayActor(const FString& URL, FString& OutError, UWorld* InWorld) override;
 	virtual void InitOnlineSession() override;
 	//~End of ULocalPlayer interface
@@ -47,9 +51,13 @@ public:
 	UFUNCTION()
 	ULyraSettingsLocal* GetLocalSettings() const;
 
+	/** Returns the shared settings, finishing the load synchronously if it hasn't completed in the background yet */
 	UFUNCTION()
 	ULyraSettingsShared* GetSharedSettings() const;
 
+	/** Calls the delegate once the shared settings have loaded, or immediately if they already have */
+	void CallOrRegister_OnSharedSettingsLoaded(FOnLyraSharedSettingsLoaded::FDelegate&& Delegate);
+
 protected:
 	void OnAudioOutputDeviceChanged(const FString& InAudioOutputDeviceId);
 	
@@ -62,10 +70,17 @@ private:
 	UFUNCTION()
 	void OnControllerChangedTeam(UObject* TeamAgent, int32 OldTeam, int32 NewTeam);
 
+	void FinishLoadingSharedSettings() const;
+
 private:
 	UPROPERTY(Transient)
 	mutable ULyraSettingsShared* SharedSettings;
 
+	/** The shared settings being read in the background, started when the local player is created */
+	mutable TFuture<TArray<uint8>> SharedSettingsReadFuture;
+
+	mutable FOnLyraSharedSettingsLoaded OnSharedSettingsLoaded;
+
 	UPROPERTY(Transient)
 	mutable const UInputMappingContext* InputMappingContext;
 
@@ -10,9 +10,25 @@
 #include "EngineUtils.h"
 #include "Engine/PlayerStartPIE.h"
 #include "LyraPlayerStart.h"
+#include "Character/LyraHealthComponent.h"
+#include "Teams/LyraTeamSubsystem.h"
 
 DEFINE_LOG_CATEGORY_STATIC(LogPlayerSpawning, Log, All);
 
+namespace LyraPlayerSpawning
+{
+	static bool IsLivingPawn(const APawn* Pawn)
+	{
+		if (Pawn == nullptr)
+		{
+			return false;
+		}
+
+		const ULyraHealthComponent* HealthComponent = ULyraHealthComponent::FindHealthComponent(Pawn);
+		return (HealthComponent == nullptr) || !HealthComponent->IsDeadOrDying();
+	}
+}
+
 ULyraPlayerSpawningManagerComponent::ULyraPlayerSpawningManagerComponent(const FObjectInitializer& ObjectInitializer)
 : Super(ObjectInitializer)
 {
@@ -31,6 +47,7 @@ void ULyraPlayerSpawningManagerComponent::InitializeComponent()
 	Super::InitializeComponent();
 
 	FWorldDelegates::LevelAddedToWorld.AddUObject(this, &ThisClass::OnLevelAdded);
+	FWorldDelegates::LevelRemovedFromWorld.AddUObject(this, &ThisClass::OnLevelRemoved);
 
 	UWorld* World = GetWorld();
 	World->AddOnActorSpawnedHandler(FOnActorSpawned::FDelegate::CreateUObject(this, &ThisClass::HandleOnActorSpawned));
@@ -42,6 +59,12 @@ void ULyraPlayerSpawningManagerComponent::InitializeComponent()
 			CachedPlayerStarts.Add(PlayerStart);
 		}
 	}
+
+	// Influence is only needed where spawns are chosen
+	if (bScorePlayerStarts && GetOwner()->HasAuthority())
+	{
+		SetComponentTickEnabled(true);
+	}
 }
 
 void ULyraPlayerSpawningManagerComponent::OnLevelAdded(ULevel* InLevel, UWorld* InWorld)
@@ -54,16 +77,27 @@ void ULyraPlayerSpawningManagerComponent::OnLevelAdded(ULevel* InLevel, UWorld*
 			{
 				ensure(!CachedPlayerStarts.Contains(PlayerStart));
 				CachedPlayerStarts.Add(PlayerStart);
+				bSpatialIndexDirty = true;
 			}
 		}
 	}
 }
 
+void ULyraPlayerSpawningManagerComponent::OnLevelRemoved(ULevel* InLevel, UWorld* InWorld)
+{
+	// The starts in the level are going away, they get dropped from the cache when it is next rebuilt
+	if (InWorld == GetWorld())
+	{
+		bSpatialIndexDirty = true;
+	}
+}
+
 void ULyraPlayerSpawningManagerComponent::HandleOnActorSpawned(AActor* SpawnedActor)
 {
 	if (ALyraPlayerStart* PlayerStart = Cast<ALyraPlayerStart>(SpawnedActor))
 	{
 		CachedPlayerStarts.Add(PlayerStart);
+		bSpatialIndexDirty = true;
 	}
 }
 
@@ -173,6 +207,16 @@ void ULyraPlayerSpawningManagerComponent::FinishRestartPlayer(AController* NewPl
 void ULyraPlayerSpawningManagerComponent::TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
 {
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	if (bScorePlayerStarts)
+	{
+		if (bSpatialIndexDirty)
+		{
+			RebuildSpatialIndex();
+		}
+
+		UpdatePawnInfluence();
+	}
 }
 
 APlayerStart* ULyraPlayerSpawningManagerComponent::GetFirstRandomUnoccupiedPlayerStart(AController* Controller, const TArray<ALyraPlayerStart*>& StartPoints) const
@@ -210,3 +254,260 @@ APlayerStart* ULyraPlayerSpawningManagerComponent::GetFirstRandomUnoccupiedPlaye
 
 	return nullptr;
 }
+
+//================================================================
+
+ALyraPlayerStart* ULyraPlayerSpawningManagerComponent::ChooseScoredPlayerStart(AController* Player)
+{
+	if (!bScorePlayerStarts || (Player == nullptr))
+	{
+		return nullptr;
+	}
+
+	if (bSpatialIndexDirty)
+	{
+		RebuildSpatialIndex();
+	}
+
+	const int32 NumStarts = ScoredStarts.Num();
+	if (NumStarts == 0)
+	{
+		return nullptr;
+	}
+
+	// Players without a team treat everyone as an enemy
+	const ULyraTeamSubsystem* TeamSubsystem = GetWorld()->GetSubsystem<ULyraTeamSubsystem>();
+	const int32 PlayerTeamId = (TeamSubsystem != nullptr) ? TeamSubsystem->FindTeamFromObject(Player) : INDEX_NONE;
+	const int32* PlayerTeamSlot = TeamIdToSlot.Find(PlayerTeamId);
+	const float* AllyInfluence = (PlayerTeamSlot != nullptr) ? TeamInfluence[*PlayerTeamSlot].GetData() : nullptr;
+
+	// Score = AllyWeight * AllyInfluence - EnemyWeight * (TotalInfluence - AllyInfluence), 4 starts at a time
+	const int32 NumPaddedStarts = TotalInfluence.Num();
+	TArray<float> Scores;
+	Scores.SetNumUninitialized(NumPaddedStarts);
+
+	const VectorRegister4Float AllyWeight = VectorSetFloat1(ScoringSettings.AllyInfluenceWeight);
+	const VectorRegister4Float EnemyWeight = VectorSetFloat1(ScoringSettings.EnemyInfluenceWeight);
+	for (int32 StartIndex = 0; StartIndex < NumPaddedStarts; StartIndex += 4)
+	{
+		const VectorRegister4Float Total = VectorLoad(TotalInfluence.GetData() + StartIndex);
+		const VectorRegister4Float Ally = (AllyInfluence != nullptr) ? VectorLoad(AllyInfluence + StartIndex) : VectorZeroFloat();
+		const VectorRegister4Float Enemy = VectorSubtract(Total, Ally);
+		VectorStore(VectorSubtract(VectorMultiply(Ally, AllyWeight), VectorMultiply(Enemy, EnemyWeight)), Scores.GetData() + StartIndex);
+	}
+
+	TArray<int32> Candidates;
+	Candidates.Reserve(NumStarts);
+	for (int32 StartIndex = 0; StartIndex < NumStarts; ++StartIndex)
+	{
+		Scores[StartIndex] += FMath::FRand() * ScoringSettings.RandomScoreJitter;
+		Candidates.Add(StartIndex);
+	}
+	Candidates.Sort([&Scores](int32 A, int32 B) { return Scores[A] > Scores[B]; });
+
+	// Occupancy checks are collision queries, so only the best few get one unless none of those will do
+	ALyraPlayerStart* PartiallyOccupiedStart = nullptr;
+	ALyraPlayerStart* ClaimedStart = nullptr;
+	int32 NumChecked = 0;
+	for (int32 StartIndex : Candidates)
+	{
+		ALyraPlayerStart* PlayerStart = ScoredStarts[StartIndex].Get();
+		if (PlayerStart == nullptr)
+		{
+			bSpatialIndexDirty = true;
+			continue;
+		}
+
+		if (PlayerStart->IsClaimed())
+		{
+			ClaimedStart = (ClaimedStart != nullptr) ? ClaimedStart : PlayerStart;
+			continue;
+		}
+
+		const ELyraPlayerStartLocationOccupancy Occupancy = PlayerStart->GetLocationOccupancy(Player);
+		++NumChecked;
+
+		if (Occupancy == ELyraPlayerStartLocationOccupancy::Empty)
+		{
+			return PlayerStart;
+		}
+		else if ((Occupancy == ELyraPlayerStartLocationOccupancy::Partial) && (PartiallyOccupiedStart == nullptr))
+		{
+			PartiallyOccupiedStart = PlayerStart;
+		}
+
+		if ((PartiallyOccupiedStart != nullptr) && (NumChecked >= ScoringSettings.MaxCandidatesToCheck))
+		{
+			break;
+		}
+	}
+
+	return (PartiallyOccupiedStart != nullptr) ? PartiallyOccupiedStart : ClaimedStart;
+}
+
+void ULyraPlayerSpawningManagerComponent::RebuildSpatialIndex()
+{
+	bSpatialIndexDirty = false;
+
+	ScoredStarts.Reset();
+	StartLocations.Reset();
+	StartGrid.Reset();
+	GridCellSize = FMath::Max(ScoringSettings.InfluenceRadius, 100.0f);
+
+	for (auto StartIt = CachedPlayerStarts.CreateIterator(); StartIt; ++StartIt)
+	{
+		if (ALyraPlayerStart* PlayerStart = (*StartIt).Get())
+		{
+			const int32 StartIndex = ScoredStarts.Add(PlayerStart);
+			StartLocations.Add(PlayerStart->GetActorLocation());
+			StartGrid.FindOrAdd(GetGridCell(StartLocations[StartIndex])).Add(StartIndex);
+		}
+		else
+		{
+			StartIt.RemoveCurrent();
+		}
+	}
+
+	const int32 NumPaddedStarts = Align(ScoredStarts.Num(), 4);
+	TotalInfluence.Reset();
+	TotalInfluence.SetNumZeroed(NumPaddedStarts);
+	for (TArray<float>& Influence : TeamInfluence)
+	{
+		Influence.Reset();
+		Influence.SetNumZeroed(NumPaddedStarts);
+	}
+
+	for (const FTrackedPawnInfluence& TrackedPawn : TrackedPawns)
+	{
+		if (TrackedPawn.bApplied)
+		{
+			ApplyInfluence(TrackedPawn.AppliedLocation, TrackedPawn.AppliedTeamSlot, 1.0f);
+		}
+	}
+}
+
+void ULyraPlayerSpawningManagerComponent::UpdatePawnInfluence()
+{
+	const AGameStateBase* GameState = GetGameStateChecked<AGameStateBase>();
+	const ULyraTeamSubsystem* TeamSubsystem = GetWorld()->GetSubsystem<ULyraTeamSubsystem>();
+
+	auto GetTeamSlot = [this, TeamSubsystem](const APawn* Pawn)
+	{
+		return FindOrAddTeamSlot((TeamSubsystem != nullptr) ? TeamSubsystem->FindTeamFromObject(Pawn) : INDEX_NONE);
+	};
+
+	// Drop pawns that are gone or dying
+	TSet<const APawn*> TrackedPawnSet;
+	for (int32 TrackedIndex = TrackedPawns.Num() - 1; TrackedIndex >= 0; --TrackedIndex)
+	{
+		const FTrackedPawnInfluence& TrackedPawn = TrackedPawns[TrackedIndex];
+		const APawn* Pawn = TrackedPawn.Pawn.Get();
+		if (LyraPlayerSpawning::IsLivingPawn(Pawn))
+		{
+			TrackedPawnSet.Add(Pawn);
+			continue;
+		}
+
+		if (TrackedPawn.bApplied)
+		{
+			ApplyInfluence(TrackedPawn.AppliedLocation, TrackedPawn.AppliedTeamSlot, -1.0f);
+		}
+		TrackedPawns.RemoveAtSwap(TrackedIndex);
+	}
+
+	// Newly spawned pawns count straight away
+	for (const APlayerState* PlayerState : GameState->PlayerArray)
+	{
+		APawn* Pawn = (PlayerState != nullptr) ? PlayerState->GetPawn() : nullptr;
+		if (LyraPlayerSpawning::IsLivingPawn(Pawn) && !TrackedPawnSet.Contains(Pawn))
+		{
+			FTrackedPawnInfluence& TrackedPawn = TrackedPawns.AddDefaulted_GetRef();
+			TrackedPawn.Pawn = Pawn;
+			TrackedPawn.AppliedLocation = Pawn->GetActorLocation();
+			TrackedPawn.AppliedTeamSlot = GetTeamSlot(Pawn);
+			TrackedPawn.bApplied = true;
+			ApplyInfluence(TrackedPawn.AppliedLocation, TrackedPawn.AppliedTeamSlot, 1.0f);
+		}
+	}
+
+	// Everyone else is brought up to date a few at a time
+	const int32 NumUpdates = FMath::Min(ScoringSettings.PawnUpdatesPerTick, TrackedPawns.Num());
+	const double UpdateDistanceSquared = FMath::Square(ScoringSettings.InfluenceUpdateDistance);
+	for (int32 UpdateIndex = 0; UpdateIndex < NumUpdates; ++UpdateIndex)
+	{
+		NextPawnToUpdate = (NextPawnToUpdate + 1) % TrackedPawns.Num();
+		FTrackedPawnInfluence& TrackedPawn = TrackedPawns[NextPawnToUpdate];
+
+		const APawn* Pawn = TrackedPawn.Pawn.Get();
+		const FVector Location = Pawn->GetActorLocation();
+		const int32 TeamSlot = GetTeamSlot(Pawn);
+
+		if ((TeamSlot != TrackedPawn.AppliedTeamSlot) || (FVector::DistSquared(Location, TrackedPawn.AppliedLocation) > UpdateDistanceSquared))
+		{
+			ApplyInfluence(TrackedPawn.AppliedLocation, TrackedPawn.AppliedTeamSlot, -1.0f);
+			ApplyInfluence(Location, TeamSlot, 1.0f);
+			TrackedPawn.AppliedLocation = Location;
+			TrackedPawn.AppliedTeamSlot = TeamSlot;
+		}
+	}
+}
+
+void ULyraPlayerSpawningManagerComponent::ApplyInfluence(const FVector& Location, int32 TeamSlot, float Sign)
+{
+	if (ScoredStarts.Num() == 0)
+	{
+		return;
+	}
+
+	// Cells are one influence radius wide, using the size captured at rebuild keeps removals exactly undoing what was added
+	const double Radius = GridCellSize;
+	const FIntPoint MinCell = GetGridCell(Location - FVector(Radius));
+	const FIntPoint MaxCell = GetGridCell(Location + FVector(Radius));
+	float* TeamInfluenceData = TeamInfluence.IsValidIndex(TeamSlot) ? TeamInfluence[TeamSlot].GetData() : nullptr;
+
+	for (int32 CellX = MinCell.X; CellX <= MaxCell.X; ++CellX)
+	{
+		for (int32 CellY = MinCell.Y; CellY <= MaxCell.Y; ++CellY)
+		{
+			if (const TArray<int32>* CellStarts = StartGrid.Find(FIntPoint(CellX, CellY)))
+			{
+				for (int32 StartIndex : *CellStarts)
+				{
+					const double Distance = FVector::Dist(StartLocations[StartIndex], Location);
+					if (Distance < Radius)
+					{
+						const float Influence = Sign * (float)(1.0 - (Distance / Radius));
+						TotalInfluence[StartIndex] += Influence;
+						if (TeamInfluenceData != nullptr)
+						{
+							TeamInfluenceData[StartIndex] += Influence;
+						}
+					}
+				}
+			}
+		}
+	}
+}
+
+int32 ULyraPlayerSpawningManagerComponent::FindOrAddTeamSlot(int32 TeamId)
+{
+	if (TeamId == INDEX_NONE)
+	{
+		return INDEX_NONE;
+	}
+
+	if (const int32* ExistingSlot = TeamIdToSlot.Find(TeamId))
+	{
+		return *ExistingSlot;
+	}
+
+	const int32 NewSlot = TeamInfluence.Num();
+	TeamInfluence.AddDefaulted_GetRef().SetNumZeroed(TotalInfluence.Num());
+	TeamIdToSlot.Add(TeamId, NewSlot);
+	return NewSlot;
+}
+
+FIntPoint ULyraPlayerSpawningManagerComponent::GetGridCell(const FVector& Location) const
+{
+	return FIntPoint(FMath::FloorToInt((float)(Location.X / GridCellSize)), FMath::FloorToInt((float)(Location.Y / GridCellSize)));
+}
@@ -13,9 +13,49 @@ class APlayerState;
 class APlayerStart;
 class ALyraPlayerStart;
 class AActor;
+class APawn;
+
+/** Configures how ULyraPlayerSpawningManagerComponent scores player starts when bScorePlayerStarts is set */
+USTRUCT(BlueprintType)
+struct FLyraPlayerStartScoringSettings
+{
+	GENERATED_BODY()
+
+	// Pawns influence the player starts within this distance, falling off linearly
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=Spawning, meta=(ClampMin=100.0))
+	float InfluenceRadius = 5000.0f;
+
+	// How much the influence of nearby enemies counts against a player start
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=Spawning)
+	float EnemyInfluenceWeight = 1.0f;
+
+	// How much the influence of nearby allies counts in favor of a player start
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=Spawning)
+	float AllyInfluenceWeight = 0.0f;
+
+	// Up to this much is randomly added to each score, so equally good starts get picked evenly
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=Spawning, meta=(ClampMin=0.0))
+	float RandomScoreJitter = 0.05f;
+
+	// How many of the best scoring starts get an occupancy check (a collision query) before settling for a partially occupied or claimed one
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=Spawning, meta=(ClampMin=1))
+	int32 MaxCandidatesToCheck = 8;
+
+	// How many pawns have their influence brought up to date each tick (newly spawned and removed pawns are always handled right away)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=Spawning, meta=(ClampMin=1))
+	int32 PawnUpdatesPerTick = 8;
+
+	// How far a pawn has to move before its influence is updated
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=Spawning, meta=(ClampMin=0.0))
+	float InfluenceUpdateDistance = 250.0f;
+};
 
 /**
  * @class ULyraPlayerSpawningManagerComponent
+ *
+ * When bScorePlayerStarts is set, the player starts are kept in a grid and the influence of every living pawn (per team) on the starts
+ * around it is tracked incrementally as pawns move, a few pawns per tick. ChooseScoredPlayerStart then scores all starts in one pass
+ * over the influence arrays and only does occupancy checks on the best few.
  */
 UCLASS()
 class LYRAGAME_API ULyraPlayerSpawningManagerComponent : public UGameStateComponent
@@ -33,6 +73,10 @@ public:
 protected:
 	// Utility
 	APlayerStart* GetFirstRandomUnoccupiedPlayerStart(AController* Controller, const TArray<ALyraPlayerStart*>& FoundStartPoints) const;
+
+	// Returns the best player start for the controller according to ScoringSettings, preferring starts away from enemies (and near allies)
+	// Only available when bScorePlayerStarts is set, returns nullptr otherwise
+	ALyraPlayerStart* ChooseScoredPlayerStart(AController* Player);
 	
 	virtual AActor* OnChoosePlayerStart(AController* Player, TArray<ALyraPlayerStart*>& PlayerStarts) { return nullptr; }
 	virtual void OnFinishRestartPlayer(AController* Player, const FRotator& StartRotation) { }
@@ -40,6 +84,14 @@ protected:
 	UFUNCTION(BlueprintImplementableEvent, meta=(DisplayName=OnFinishRestartPlayer))
 	void K2_OnFinishRestartPlayer(AController* Player, const FRotator& StartRotation);
 
+protected:
+	// Should the influence of pawns on player starts be tracked so ChooseScoredPlayerStart can be used (server only)
+	UPROPERTY(EditDefaultsOnly, Category=Spawning)
+	bool bScorePlayerStarts = false;
+
+	UPROPERTY(EditDefaultsOnly, Category=Spawning, meta=(EditCondition=bScorePlayerStarts))
+	FLyraPlayerStartScoringSettings ScoringSettings;
+
 private:
 
 	/** We proxy these calls from ALyraGameMode, to this component so that each experience can more easily customize the respawn system they want. */
@@ -54,8 +106,49 @@ private:
 
 private:
 	void OnLevelAdded(ULevel* InLevel, UWorld* InWorld);
+	void OnLevelRemoved(ULevel* InLevel, UWorld* InWorld);
 	void HandleOnActorSpawned(AActor* SpawnedActor);
 
+	struct FTrackedPawnInfluence
+	{
+		TWeakObjectPtr<APawn> Pawn;
+
+		// Where and for which team slot the influence was last added (INDEX_NONE team slot for pawns without a team)
+		FVector AppliedLocation = FVector::ZeroVector;
+		int32 AppliedTeamSlot = INDEX_NONE;
+		bool bApplied = false;
+	};
+
+	// Rebuilds the grid and influence arrays from CachedPlayerStarts, reapplying the influence of every tracked pawn
+	void RebuildSpatialIndex();
+
+	// Picks up new pawns and drops dead ones, then moves the influence of a few pawns to where they are now
+	void UpdatePawnInfluence();
+
+	// Adds (Sign = 1) or removes (Sign = -1) a pawn's influence on the player starts around Location
+	void ApplyInfluence(const FVector& Location, int32 TeamSlot, float Sign);
+
+	int32 FindOrAddTeamSlot(int32 TeamId);
+	FIntPoint GetGridCell(const FVector& Location) const;
+
+	// Player starts being scored, parallel to StartLocations and the influence arrays
+	TArray<TWeakObjectPtr<ALyraPlayerStart>> ScoredStarts;
+	TArray<FVector> StartLocations;
+
+	// Indices into ScoredStarts for each grid cell (cells are InfluenceRadius across)
+	TMap<FIntPoint, TArray<int32>> StartGrid;
+	float GridCellSize = 1.0f;
+
+	// Influence of all pawns, and of each team's pawns, on each start (padded to a multiple of 4 so they can be scored 4 at a time)
+	TArray<float> TotalInfluence;
+	TArray<TArray<float>> TeamInfluence;
+	TMap<int32, int32> TeamIdToSlot;
+
+	TArray<FTrackedPawnInfluence> TrackedPawns;
+	int32 NextPawnToUpdate = 0;
+
+	bool bSpatialIndexDirty = true;
+
 #if WITH_EDITOR
 	APlayerStart* FindPlayFromHereStart(AController* Player);
 #endif
@@ -35,6 +35,8 @@ ALyraPlayerState::ALyraPlayerState(const FObjectInitializer& ObjectInitializer)
 
 	MyTeamID = FGenericTeamId::NoTeam;
 	MySquadID = INDEX_NONE;
+
+	VerbMessages.SetOwner(this);
 }
 
 void ALyraPlayerState::PreInitializeComponents()
@@ -125,6 +127,14 @@ void ALyraPlayerState::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& Out
 	DOREPLIFETIME_WITH_PARAMS_FAST(ThisClass, MySquadID, SharedParams);
 
 	DOREPLIFETIME(ThisClass, StatTags);
+	DOREPLIFETIME_CONDITION(ThisClass, VerbMessages, COND_OwnerOnly);
+}
+
+void ALyraPlayerState::PreReplication(IRepChangedPropertyTracker& ChangedPropertyTracker)
+{
+	VerbMessages.FlushPendingMessages(GetWorld()->GetTimeSeconds());
+
+	Super::PreReplication(ChangedPropertyTracker);
 }
 
 ALyraPlayerController* ALyraPlayerState::GetLyraPlayerController() const
@@ -269,3 +279,9 @@ void ALyraPlayerState::ClientBroadcastMessage_Implementation(const FLyraVerbMess
 		UGameplayMessageSubsystem::Get(this).BroadcastMessage(Message.Verb, Message);
 	}
 }
+
+void ALyraPlayerState::AddReplicatedVerbMessage(const FLyraVerbMessage& Message)
+{
+	check(HasAuthority());
+	VerbMessages.AddMessage(Message);
+}
@@ -7,6 +7,7 @@
 #include "AbilitySystemInterface.h"
 #include "System/GameplayTagStack.h"
 #include "Messages/LyraVerbMessage.h"
+#include "Messages/LyraVerbMessageReplication.h"
 #include "Teams/LyraTeamAgentInterface.h"
 
 #include "LyraPlayerState.generated.h"
@@ -69,6 +70,7 @@ public:
 	//~AActor interface
 	virtual void PreInitializeComponents() override;
 	virtual void PostInitializeComponents() override;
+	virtual void PreReplication(IRepChangedPropertyTracker& ChangedPropertyTracker) override;
 	//~End of AActor interface
 
 	//~APlayerState interface
@@ -134,6 +136,13 @@ public:
 	UFUNCTION(Client, Unreliable, BlueprintCallable, Category = "Lyra|PlayerState")
 	void ClientBroadcastMessage(const FLyraVerbMessage Message);
 
+	// Queues a message for just this player, it is sent on a later net update within the player's verb message budget
+	// (see FLyraVerbMessageReplication, and ALyraGameState::MulticastReliableMessageToClients which uses this to reach every player)
+	void AddReplicatedVerbMessage(const FLyraVerbMessage& Message);
+
+	// Returns the estimated bytes per second of verb messages replicated to this player
+	float GetVerbMessageBytesPerSecond() const { return VerbMessages.GetBytesPerSecond(); }
+
 private:
 	void OnExperienceLoaded(const ULyraExperienceDefinition* CurrentExperience);
 
@@ -168,6 +177,10 @@ private:
 	UPROPERTY(Replicated)
 	FGameplayTagStackContainer StatTags;
 
+	// Verb messages for this player only
+	UPROPERTY(Replicated)
+	FLyraVerbMessageReplication VerbMessages;
+
 private:
 	UFUNCTION()
 	void OnRep_MyTeamID(FGenericTeamId OldTeamID);
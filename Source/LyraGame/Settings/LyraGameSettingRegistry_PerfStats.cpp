@@ -26,7 +26,7 @@ void ULyraGameSettingRegistry::AddPerformanceStatPage(UGameSettingCollection* Pe
 {
 	//----------------------------------------------------------------------------------
 	{
-		static_assert((int32)ELyraDisplayablePerformanceStat::Count == 15, "Consider updating this function to deal with new performance stats");
+		static_assert((int32)ELyraDisplayablePerformanceStat::Count == 16, "Consider updating this function to deal with new performance stats");
 
 		UGameSettingCollectionPage* StatsPage = NewObject<UGameSettingCollectionPage>();
 		StatsPage->SetDevName(TEXT("PerfStatsPage"));
@@ -178,6 +178,14 @@ void ULyraGameSettingRegistry::AddPerformanceStatPage(UGameSettingCollection* Pe
 				StatCategory_Network->AddSetting(Setting);
 			}
 			//----------------------------------------------------------------------------------
+			{
+				ULyraSettingValueDiscrete_PerfStat* Setting = NewObject<ULyraSettingValueDiscrete_PerfStat>();
+				Setting->SetStat(ELyraDisplayablePerformanceStat::VerbMessageBytes_Incoming);
+				Setting->SetDisplayName(LOCTEXT("PerfStat_VerbMessageBytes_Incoming", "Incoming Message Bytes"));
+				Setting->SetDescriptionRichText(LOCTEXT("PerfStatDescription_VerbMessageBytes_Incoming", "The estimated bytes of game messages (eliminations, accolades, etc...) received in the last second."));
+				StatCategory_Network->AddSetting(Setting);
+			}
+			//----------------------------------------------------------------------------------
 		}
 	}
 }
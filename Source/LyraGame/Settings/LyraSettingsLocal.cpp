@@ -26,6 +26,8 @@
 #include "AudioModulationStatics.h"
 #include "Audio/LyraAudioSettings.h"
 #include "Audio/LyraAudioMixEffectsSubsystem.h"
+#include "Containers/Ticker.h"
+#include "Misc/CoreDelegates.h"
 
 UE_DEFINE_GAMEPLAY_TAG_STATIC(TAG_Platform_Trait_BinauralSettingControlledByOS, "Platform.Trait.BinauralSettingControlledByOS");
 
@@ -48,6 +50,11 @@ static TAutoConsoleVariable<bool> CVarApplyDeviceProfilesInPIE(TEXT("Lyra.Settin
 	ECVF_Default);
 #endif
 
+static TAutoConsoleVariable<bool> CVarCoalesceSettingsSaves(TEXT("Lyra.Settings.CoalesceSaves"),
+	true,
+	TEXT("Should repeated requests to save the local settings in the same frame be combined into a single write at the end of the frame?"),
+	ECVF_Default);
+
 //////////////////////////////////////////////////////////////////////
 // Console frame pacing
 
@@ -340,6 +347,11 @@ ULyraSettingsLocal::ULyraSettingsLocal()
 		OnApplicationActivationStateChangedHandle = FSlateApplication::Get().OnApplicationActivationStateChanged().AddUObject(this, &ThisClass::OnAppActivationStateChanged);
 	}
 
+	if (!HasAnyFlags(RF_ClassDefaultObject))
+	{
+		OnPreExitHandle = FCoreDelegates::OnPreExit.AddUObject(this, &ThisClass::FlushDeferredSave);
+	}
+
 	SetToDefaults();
 }
 
@@ -408,9 +420,44 @@ void ULyraSettingsLocal::BeginDestroy()
 		FSlateApplication::Get().OnApplicationActivationStateChanged().Remove(OnApplicationActivationStateChangedHandle);
 	}
 
+	FCoreDelegates::OnPreExit.Remove(OnPreExitHandle);
+	FlushDeferredSave();
+
 	Super::BeginDestroy();
 }
 
+void ULyraSettingsLocal::SaveSettings()
+{
+	// Applying settings tends to save several times in a row (and saving writes the whole ini), so only do it once per frame
+	if (!CVarCoalesceSettingsSaves.GetValueOnGameThread() || HasAnyFlags(RF_ClassDefaultObject) || IsEngineExitRequested())
+	{
+		FlushDeferredSave();
+		Super::SaveSettings();
+		return;
+	}
+
+	if (!DeferredSaveHandle.IsValid())
+	{
+		DeferredSaveHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateWeakLambda(this, [this](float DeltaTime)
+		{
+			DeferredSaveHandle.Reset();
+			Super::SaveSettings();
+			return false;
+		}));
+	}
+}
+
+void ULyraSettingsLocal::FlushDeferredSave()
+{
+	if (DeferredSaveHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(DeferredSaveHandle);
+		DeferredSaveHandle.Reset();
+
+		Super::SaveSettings();
+	}
+}
+
 ULyraSettingsLocal* ULyraSettingsLocal::Get()
 {
 	return GEngine ? CastChecked<ULyraSettingsLocal>(GEngine->GetGameUserSettings()) : nullptr;
@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/GameUserSettings.h"
+#include "Containers/Ticker.h"
 #include "Input/LyraMappableConfigPair.h"
 #include "Performance/LyraPerformanceStatTypes.h"
 
@@ -47,6 +48,7 @@ public:
 	//~UGameUserSettings interface
 	virtual void SetToDefaults() override;
 	virtual void LoadSettings(bool bForceReload) override;
+	virtual void SaveSettings() override;
 	virtual void ConfirmVideoMode() override;
 	virtual float GetEffectiveFrameRateLimit() override;
 	virtual void ResetToCurrentSettings() override;
@@ -450,6 +452,12 @@ private:
 	void OnAppActivationStateChanged(bool bIsActive);
 	void ReapplyThingsDueToPossibleDeviceProfileChange();
 
+	void FlushDeferredSave();
+
 private:
 	FDelegateHandle OnApplicationActivationStateChangedHandle;
+	FDelegateHandle OnPreExitHandle;
+
+	// Pending end of frame save, see SaveSettings
+	FTSTicker::FDelegateHandle DeferredSaveHandle;
 };
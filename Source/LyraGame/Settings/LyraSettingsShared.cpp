@@ -6,6 +6,9 @@
 #include "Kismet/GameplayStatics.h"
 #include "Player/LyraLocalPlayer.h"
 #include "Internationalization/Culture.h"
+#include "Async/Async.h"
+#include "Misc/CoreDelegates.h"
+#include "LyraLogChannels.h"
 
 static FString SHARED_SETTINGS_SLOT_NAME = TEXT("SharedGameSettings");
 
@@ -24,6 +27,106 @@ namespace LyraSettingsSharedCVars
 		DefaultGamepadRightStickInnerDeadZone,
 		TEXT("Gamepad right stick inner deadzone")
 	);	
+
+	static bool bAsyncSettingsIO = true;
+	static FAutoConsoleVariableRef CVarAsyncSettingsIO(
+		TEXT("Lyra.Settings.AsyncSharedSettingsIO"),
+		bAsyncSettingsIO,
+		TEXT("Should the shared settings be read from and written to the save slot off the game thread?")
+	);
+}
+
+namespace LyraSettingsSharedIO
+{
+	// Serialized settings waiting to be written to one user's save slot. The newest save replaces any data
+	// that hasn't been written yet, so a burst of saves only results in one or two writes.
+	struct FSaveQueue
+	{
+		// Guards the pending data and the in-flight flag, only held briefly
+		FCriticalSection DataLock;
+		TArray<uint8> PendingData;
+		bool bHasPendingData = false;
+		bool bWriteInFlight = false;
+
+		// Held for the duration of each read or write of the slot
+		FCriticalSection SlotLock;
+
+		// Only touched on the game thread
+		TFuture<void> WriteFuture;
+
+		void WritePendingData(const FString& SlotName, int32 UserIndex)
+		{
+			for (;;)
+			{
+				FScopeLock SlotScopeLock(&SlotLock);
+
+				TArray<uint8> SaveData;
+				{
+					FScopeLock DataScopeLock(&DataLock);
+					if (!bHasPendingData)
+					{
+						bWriteInFlight = false;
+						return;
+					}
+
+					SaveData = MoveTemp(PendingData);
+					bHasPendingData = false;
+				}
+
+				if (!UGameplayStatics::SaveDataToSlot(SaveData, SlotName, UserIndex))
+				{
+					UE_LOG(LogLyra, Warning, TEXT("Failed to write shared settings to slot %s for user %d"), *SlotName, UserIndex);
+				}
+			}
+		}
+
+		TArray<uint8> ReadData(const FString& SlotName, int32 UserIndex)
+		{
+			FScopeLock SlotScopeLock(&SlotLock);
+
+			// Data that hasn't been written yet is newer than what's in the slot
+			{
+				FScopeLock DataScopeLock(&DataLock);
+				if (bHasPendingData)
+				{
+					return PendingData;
+				}
+			}
+
+			TArray<uint8> SaveData;
+			UGameplayStatics::LoadDataFromSlot(SaveData, SlotName, UserIndex);
+			return SaveData;
+		}
+
+		void Flush()
+		{
+			if (WriteFuture.IsValid())
+			{
+				WriteFuture.Wait();
+			}
+		}
+	};
+
+	// Keyed by user index, only accessed on the game thread
+	static TMap<int32, TSharedRef<FSaveQueue, ESPMode::ThreadSafe>> SaveQueues;
+
+	static TSharedRef<FSaveQueue, ESPMode::ThreadSafe> GetSaveQueue(int32 UserIndex)
+	{
+		check(IsInGameThread());
+
+		if (SaveQueues.IsEmpty())
+		{
+			// Make sure queued writes aren't lost when the game exits
+			static FDelegateHandle PreExitHandle = FCoreDelegates::OnPreExit.AddStatic(&ULyraSettingsShared::FlushPendingSaves);
+		}
+
+		if (const TSharedRef<FSaveQueue, ESPMode::ThreadSafe>* ExistingQueue = SaveQueues.Find(UserIndex))
+		{
+			return *ExistingQueue;
+		}
+
+		return SaveQueues.Add(UserIndex, MakeShared<FSaveQueue, ESPMode::ThreadSafe>());
+	}
 }
 
 ULyraSettingsShared::ULyraSettingsShared()
@@ -44,11 +147,90 @@ void ULyraSettingsShared::Initialize(ULyraLocalPlayer* LocalPlayer)
 void ULyraSettingsShared::SaveSettings()
 {
 	check(OwningPlayer);
-	UGameplayStatics::SaveGameToSlot(this, SHARED_SETTINGS_SLOT_NAME, OwningPlayer->GetLocalPlayerIndex());
+
+	const int32 UserIndex = OwningPlayer->GetLocalPlayerIndex();
+
+	if (!LyraSettingsSharedCVars::bAsyncSettingsIO)
+	{
+		LyraSettingsSharedIO::GetSaveQueue(UserIndex)->Flush();
+		UGameplayStatics::SaveGameToSlot(this, SHARED_SETTINGS_SLOT_NAME, UserIndex);
+		return;
+	}
+
+	// Serializing has to happen on the game thread, only the write to the slot is moved off it
+	TArray<uint8> SaveData;
+	if (!UGameplayStatics::SaveGameToMemory(this, SaveData))
+	{
+		UE_LOG(LogLyra, Warning, TEXT("Failed to serialize shared settings for user %d"), UserIndex);
+		return;
+	}
+
+	TSharedRef<LyraSettingsSharedIO::FSaveQueue, ESPMode::ThreadSafe> SaveQueue = LyraSettingsSharedIO::GetSaveQueue(UserIndex);
+	{
+		FScopeLock DataScopeLock(&SaveQueue->DataLock);
+
+		SaveQueue->PendingData = MoveTemp(SaveData);
+		SaveQueue->bHasPendingData = true;
+
+		// The write that's already running will pick up the new data when it finishes
+		if (SaveQueue->bWriteInFlight)
+		{
+			return;
+		}
+
+		SaveQueue->bWriteInFlight = true;
+	}
+
+	SaveQueue->WriteFuture = Async(EAsyncExecution::ThreadPool, [SaveQueue, UserIndex]()
+	{
+		SaveQueue->WritePendingData(SHARED_SETTINGS_SLOT_NAME, UserIndex);
+	});
+}
+
+/*static*/ void ULyraSettingsShared::FlushPendingSaves()
+{
+	for (const auto& KVP : LyraSettingsSharedIO::SaveQueues)
+	{
+		KVP.Value->Flush();
+	}
+}
+
+/*static*/ TFuture<TArray<uint8>> ULyraSettingsShared::AsyncReadSettingsData(const ULyraLocalPlayer* LocalPlayer, TUniqueFunction<void()>&& OnReadComplete)
+{
+	const int32 UserIndex = LocalPlayer->GetLocalPlayerIndex();
+	TSharedRef<LyraSettingsSharedIO::FSaveQueue, ESPMode::ThreadSafe> SaveQueue = LyraSettingsSharedIO::GetSaveQueue(UserIndex);
+
+	return Async(EAsyncExecution::ThreadPool, [SaveQueue, UserIndex]()
+	{
+		return SaveQueue->ReadData(SHARED_SETTINGS_SLOT_NAME, UserIndex);
+	}, MoveTemp(OnReadComplete));
+}
+
+/*static*/ ULyraSettingsShared* ULyraSettingsShared::CreateSettingsFromData(const ULyraLocalPlayer* LocalPlayer, const TArray<uint8>& SaveData)
+{
+	ULyraSettingsShared* SharedSettings = nullptr;
+
+	if (SaveData.Num() > 0)
+	{
+		SharedSettings = Cast<ULyraSettingsShared>(UGameplayStatics::LoadGameFromMemory(SaveData));
+	}
+
+	if (SharedSettings == nullptr)
+	{
+		SharedSettings = Cast<ULyraSettingsShared>(UGameplayStatics::CreateSaveGameObject(ULyraSettingsShared::StaticClass()));
+	}
+
+	SharedSettings->Initialize(const_cast<ULyraLocalPlayer*>(LocalPlayer));
+	SharedSettings->ApplySettings();
+
+	return SharedSettings;
 }
 
 /*static*/ ULyraSettingsShared* ULyraSettingsShared::LoadOrCreateSettings(const ULyraLocalPlayer* LocalPlayer)
 {
+	// Make sure we read back anything that's still being written
+	LyraSettingsSharedIO::GetSaveQueue(LocalPlayer->GetLocalPlayerIndex())->Flush();
+
 	ULyraSettingsShared* SharedSettings = nullptr;
 
 	// If the save game exists, load it.
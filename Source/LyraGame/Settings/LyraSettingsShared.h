@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "SubtitleDisplaySubsystem.h"
 #include "GameFramework/SaveGame.h"
+#include "Async/Future.h"
 #include "LyraSettingsShared.generated.h"
 
 UENUM(BlueprintType)
@@ -80,9 +81,24 @@ public:
 	bool IsDirty() const { return bIsDirty; }
 	void ClearDirtyFlag() { bIsDirty = false; }
 
+	/** Serializes the settings and writes them to the save slot off the game thread, back to back saves are coalesced into a single write */
 	void SaveSettings();
+
+	/** Loads the settings synchronously, or creates new ones if there aren't any saved */
 	static ULyraSettingsShared* LoadOrCreateSettings(const ULyraLocalPlayer* LocalPlayer);
 
+	/**
+	 * Reads the saved settings for a local player off the game thread, OnReadComplete is called from the worker thread once the
+	 * future is ready. The data (which is empty if nothing was saved) should be passed to CreateSettingsFromData on the game thread.
+	 */
+	static TFuture<TArray<uint8>> AsyncReadSettingsData(const ULyraLocalPlayer* LocalPlayer, TUniqueFunction<void()>&& OnReadComplete);
+
+	/** Creates the settings from data returned by AsyncReadSettingsData, or new settings if the data is empty or invalid */
+	static ULyraSettingsShared* CreateSettingsFromData(const ULyraLocalPlayer* LocalPlayer, const TArray<uint8>& SaveData);
+
+	/** Blocks until every queued settings write has reached the save slot */
+	static void FlushPendingSaves();
+
 	void ApplySettings();
 	
 public:
@@ -4,12 +4,14 @@
 #include "LyraLogChannels.h"
 #include "LyraGameplayTags.h"
 #include "LyraGameData.h"
+#include "LyraSyncLoadProfiler.h"
 #include "AbilitySystemGlobals.h"
 #include "Character/LyraPawnData.h"
 #include "Stats/StatsMisc.h"
 #include "Engine/Engine.h"
 #include "AbilitySystem/LyraGameplayCueManager.h"
 #include "Misc/ScopedSlowTask.h"
+#include "HAL/IConsoleManager.h"
 
 const FName FLyraBundles::Equipped("Equipped");
 
@@ -23,9 +25,20 @@ static FAutoConsoleCommand CVarDumpLoadedAssets(
 
 //////////////////////////////////////////////////////////////////////
 
+// Both return the index of the new job in StartupJobs, for other jobs to depend on
 #define STARTUP_JOB_WEIGHTED(JobFunc, JobWeight) StartupJobs.Add(FLyraAssetManagerStartupJob(#JobFunc, [this](const FLyraAssetManagerStartupJob& StartupJob, TSharedPtr<FStreamableHandle>& LoadHandle){JobFunc;}, JobWeight))
 #define STARTUP_JOB(JobFunc) STARTUP_JOB_WEIGHTED(JobFunc, 1.f)
 
+namespace LyraAssetManagerCVars
+{
+	static bool bRunStartupJobsConcurrently = true;
+	static FAutoConsoleVariableRef CVarRunStartupJobsConcurrently(
+		TEXT("Lyra.AssetManager.RunStartupJobsConcurrently"),
+		bRunStartupJobsConcurrently,
+		TEXT("If true, startup jobs that don't depend on each other have their loads in flight at the same time. If false they run one after another in the order they were added."),
+		ECVF_Default);
+}
+
 //////////////////////////////////////////////////////////////////////
 
 ULyraAssetManager::ULyraAssetManager()
@@ -59,6 +72,8 @@ UObject* ULyraAssetManager::SynchronousLoadAsset(const FSoftObjectPath& AssetPat
 			LogTimePtr = MakeUnique<FScopeLogTime>(*FString::Printf(TEXT("Synchronously loaded asset [%s]"), *AssetPath.ToString()), nullptr, FScopeLogTime::ScopeLog_Seconds);
 		}
 
+		FLyraScopedSyncLoadRecord SyncLoadRecord(AssetPath);
+
 		if (UAssetManager::IsValid())
 		{
 			return UAssetManager::GetStreamableManager().LoadSynchronous(AssetPath, false);
@@ -132,14 +147,21 @@ void ULyraAssetManager::StartInitialLoading()
 	// 做所有相关的扫描，即使资源延迟加载，也需要在这个地方进行扫描
 	Super::StartInitialLoading();
 
-	STARTUP_JOB(InitializeAbilitySystem());
-	STARTUP_JOB(InitializeGameplayCueManager());
+	const int32 AbilitySystemJob = STARTUP_JOB(InitializeAbilitySystem());
 
 	{
-		// Load base game data asset
-		STARTUP_JOB_WEIGHTED(GetGameData(), 25.f);
+		// Load base game data asset, the native tags have to exist before anything referencing them is loaded.
+		// This is added ahead of the gameplay cue manager so the load is in flight while the cue manager initializes
+		const int32 GameDataLoadJob = STARTUP_JOB_WEIGHTED(StartLoadingGameData(LoadHandle), 25.f);
+		StartupJobs[GameDataLoadJob].AddDependency(AbilitySystemJob);
+
+		const int32 GameDataJob = STARTUP_JOB(GetGameData());
+		StartupJobs[GameDataJob].AddDependency(GameDataLoadJob);
 	}
 
+	const int32 GameplayCueManagerJob = STARTUP_JOB(InitializeGameplayCueManager());
+	StartupJobs[GameplayCueManagerJob].AddDependency(AbilitySystemJob);
+
 	// Run all the queued up startup jobs
 	DoAllStartupJobs();
 }
@@ -163,6 +185,17 @@ void ULyraAssetManager::InitializeGameplayCueManager()
 }
 
 
+void ULyraAssetManager::StartLoadingGameData(TSharedPtr<FStreamableHandle>& LoadHandle)
+{
+	SCOPED_BOOT_TIMING("ULyraAssetManager::StartLoadingGameData");
+
+	// The editor loads game data synchronously (see LoadGameDataOfClass), so there is nothing to get a head start on
+	if (!GIsEditor && !LyraGameDataPath.IsNull() && !GameDataMap.Contains(ULyraGameData::StaticClass()))
+	{
+		LoadHandle = LoadPrimaryAssetsWithType(ULyraGameData::StaticClass()->GetFName());
+	}
+}
+
 const ULyraGameData& ULyraAssetManager::GetGameData()
 {
 	return GetOrLoadTypedGameData<ULyraGameData>(LyraGameDataPath);
@@ -188,6 +221,7 @@ UPrimaryDataAsset* ULyraAssetManager::LoadGameDataOfClass(TSubclassOf<UPrimaryDa
 #endif
 		UE_LOG(LogLyra, Log, TEXT("Loading GameData: %s ..."), *DataClassPath.ToString());
 		SCOPE_LOG_TIME_IN_SECONDS(TEXT("    ... GameData loaded!"), nullptr);
+		FLyraScopedSyncLoadRecord SyncLoadRecord(DataClassPath.ToSoftObjectPath(), TEXT("ULyraAssetManager::LoadGameDataOfClass"));
 
 		// This can be called recursively in the editor because it is called on demand from PostLoad so force a sync load for primary asset and async load the rest in that case
 		if (GIsEditor)
@@ -227,50 +261,214 @@ void ULyraAssetManager::DoAllStartupJobs()
 	SCOPED_BOOT_TIMING("ULyraAssetManager::DoAllStartupJobs");
 	const double AllStartupJobsStartTime = FPlatformTime::Seconds();
 
-	if (IsRunningDedicatedServer())
+	// No need for periodic progress updates on dedicated servers
+	const bool bReportProgress = !IsRunningDedicatedServer();
+
+	if (StartupJobs.Num() > 0)
 	{
-		// No need for periodic progress updates, just run the jobs
+		const int32 NumJobs = StartupJobs.Num();
+
+		// When not running concurrently every job just waits for the one added before it
+		TArray<TArray<int32>> JobDependencies;
+		JobDependencies.SetNum(NumJobs);
+		for (int32 JobIndex = 0; JobIndex < NumJobs; ++JobIndex)
+		{
+			if (!LyraAssetManagerCVars::bRunStartupJobsConcurrently)
+			{
+				if (JobIndex > 0)
+				{
+					JobDependencies[JobIndex].Add(JobIndex - 1);
+				}
+				continue;
+			}
+
+			for (int32 DependencyIndex : StartupJobs[JobIndex].Dependencies)
+			{
+				if (ensureMsgf(StartupJobs.IsValidIndex(DependencyIndex) && (DependencyIndex != JobIndex), TEXT("Startup job \"%s\" depends on invalid job index %d"), *StartupJobs[JobIndex].JobName, DependencyIndex))
+				{
+					JobDependencies[JobIndex].Add(DependencyIndex);
+				}
+			}
+		}
+
+		struct FStartupJobState
+		{
+			TSharedPtr<FStreamableHandle> Handle;
+			double StartTime = 0.0;
+			double EndTime = 0.0;
+
+			// Longest chain of jobs (by wall time) ending with this one, and the dependency it came through
+			double CriticalPathSeconds = 0.0;
+			int32 CriticalPathPrevious = INDEX_NONE;
+
+			float Progress = 0.0f;
+			bool bStarted = false;
+			bool bFinished = false;
+		};
+
+		TArray<FStartupJobState> JobStates;
+		JobStates.SetNum(NumJobs);
+
+		float TotalJobValue = 0.0f;
 		for (const FLyraAssetManagerStartupJob& StartupJob : StartupJobs)
 		{
-			StartupJob.DoJob();
+			TotalJobValue += StartupJob.JobWeight;
 		}
-	}
-	else
-	{
-		if (StartupJobs.Num() > 0)
+
+		// Overall progress is the weighted progress of every job, so jobs that are in flight together all contribute
+		auto UpdateOverallProgress = [this, &JobStates, TotalJobValue]()
 		{
-			float TotalJobValue = 0.0f;
-			for (const FLyraAssetManagerStartupJob& StartupJob : StartupJobs)
+			float AccumulatedJobValue = 0.0f;
+			for (int32 JobIndex = 0; JobIndex < JobStates.Num(); ++JobIndex)
 			{
-				TotalJobValue += StartupJob.JobWeight;
+				AccumulatedJobValue += JobStates[JobIndex].Progress * StartupJobs[JobIndex].JobWeight;
 			}
 
-			float AccumulatedJobValue = 0.0f;
-			for (FLyraAssetManagerStartupJob& StartupJob : StartupJobs)
+			UpdateInitialGameContentLoadPercent((TotalJobValue > 0.0f) ? (AccumulatedJobValue / TotalJobValue) : 1.0f);
+		};
+
+		auto FinishStartupJob = [this, &JobStates, &JobDependencies](int32 JobIndex)
+		{
+			FStartupJobState& State = JobStates[JobIndex];
+			StartupJobs[JobIndex].FinishJob(State.Handle, State.StartTime);
+			StartupJobs[JobIndex].SubstepProgressDelegate.Unbind();
+
+			State.Handle.Reset();
+			State.EndTime = FPlatformTime::Seconds();
+			State.Progress = 1.0f;
+			State.bFinished = true;
+
+			for (int32 DependencyIndex : JobDependencies[JobIndex])
+			{
+				if (JobStates[DependencyIndex].CriticalPathSeconds > State.CriticalPathSeconds)
+				{
+					State.CriticalPathSeconds = JobStates[DependencyIndex].CriticalPathSeconds;
+					State.CriticalPathPrevious = DependencyIndex;
+				}
+			}
+			State.CriticalPathSeconds += State.EndTime - State.StartTime;
+		};
+
+		int32 NumFinishedJobs = 0;
+		while (NumFinishedJobs < NumJobs)
+		{
+			// Start every job whose dependencies are done. Jobs that don't leave a load in flight finish right away, which may unblock more
+			bool bStartedAnyJob = false;
+			for (int32 JobIndex = 0; JobIndex < NumJobs; ++JobIndex)
+			{
+				FStartupJobState& State = JobStates[JobIndex];
+				if (State.bStarted || JobDependencies[JobIndex].ContainsByPredicate([&JobStates](int32 DependencyIndex) { return !JobStates[DependencyIndex].bFinished; }))
+				{
+					continue;
+				}
+
+				if (bReportProgress)
+				{
+					StartupJobs[JobIndex].SubstepProgressDelegate.BindLambda([&JobStates, JobIndex, &UpdateOverallProgress](float NewProgress)
+						{
+							JobStates[JobIndex].Progress = FMath::Clamp(NewProgress, 0.0f, 1.0f);
+							UpdateOverallProgress();
+						});
+				}
+
+				State.bStarted = true;
+				State.StartTime = FPlatformTime::Seconds();
+				State.Handle = StartupJobs[JobIndex].StartJob();
+				bStartedAnyJob = true;
+
+				if (!State.Handle.IsValid() || State.Handle->HasLoadCompleted() || State.Handle->WasCanceled())
+				{
+					FinishStartupJob(JobIndex);
+					++NumFinishedJobs;
+
+					if (bReportProgress)
+					{
+						UpdateOverallProgress();
+					}
+				}
+			}
+
+			if (bStartedAnyJob)
+			{
+				continue;
+			}
+
+			TSharedPtr<FStreamableHandle> HandleToWaitOn;
+			for (const FStartupJobState& State : JobStates)
+			{
+				if (State.bStarted && !State.bFinished)
+				{
+					HandleToWaitOn = State.Handle;
+					break;
+				}
+			}
+
+			if (!HandleToWaitOn.IsValid())
 			{
-				const float JobValue = StartupJob.JobWeight;
-				StartupJob.SubstepProgressDelegate.BindLambda([This = this, AccumulatedJobValue, JobValue, TotalJobValue](float NewProgress)
+				// Nothing is in flight and nothing can start, so the remaining jobs depend on each other. Run them in order rather than hang
+				ensureMsgf(false, TEXT("Startup jobs have a dependency cycle, running the remaining %d jobs in the order they were added"), NumJobs - NumFinishedJobs);
+				int32 PreviousUnstartedJob = INDEX_NONE;
+				for (int32 JobIndex = 0; JobIndex < NumJobs; ++JobIndex)
+				{
+					if (!JobStates[JobIndex].bStarted)
 					{
-						// 将每个子 job 的权重转换为 0-1 的进度
-						const float SubstepAdjustment = FMath::Clamp(NewProgress, 0.0f, 1.0f) * JobValue;
-						const float OverallPercentWithSubstep = (AccumulatedJobValue + SubstepAdjustment) / TotalJobValue;
+						JobDependencies[JobIndex].Reset();
+						if (PreviousUnstartedJob != INDEX_NONE)
+						{
+							JobDependencies[JobIndex].Add(PreviousUnstartedJob);
+						}
+						PreviousUnstartedJob = JobIndex;
+					}
+				}
+				continue;
+			}
 
-						This->UpdateInitialGameContentLoadPercent(OverallPercentWithSubstep);
-					});
+			{
+				// Waiting on any one handle pumps async loading, which moves every in-flight load along
+				SCOPED_BOOT_TIMING("ULyraAssetManager::DoAllStartupJobs_WaitForLoads");
+				HandleToWaitOn->WaitUntilComplete(1.0f / 60.0f, false);
+			}
 
-				StartupJob.DoJob();
+			for (int32 JobIndex = 0; JobIndex < NumJobs; ++JobIndex)
+			{
+				FStartupJobState& State = JobStates[JobIndex];
+				if (State.bStarted && !State.bFinished && (State.Handle->HasLoadCompleted() || State.Handle->WasCanceled()))
+				{
+					FinishStartupJob(JobIndex);
+					++NumFinishedJobs;
 
-				StartupJob.SubstepProgressDelegate.Unbind();
+					if (bReportProgress)
+					{
+						UpdateOverallProgress();
+					}
+				}
+			}
+		}
 
-				AccumulatedJobValue += JobValue;
+		// Report where the time went, the critical path is the chain of dependent jobs that bounded the total
+		int32 CriticalPathEnd = 0;
+		for (int32 JobIndex = 0; JobIndex < NumJobs; ++JobIndex)
+		{
+			const FStartupJobState& State = JobStates[JobIndex];
+			UE_LOG(LogLyra, Display, TEXT("  Startup job \"%s\": started at +%.2f, %.2f seconds"), *StartupJobs[JobIndex].JobName, State.StartTime - AllStartupJobsStartTime, State.EndTime - State.StartTime);
 
-				UpdateInitialGameContentLoadPercent(AccumulatedJobValue / TotalJobValue);
+			if (State.CriticalPathSeconds > JobStates[CriticalPathEnd].CriticalPathSeconds)
+			{
+				CriticalPathEnd = JobIndex;
 			}
 		}
-		else
+
+		FString CriticalPath;
+		for (int32 JobIndex = CriticalPathEnd; JobIndex != INDEX_NONE; JobIndex = JobStates[JobIndex].CriticalPathPrevious)
 		{
-			UpdateInitialGameContentLoadPercent(1.0f);
+			CriticalPath = CriticalPath.IsEmpty() ? StartupJobs[JobIndex].JobName : (StartupJobs[JobIndex].JobName + TEXT(" -> ") + CriticalPath);
 		}
+		UE_LOG(LogLyra, Display, TEXT("Startup job critical path took %.2f seconds: %s"), JobStates[CriticalPathEnd].CriticalPathSeconds, *CriticalPath);
+	}
+
+	if (bReportProgress)
+	{
+		UpdateInitialGameContentLoadPercent(1.0f);
 	}
 
 	StartupJobs.Empty();
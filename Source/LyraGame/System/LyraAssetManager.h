@@ -115,6 +115,9 @@ private:
 	void InitializeAbilitySystem();
 	void InitializeGameplayCueManager();
 
+	// Starts streaming in the game data without waiting for it, GetGameData picks it up once it has loaded
+	void StartLoadingGameData(TSharedPtr<FStreamableHandle>& LoadHandle);
+
 	// Called periodically during loads, could be used to feed the status to a loading screen
 	// 在加载期间周期性地调用，可以用于向加载界面提供状态
 	void UpdateInitialGameContentLoadPercent(float GameContentPercent);
@@ -7,20 +7,42 @@ TSharedPtr<FStreamableHandle> FLyraAssetManagerStartupJob::DoJob() const
 {
 	const double JobStartTime = FPlatformTime::Seconds();
 
+	TSharedPtr<FStreamableHandle> Handle = StartJob();
+
+	// 目前项目相关的代码逻辑中，没有对 Handle 进行处理，Handle 一直为 nullptr
+	if (Handle.IsValid())
+	{
+		Handle->WaitUntilComplete(0.0f, false);
+	}
+
+	FinishJob(Handle, JobStartTime);
+
+	return Handle;
+}
+
+TSharedPtr<FStreamableHandle> FLyraAssetManagerStartupJob::StartJob() const
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE_TEXT(*JobName);
+
 	TSharedPtr<FStreamableHandle> Handle;
 	UE_LOG(LogLyra, Display, TEXT("Startup job \"%s\" starting"), *JobName);
 	JobFunc(*this, Handle);
 
-	// 目前项目相关的代码逻辑中，没有对 Handle 进行处理，Handle 一直为 nullptr
-	if (Handle.IsValid())
+	if (Handle.IsValid() && !Handle->HasLoadCompleted())
 	{
 		Handle->BindUpdateDelegate(FStreamableUpdateDelegate::CreateRaw(this, &FLyraAssetManagerStartupJob::UpdateSubstepProgressFromStreamable));
-		Handle->WaitUntilComplete(0.0f, false);
-		// @todo 作用是啥？为啥要绑定两次？
+	}
+
+	return Handle;
+}
+
+void FLyraAssetManagerStartupJob::FinishJob(const TSharedPtr<FStreamableHandle>& Handle, double JobStartTime) const
+{
+	if (Handle.IsValid())
+	{
+		// Unbind so the handle doesn't call back into this job if it outlives the startup job list
 		Handle->BindUpdateDelegate(FStreamableUpdateDelegate());
 	}
 
 	UE_LOG(LogLyra, Display, TEXT("Startup job \"%s\" took %.2f seconds to complete"), *JobName, FPlatformTime::Seconds() - JobStartTime);
-
-	return Handle;
 }
@@ -17,6 +17,12 @@ struct FLyraAssetManagerStartupJob
 	float JobWeight;
 	mutable double LastUpdate = 0;
 
+	/**
+	 * Indices (in the asset manager's StartupJobs) of the jobs that have to finish before this one can start, jobs without dependencies on each other can have their loads in flight together.
+	 * Ready jobs are started in the order they were added, so a job that issues a load should be added before the synchronous jobs it can overlap with.
+	 */
+	TArray<int32> Dependencies;
+
 	/** Simple job that is all synchronous */
 	FLyraAssetManagerStartupJob(const FString& InJobName, const TFunction<void(const FLyraAssetManagerStartupJob&, TSharedPtr<FStreamableHandle>&)>& InJobFunc, float InJobWeight)
 		: JobFunc(InJobFunc)
@@ -28,6 +34,19 @@ struct FLyraAssetManagerStartupJob
 	/** 执行实际的加载，如果创建了一个句柄就返回 */
 	TSharedPtr<FStreamableHandle> DoJob() const;
 
+	/** Runs the job function without waiting for the load it started, the job is finished once the returned handle (if any) completes */
+	TSharedPtr<FStreamableHandle> StartJob() const;
+
+	/** Called once the handle returned by StartJob has completed */
+	void FinishJob(const TSharedPtr<FStreamableHandle>& Handle, double JobStartTime) const;
+
+	/** Adds a job that has to finish before this one starts */
+	FLyraAssetManagerStartupJob& AddDependency(int32 DependencyJobIndex)
+	{
+		Dependencies.AddUnique(DependencyJobIndex);
+		return *this;
+	}
+
 	void UpdateSubstepProgress(float NewProgress) const
 	{
 		SubstepProgressDelegate.ExecuteIfBound(NewProgress);
@@ -39,7 +58,7 @@ struct FLyraAssetManagerStartupJob
 		{
 			// StreamableHandle::GetProgress traverses() a large graph and is quite expensive
 			double Now = FPlatformTime::Seconds();
-			if (LastUpdate - Now > 1.0 / 60)
+			if (Now - LastUpdate > 1.0 / 60)
 			{
 				SubstepProgressDelegate.Execute(StreamableHandle->GetProgress());
 				LastUpdate = Now;
@@ -0,0 +1,381 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "LyraSyncLoadProfiler.h"
+#include "Algo/AnyOf.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformStackWalk.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "LyraLogChannels.h"
+
+namespace LyraSyncLoadProfiler
+{
+	static bool bEnabled = true;
+	static FAutoConsoleVariableRef CVarEnabled(
+		TEXT("lyra.SyncLoads.Enabled"),
+		bEnabled,
+		TEXT("Should synchronous loads made through the asset manager be recorded (see Lyra.SyncLoads.Dump)"),
+		ECVF_Default);
+
+	static int32 BufferSize = 512;
+	static FAutoConsoleVariableRef CVarBufferSize(
+		TEXT("lyra.SyncLoads.BufferSize"),
+		BufferSize,
+		TEXT("How many of the most recent synchronous loads are kept, changing it clears the records"),
+		ECVF_Default);
+
+	static bool bCaptureCallStacks = true;
+	static FAutoConsoleVariableRef CVarCaptureCallStacks(
+		TEXT("lyra.SyncLoads.CaptureCallStacks"),
+		bCaptureCallStacks,
+		TEXT("Should a short call stack be captured for each synchronous load so the dump can say where it came from"),
+		ECVF_Default);
+
+	static bool bLearnPreloads = true;
+	static FAutoConsoleVariableRef CVarLearnPreloads(
+		TEXT("lyra.SyncLoads.LearnPreloads"),
+		bLearnPreloads,
+		TEXT("Should assets synchronously loaded on the game thread while an experience is running be saved to that experience's learned preload manifest"),
+		ECVF_Default);
+
+	static int32 MaxLearnedPreloads = 256;
+	static FAutoConsoleVariableRef CVarMaxLearnedPreloads(
+		TEXT("lyra.SyncLoads.MaxLearnedPreloads"),
+		MaxLearnedPreloads,
+		TEXT("Most assets kept in each experience's learned preload manifest, the oldest entries are dropped first"),
+		ECVF_Default);
+
+	static FAutoConsoleCommand CmdDump(
+		TEXT("Lyra.SyncLoads.Dump"),
+		TEXT("Writes the recorded synchronous loads to a file in the profiling directory. Usage: Lyra.SyncLoads.Dump [csv|json]"),
+		FConsoleCommandWithArgsDelegate::CreateStatic([](const TArray<FString>& Args)
+		{
+			const bool bAsJson = (Args.Num() > 0) && (Args[0] == TEXT("json"));
+			FLyraSyncLoadProfiler::Get().DumpToFile(bAsJson);
+		}));
+
+	static FAutoConsoleCommand CmdReset(
+		TEXT("Lyra.SyncLoads.Reset"),
+		TEXT("Clears the recorded synchronous loads"),
+		FConsoleCommandDelegate::CreateStatic([]()
+		{
+			FLyraSyncLoadProfiler::Get().Reset();
+		}));
+
+	static FAutoConsoleCommand CmdSaveLearnedPreloads(
+		TEXT("Lyra.SyncLoads.SaveLearnedPreloads"),
+		TEXT("Saves the assets learned so far for the current experience to its preload manifest (this also happens when the experience ends)"),
+		FConsoleCommandDelegate::CreateStatic([]()
+		{
+			FLyraSyncLoadProfiler::Get().SaveLearnedPreloads();
+		}));
+
+	// Frames belonging to the profiler or the asset manager load functions, skipped when looking for the caller
+	static const ANSICHAR* const IgnoredCallSiteFunctions[] =
+	{
+		"StackWalk",
+		"StackBackTrace",
+		"FLyraScopedSyncLoadRecord",
+		"ULyraAssetManager::SynchronousLoadAsset",
+		"ULyraAssetManager::GetAsset",
+		"ULyraAssetManager::GetSubclass",
+	};
+
+	static FString EscapeCsv(const FString& Value)
+	{
+		return FString::Printf(TEXT("\"%s\""), *Value.Replace(TEXT("\""), TEXT("\"\"")));
+	}
+
+	static FString EscapeJson(const FString& Value)
+	{
+		return Value.Replace(TEXT("\\"), TEXT("\\\\")).Replace(TEXT("\""), TEXT("\\\"")).Replace(TEXT("\n"), TEXT("\\n"));
+	}
+}
+
+//////////////////////////////////////////////////////////////////////
+// FLyraScopedSyncLoadRecord
+
+FLyraScopedSyncLoadRecord::FLyraScopedSyncLoadRecord(const FSoftObjectPath& AssetPath, const TCHAR* CallSiteName)
+{
+	bRecording = FLyraSyncLoadProfiler::IsEnabled();
+	if (bRecording)
+	{
+		Record.AssetPath = AssetPath;
+		Record.CallSiteName = CallSiteName;
+		Record.FrameNumber = GFrameCounter;
+		Record.bGameThread = IsInGameThread();
+
+		// Only the raw addresses are captured here, resolving them to symbols is far too slow to do for every load
+		if (LyraSyncLoadProfiler::bCaptureCallStacks && (CallSiteName == nullptr))
+		{
+			Record.CallStackDepth = (int32)FPlatformStackWalk::CaptureStackBackTrace(Record.CallStack, FLyraSyncLoadRecord::MaxCallStackDepth);
+		}
+
+		Record.StartTime = FPlatformTime::Seconds();
+	}
+}
+
+FLyraScopedSyncLoadRecord::~FLyraScopedSyncLoadRecord()
+{
+	if (bRecording)
+	{
+		Record.DurationSeconds = FPlatformTime::Seconds() - Record.StartTime;
+		FLyraSyncLoadProfiler::Get().RecordLoad(MoveTemp(Record));
+	}
+}
+
+//////////////////////////////////////////////////////////////////////
+// FLyraSyncLoadProfiler
+
+FLyraSyncLoadProfiler& FLyraSyncLoadProfiler::Get()
+{
+	static FLyraSyncLoadProfiler Singleton;
+	return Singleton;
+}
+
+bool FLyraSyncLoadProfiler::IsEnabled()
+{
+	return LyraSyncLoadProfiler::bEnabled && (LyraSyncLoadProfiler::BufferSize > 0);
+}
+
+void FLyraSyncLoadProfiler::RecordLoad(FLyraSyncLoadRecord&& Record)
+{
+	FScopeLock ScopeLock(&Lock);
+
+	Record.Experience = CurrentExperience;
+
+	// Only game thread loads stall the frame, loads from other threads aren't worth preloading for
+	if (LyraSyncLoadProfiler::bLearnPreloads && Record.bGameThread && CurrentExperience.IsValid())
+	{
+		UnsavedLearnedAssets.Add(Record.AssetPath);
+	}
+
+	// Once the buffer has wrapped the records aren't in order any more, so a new size starts it over
+	const int32 Capacity = LyraSyncLoadProfiler::BufferSize;
+	if (Capacity != RecordsCapacity)
+	{
+		Records.Reset();
+		NextRecordIndex = 0;
+		RecordsCapacity = Capacity;
+	}
+
+	if (Records.Num() < Capacity)
+	{
+		Records.Add(MoveTemp(Record));
+	}
+	else
+	{
+		Records[NextRecordIndex] = MoveTemp(Record);
+		NextRecordIndex = (NextRecordIndex + 1) % Capacity;
+	}
+}
+
+void FLyraSyncLoadProfiler::SetCurrentExperience(const UWorld* World, const FPrimaryAssetId& ExperienceId)
+{
+	FScopeLock ScopeLock(&Lock);
+
+	// Loads can't be told apart by world, so only one world (the first to start an experience) is learned from at a time
+	const UWorld* LearningWorld = CurrentExperienceWorld.Get();
+	if ((LearningWorld != nullptr) && (LearningWorld != World))
+	{
+		return;
+	}
+
+	if (CurrentExperience != ExperienceId)
+	{
+		SaveLearnedPreloads_Locked();
+		CurrentExperience = ExperienceId;
+	}
+
+	CurrentExperienceWorld = ExperienceId.IsValid() ? World : nullptr;
+}
+
+void FLyraSyncLoadProfiler::SaveLearnedPreloads()
+{
+	FScopeLock ScopeLock(&Lock);
+	SaveLearnedPreloads_Locked();
+}
+
+void FLyraSyncLoadProfiler::SaveLearnedPreloads_Locked()
+{
+	if (!CurrentExperience.IsValid() || (UnsavedLearnedAssets.Num() == 0))
+	{
+		UnsavedLearnedAssets.Reset();
+		return;
+	}
+
+	const FString Filename = GetLearnedPreloadsFilename(CurrentExperience);
+
+	// Merge with what earlier runs learned, assets they learned get preloaded now and so won't show up as sync loads again
+	TArray<FString> AssetPaths;
+	FFileHelper::LoadFileToStringArray(AssetPaths, *Filename);
+
+	int32 NumAdded = 0;
+	for (const FSoftObjectPath& AssetPath : UnsavedLearnedAssets)
+	{
+		if (!AssetPaths.Contains(AssetPath.ToString()))
+		{
+			AssetPaths.Add(AssetPath.ToString());
+			++NumAdded;
+		}
+	}
+	UnsavedLearnedAssets.Reset();
+
+	const int32 NumToDrop = AssetPaths.Num() - FMath::Max(LyraSyncLoadProfiler::MaxLearnedPreloads, 0);
+	if (NumToDrop > 0)
+	{
+		AssetPaths.RemoveAt(0, NumToDrop);
+	}
+
+	if (NumAdded > 0)
+	{
+		if (FFileHelper::SaveStringArrayToFile(AssetPaths, *Filename))
+		{
+			UE_LOG(LogLyra, Log, TEXT("Learned %d new preloads for %s (%d total) in %s"), NumAdded, *CurrentExperience.ToString(), AssetPaths.Num(), *Filename);
+		}
+		else
+		{
+			UE_LOG(LogLyra, Warning, TEXT("Failed to write learned preloads for %s to %s"), *CurrentExperience.ToString(), *Filename);
+		}
+	}
+}
+
+void FLyraSyncLoadProfiler::GetLearnedPreloads(const FPrimaryAssetId& ExperienceId, TArray<FSoftObjectPath>& OutAssetPaths) const
+{
+	TArray<FString> AssetPaths;
+	if (ExperienceId.IsValid() && FFileHelper::LoadFileToStringArray(AssetPaths, *GetLearnedPreloadsFilename(ExperienceId)))
+	{
+		for (const FString& AssetPath : AssetPaths)
+		{
+			FSoftObjectPath SoftPath(AssetPath);
+			if (SoftPath.IsValid())
+			{
+				OutAssetPaths.Add(MoveTemp(SoftPath));
+			}
+		}
+	}
+}
+
+FString FLyraSyncLoadProfiler::GetLearnedPreloadsFilename(const FPrimaryAssetId& ExperienceId)
+{
+	return FPaths::ProjectSavedDir() / TEXT("LearnedPreloads") / FString::Printf(TEXT("%s_%s.txt"), *ExperienceId.PrimaryAssetType.ToString(), *ExperienceId.PrimaryAssetName.ToString());
+}
+
+void FLyraSyncLoadProfiler::GetRecords(TArray<FLyraSyncLoadRecord>& OutRecords) const
+{
+	FScopeLock ScopeLock(&Lock);
+
+	OutRecords.Reserve(OutRecords.Num() + Records.Num());
+	for (int32 Offset = 0; Offset < Records.Num(); ++Offset)
+	{
+		OutRecords.Add(Records[(NextRecordIndex + Offset) % Records.Num()]);
+	}
+}
+
+void FLyraSyncLoadProfiler::Reset()
+{
+	FScopeLock ScopeLock(&Lock);
+
+	Records.Reset();
+	NextRecordIndex = 0;
+}
+
+FString FLyraSyncLoadProfiler::DescribeCallSite(const FLyraSyncLoadRecord& Record)
+{
+	if (Record.CallSiteName != nullptr)
+	{
+		return Record.CallSiteName;
+	}
+
+	for (int32 FrameIndex = 0; FrameIndex < Record.CallStackDepth; ++FrameIndex)
+	{
+		FProgramCounterSymbolInfo SymbolInfo;
+		FPlatformStackWalk::ProgramCounterToSymbolInfo(Record.CallStack[FrameIndex], SymbolInfo);
+
+		const bool bIgnored = (SymbolInfo.FunctionName[0] == '\0') || Algo::AnyOf(LyraSyncLoadProfiler::IgnoredCallSiteFunctions, [&SymbolInfo](const ANSICHAR* IgnoredFunction)
+		{
+			return FCStringAnsi::Strstr(SymbolInfo.FunctionName, IgnoredFunction) != nullptr;
+		});
+
+		if (!bIgnored)
+		{
+			return (SymbolInfo.LineNumber > 0) ?
+				FString::Printf(TEXT("%s (%s:%d)"), ANSI_TO_TCHAR(SymbolInfo.FunctionName), *FPaths::GetCleanFilename(ANSI_TO_TCHAR(SymbolInfo.Filename)), SymbolInfo.LineNumber) :
+				FString(ANSI_TO_TCHAR(SymbolInfo.FunctionName));
+		}
+	}
+
+	// No symbols, the raw addresses are still useful with the matching binary
+	TStringBuilder<256> Addresses;
+	for (int32 FrameIndex = 0; FrameIndex < Record.CallStackDepth; ++FrameIndex)
+	{
+		Addresses.Appendf(TEXT("%s0x%llx"), (FrameIndex > 0) ? TEXT(" ") : TEXT(""), Record.CallStack[FrameIndex]);
+	}
+	return Addresses.ToString();
+}
+
+FString FLyraSyncLoadProfiler::DumpToFile(bool bAsJson) const
+{
+	TArray<FLyraSyncLoadRecord> RecordsToDump;
+	GetRecords(RecordsToDump);
+
+	TStringBuilder<4096> Output;
+	double TotalGameThreadSeconds = 0.0;
+
+	if (bAsJson)
+	{
+		Output.Append(TEXT("[\n"));
+	}
+	else
+	{
+		Output.Append(TEXT("Frame,Time,DurationMs,GameThread,Experience,Asset,CallSite\n"));
+	}
+
+	for (int32 RecordIndex = 0; RecordIndex < RecordsToDump.Num(); ++RecordIndex)
+	{
+		const FLyraSyncLoadRecord& Record = RecordsToDump[RecordIndex];
+		const FString CallSite = DescribeCallSite(Record);
+		const double TimeSinceStart = Record.StartTime - GStartTime;
+		const double DurationMs = Record.DurationSeconds * 1000.0;
+
+		if (Record.bGameThread)
+		{
+			TotalGameThreadSeconds += Record.DurationSeconds;
+		}
+
+		if (bAsJson)
+		{
+			Output.Appendf(TEXT("\t{ \"frame\": %llu, \"time\": %.4f, \"durationMs\": %.3f, \"gameThread\": %s, \"experience\": \"%s\", \"asset\": \"%s\", \"callSite\": \"%s\" }%s\n"),
+				Record.FrameNumber, TimeSinceStart, DurationMs, Record.bGameThread ? TEXT("true") : TEXT("false"),
+				*LyraSyncLoadProfiler::EscapeJson(Record.Experience.ToString()), *LyraSyncLoadProfiler::EscapeJson(Record.AssetPath.ToString()), *LyraSyncLoadProfiler::EscapeJson(CallSite),
+				(RecordIndex + 1 < RecordsToDump.Num()) ? TEXT(",") : TEXT(""));
+		}
+		else
+		{
+			Output.Appendf(TEXT("%llu,%.4f,%.3f,%d,%s,%s,%s\n"),
+				Record.FrameNumber, TimeSinceStart, DurationMs, Record.bGameThread ? 1 : 0,
+				*LyraSyncLoadProfiler::EscapeCsv(Record.Experience.ToString()), *LyraSyncLoadProfiler::EscapeCsv(Record.AssetPath.ToString()), *LyraSyncLoadProfiler::EscapeCsv(CallSite));
+		}
+	}
+
+	if (bAsJson)
+	{
+		Output.Append(TEXT("]\n"));
+	}
+
+	const FString OutputDir = FPaths::ProfilingDir() / TEXT("SyncLoads");
+	IFileManager::Get().MakeDirectory(*OutputDir, true);
+
+	const FString Filename = OutputDir / FString::Printf(TEXT("SyncLoads-%s.%s"), *FDateTime::Now().ToString(), bAsJson ? TEXT("json") : TEXT("csv"));
+	if (!FFileHelper::SaveStringToFile(Output.ToView(), *Filename))
+	{
+		UE_LOG(LogLyra, Warning, TEXT("Failed to write synchronous loads to %s"), *Filename);
+		return FString();
+	}
+
+	UE_LOG(LogLyra, Log, TEXT("Wrote %d synchronous loads (%.2f ms on the game thread) to %s"), RecordsToDump.Num(), TotalGameThreadSeconds * 1000.0, *Filename);
+	return Filename;
+}
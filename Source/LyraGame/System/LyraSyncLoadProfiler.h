@@ -0,0 +1,104 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/PrimaryAssetId.h"
+#include "UObject/SoftObjectPath.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+
+class UWorld;
+
+/** One synchronous load, as recorded by FLyraSyncLoadProfiler */
+struct FLyraSyncLoadRecord
+{
+	static constexpr int32 MaxCallStackDepth = 8;
+
+	FSoftObjectPath AssetPath;
+
+	// Name of the code that asked for the load when it is known up front (a static string), otherwise resolved from CallStack when dumped
+	const TCHAR* CallSiteName = nullptr;
+
+	// Experience that was loading or running at the time
+	FPrimaryAssetId Experience;
+
+	uint64 CallStack[MaxCallStackDepth] = {};
+	int32 CallStackDepth = 0;
+
+	uint64 FrameNumber = 0;
+	double StartTime = 0.0;
+	double DurationSeconds = 0.0;
+	bool bGameThread = false;
+};
+
+/**
+ * FLyraSyncLoadProfiler
+ *
+ *	Always-on record of the synchronous loads made through ULyraAssetManager, kept in a fixed size ring buffer.
+ *	Call stacks are captured as raw program counters and only turned into names when the records are dumped (Lyra.SyncLoads.Dump).
+ *
+ *	It also learns which assets get sync loaded while each experience is running, and saves them to a manifest in the saved directory
+ *	so the experience manager can stream them in ahead of time on later runs (see GetLearnedPreloads).
+ */
+class FLyraSyncLoadProfiler
+{
+public:
+	static FLyraSyncLoadProfiler& Get();
+
+	// Returns true if loads should be recorded (lyra.SyncLoads.Enabled)
+	static bool IsEnabled();
+
+	// Adds a finished load to the ring buffer and to the learned assets of the current experience
+	void RecordLoad(FLyraSyncLoadRecord&& Record);
+
+	// Sets the experience new records are attributed to (an invalid id when it ends), saving what was learned for the previous one first.
+	// Only the world that set it can change it until it is cleared, so other worlds (e.g., other PIE instances) don't mix up the learned assets
+	void SetCurrentExperience(const UWorld* World, const FPrimaryAssetId& ExperienceId);
+
+	// Merges the assets learned for the current experience into its manifest on disk
+	void SaveLearnedPreloads();
+
+	// Returns the assets in the learned manifest for an experience (empty if there isn't one)
+	void GetLearnedPreloads(const FPrimaryAssetId& ExperienceId, TArray<FSoftObjectPath>& OutAssetPaths) const;
+
+	// Returns a copy of the recorded loads, oldest first
+	void GetRecords(TArray<FLyraSyncLoadRecord>& OutRecords) const;
+
+	// Writes the recorded loads to a CSV or JSON file in the profiling directory, returning the filename (empty on failure)
+	FString DumpToFile(bool bAsJson) const;
+
+	void Reset();
+
+private:
+	static FString GetLearnedPreloadsFilename(const FPrimaryAssetId& ExperienceId);
+	static FString DescribeCallSite(const FLyraSyncLoadRecord& Record);
+
+	void SaveLearnedPreloads_Locked();
+
+private:
+	mutable FCriticalSection Lock;
+
+	// Ring buffer of records, NextRecordIndex is the oldest once it has wrapped
+	TArray<FLyraSyncLoadRecord> Records;
+	int32 NextRecordIndex = 0;
+
+	// lyra.SyncLoads.BufferSize when Records was started
+	int32 RecordsCapacity = 0;
+
+	FPrimaryAssetId CurrentExperience;
+	TWeakObjectPtr<const UWorld> CurrentExperienceWorld;
+
+	// Assets sync loaded while the current experience was active that haven't been saved to its manifest yet
+	TSet<FSoftObjectPath> UnsavedLearnedAssets;
+};
+
+/** Times a synchronous load and records it with FLyraSyncLoadProfiler when it goes out of scope */
+struct FLyraScopedSyncLoadRecord
+{
+	FLyraScopedSyncLoadRecord(const FSoftObjectPath& AssetPath, const TCHAR* CallSiteName = nullptr);
+	~FLyraScopedSyncLoadRecord();
+
+private:
+	FLyraSyncLoadRecord Record;
+	bool bRecording = false;
+};
@@ -7,7 +7,7 @@ UCircumferenceMarkerWidget::UCircumferenceMarkerWidget(const FObjectInitializer&
 	: Super(ObjectInitializer)
 {
 	Visibility = ESlateVisibility::HitTestInvisible;
-	bIsVolatile = true;
+	bIsVolatile = false;
 }
 
 void UCircumferenceMarkerWidget::ReleaseSlateResources(bool bReleaseChildren)
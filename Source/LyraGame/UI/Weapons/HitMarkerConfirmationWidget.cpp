@@ -8,7 +8,7 @@ UHitMarkerConfirmationWidget::UHitMarkerConfirmationWidget(const FObjectInitiali
 	: Super(ObjectInitializer)
 {
 	Visibility = ESlateVisibility::HitTestInvisible;
-	bIsVolatile = true;
+	bIsVolatile = false;
 	AnyHitsMarkerImage.DrawAs = ESlateBrushDrawType::NoDrawType;
 }
 
@@ -39,8 +39,28 @@ FSlateRenderTransform SCircumferenceMarkerWidget::GetMarkerRenderTransform(const
 	return TransformCast<FSlateRenderTransform>(Concatenate(RotateAboutOrigin, FVector2D(XRadius * FMath::Sin(PositionAngleRadians) * HUDScale, -YRadius * FMath::Cos(PositionAngleRadians) * HUDScale)));
 }
 
+void SCircumferenceMarkerWidget::UpdateMarkerRenderTransforms(const float BaseRadius, const float HUDScale) const
+{
+	if (!bMarkerRenderTransformsDirty && (BaseRadius == MarkerRenderTransformsRadius) && (HUDScale == MarkerRenderTransformsHUDScale))
+	{
+		return;
+	}
+
+	bMarkerRenderTransformsDirty = false;
+	MarkerRenderTransformsRadius = BaseRadius;
+	MarkerRenderTransformsHUDScale = HUDScale;
+
+	MarkerRenderTransforms.Reset(MarkerList.Num());
+	for (const FCircumferenceMarkerEntry& Marker : MarkerList)
+	{
+		MarkerRenderTransforms.Add(GetMarkerRenderTransform(Marker, BaseRadius, HUDScale));
+	}
+}
+
 int32 SCircumferenceMarkerWidget::OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const
 {
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_SCircumferenceMarkerWidget_OnPaint);
+
 	const bool bIsEnabled = ShouldBeEnabled(bParentEnabled);
 	const ESlateDrawEffect DrawEffects = bIsEnabled ? ESlateDrawEffect::None : ESlateDrawEffect::DisabledEffect;
 	const FVector2D LocalCenter = AllottedGeometry.GetLocalPositionAtCoordinates(FVector2D(0.5f, 0.5f));
@@ -57,10 +77,10 @@ int32 SCircumferenceMarkerWidget::OnPaint(const FPaintArgs& Args, const FGeometr
 		{
 			const float BaseRadius = Radius.Get();
 			const float ApplicationScale = GetDefault<UUserInterfaceSettings>()->ApplicationScale;
-			for (const FCircumferenceMarkerEntry& Marker : MarkerList)
-			{
-				const FSlateRenderTransform MarkerTransform = GetMarkerRenderTransform(Marker, BaseRadius, ApplicationScale);
+			UpdateMarkerRenderTransforms(BaseRadius, ApplicationScale);
 
+			for (const FSlateRenderTransform& MarkerTransform : MarkerRenderTransforms)
+			{
 				const FPaintGeometry Geometry(AllottedGeometry.ToPaintGeometry(MarkerBrush->ImageSize, FSlateLayoutTransform(LocalCenter - (MarkerBrush->ImageSize * 0.5f)), MarkerTransform, FVector2D(0.0f, 0.0f)));
 				FSlateDrawElement::MakeBox(OutDrawElements, LayerId, Geometry, MarkerBrush, DrawEffects, MarkerColor);
 			}
@@ -89,4 +109,6 @@ void SCircumferenceMarkerWidget::SetRadius(float NewRadius)
 void SCircumferenceMarkerWidget::SetMarkerList(TArray<FCircumferenceMarkerEntry>& NewMarkerList)
 {
 	MarkerList = NewMarkerList;
+	bMarkerRenderTransformsDirty = true;
+	Invalidate(EInvalidateWidgetReason::Paint);
 }
@@ -49,7 +49,7 @@ public:
 	//~SWidget interface
 	virtual int32 OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const override;
 	virtual FVector2D ComputeDesiredSize(float) const override;
-	virtual bool ComputeVolatility() const override { return true; }
+	virtual bool ComputeVolatility() const override { return Radius.IsBound() || ColorAndOpacity.IsBound(); }
 	//~End of SWidget interface
 
 	void SetRadius(float NewRadius);
@@ -58,6 +58,9 @@ public:
 private:
 	FSlateRenderTransform GetMarkerRenderTransform(const FCircumferenceMarkerEntry& Marker, const float BaseRadius, const float HUDScale) const;
 
+	/** Rebuilds the cached marker transforms if the radius, HUD scale or marker list changed since they were built */
+	void UpdateMarkerRenderTransforms(const float BaseRadius, const float HUDScale) const;
+
 private:
 	/** What each marker on the circumference looks like */
 	const FSlateBrush* MarkerBrush;
@@ -65,6 +68,12 @@ private:
 	/** Angles around the reticle center to place ReticleCornerImage icons */
 	TArray<FCircumferenceMarkerEntry> MarkerList;
 
+	/** Render transform of each entry in MarkerList, and the radius and HUD scale they were built for */
+	mutable TArray<FSlateRenderTransform> MarkerRenderTransforms;
+	mutable float MarkerRenderTransformsRadius = 0.0f;
+	mutable float MarkerRenderTransformsHUDScale = 0.0f;
+	mutable bool bMarkerRenderTransformsDirty = true;
+
 	/** The radius of the circle */
 	TAttribute<float> Radius;
 
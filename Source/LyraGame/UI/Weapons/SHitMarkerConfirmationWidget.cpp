@@ -12,6 +12,7 @@ void SHitMarkerConfirmationWidget::Construct(const FArguments& InArgs, const FLo
 	PerHitMarkerImage = InArgs._PerHitMarkerImage;
 	PerHitMarkerZoneOverrideImages = ZoneOverrideImages;
 	AnyHitsMarkerImage = InArgs._AnyHitsMarkerImage;
+	HitNotifyDuration = InArgs._HitNotifyDuration.Get();
 	bColorAndOpacitySet = InArgs._ColorAndOpacity.IsSet();
 	ColorAndOpacity = InArgs._ColorAndOpacity;
 
@@ -20,6 +21,8 @@ void SHitMarkerConfirmationWidget::Construct(const FArguments& InArgs, const FLo
 
 int32 SHitMarkerConfirmationWidget::OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const
 {
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_SHitMarkerConfirmationWidget_OnPaint);
+
 	const bool bIsEnabled = ShouldBeEnabled(bParentEnabled);
 	const ESlateDrawEffect DrawEffects = bIsEnabled ? ESlateDrawEffect::None : ESlateDrawEffect::DisabledEffect;
 	const FVector2D LocalCenter = AllottedGeometry.GetLocalPositionAtCoordinates(FVector2D(0.5f, 0.5f));
@@ -28,41 +31,27 @@ int32 SHitMarkerConfirmationWidget::OnPaint(const FPaintArgs& Args, const FGeome
 
 	if (bDrawMarkers)
 	{
-		// Check if we should use screen-space damage location hit notifies
-		TArray<FLyraScreenSpaceHitLocation> LastWeaponDamageScreenLocations;
-		if (APlayerController* PC = MyContext.IsInitialized() ? MyContext.GetPlayerController() : nullptr)
+		// Draw the hits that were cached in Tick at their screen-space damage locations
+		if (CachedHitMarkers.Num() > 0)
 		{
-			if (ULyraWeaponStateComponent* WeaponStateComponent = PC->FindComponentByClass<ULyraWeaponStateComponent>())
-			{
-				WeaponStateComponent->GetLastWeaponDamageScreenLocations(/*out*/ LastWeaponDamageScreenLocations);
-			}
-		}
+			UpdateLocalHitMarkerPositions(AllottedGeometry, MyCullingRect);
 
-		if ((LastWeaponDamageScreenLocations.Num() > 0) && (PerHitMarkerImage != nullptr))
-		{
-			const FVector2D HalfAbsoluteSize = AllottedGeometry.GetAbsoluteSize() * 0.5f;
-
-			for (const FLyraScreenSpaceHitLocation& Hit : LastWeaponDamageScreenLocations)
+			for (int32 HitIndex = 0; HitIndex < CachedHitMarkers.Num(); ++HitIndex)
 			{
-				const FSlateBrush* LocationMarkerImage = PerHitMarkerZoneOverrideImages.Find(Hit.HitZone);
-				if (LocationMarkerImage == nullptr)
-				{
-					LocationMarkerImage = PerHitMarkerImage;
-				}
+				const FSlateBrush* LocationMarkerImage = CachedHitMarkers[HitIndex].Image;
 
 				FLinearColor MarkerColor = bColorAndOpacitySet ?
 					ColorAndOpacity.Get().GetColor(InWidgetStyle) :
 					(InWidgetStyle.GetColorAndOpacityTint() * LocationMarkerImage->GetTint(InWidgetStyle));
 				MarkerColor.A *= HitNotifyOpacity;
 
-				const FVector2D WindowSSLocation = Hit.Location + MyCullingRect.GetTopLeft(); // Accounting for window trim when not in fullscreen mode
-				const FSlateRenderTransform DrawPos(AllottedGeometry.AbsoluteToLocal(WindowSSLocation));
+				const FSlateRenderTransform DrawPos(LocalHitMarkerPositions[HitIndex]);
 
 				const FPaintGeometry Geometry(AllottedGeometry.ToPaintGeometry(LocationMarkerImage->ImageSize, FSlateLayoutTransform(-(LocationMarkerImage->ImageSize * 0.5f)), DrawPos));
 				FSlateDrawElement::MakeBox(OutDrawElements, LayerId, Geometry, LocationMarkerImage, DrawEffects, MarkerColor);
 			}
 		}
-		
+
 		if (AnyHitsMarkerImage != nullptr)
 		{
 			FLinearColor MarkerColor = bColorAndOpacitySet ?
@@ -86,17 +75,91 @@ FVector2D SHitMarkerConfirmationWidget::ComputeDesiredSize(float) const
 
 void SHitMarkerConfirmationWidget::Tick(const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime)
 {
+	const float OldHitNotifyOpacity = HitNotifyOpacity;
+	bool bHitMarkersChanged = false;
+
 	HitNotifyOpacity = 0.0f;
 
-	if (APlayerController* PC = MyContext.IsInitialized() ? MyContext.GetPlayerController() : nullptr)
+	if (ULyraWeaponStateComponent* DamageMarkerComponent = FindWeaponStateComponent())
 	{
-		if (ULyraWeaponStateComponent* DamageMarkerComponent = PC->FindComponentByClass<ULyraWeaponStateComponent>())
+		const double TimeSinceLastHitNotification = DamageMarkerComponent->GetTimeSinceLastHitNotification();
+		if (TimeSinceLastHitNotification < HitNotifyDuration)
 		{
-			const double TimeSinceLastHitNotification = DamageMarkerComponent->GetTimeSinceLastHitNotification();
-			if (TimeSinceLastHitNotification < HitNotifyDuration)
+			HitNotifyOpacity = FMath::Clamp(1.0f - (float)(TimeSinceLastHitNotification / HitNotifyDuration), 0.0f, 1.0f);
+			bHitMarkersChanged = UpdateCachedHitMarkers(*DamageMarkerComponent);
+		}
+	}
+
+	// The fade only changes the tint of the cached markers, so we only need to repaint while it is changing or the hits change
+	if (bHitMarkersChanged || (HitNotifyOpacity != OldHitNotifyOpacity))
+	{
+		Invalidate(EInvalidateWidgetReason::Paint);
+	}
+}
+
+ULyraWeaponStateComponent* SHitMarkerConfirmationWidget::FindWeaponStateComponent()
+{
+	APlayerController* PC = MyContext.IsInitialized() ? MyContext.GetPlayerController() : nullptr;
+	if (PC != CachedPlayerController.Get())
+	{
+		CachedPlayerController = PC;
+		CachedWeaponStateComponent = (PC != nullptr) ? PC->FindComponentByClass<ULyraWeaponStateComponent>() : nullptr;
+		bHasCachedHitMarkers = false;
+	}
+
+	return CachedWeaponStateComponent.Get();
+}
+
+bool SHitMarkerConfirmationWidget::UpdateCachedHitMarkers(const ULyraWeaponStateComponent& WeaponStateComponent)
+{
+	const uint32 HitMarkersSerial = WeaponStateComponent.GetLastWeaponDamageScreenLocationsSerial();
+	if (bHasCachedHitMarkers && (HitMarkersSerial == CachedHitMarkersSerial))
+	{
+		return false;
+	}
+
+	bHasCachedHitMarkers = true;
+	CachedHitMarkersSerial = HitMarkersSerial;
+	CachedHitMarkers.Reset();
+	bLocalHitMarkerPositionsDirty = true;
+
+	if (PerHitMarkerImage != nullptr)
+	{
+		TArray<FLyraScreenSpaceHitLocation> LastWeaponDamageScreenLocations;
+		WeaponStateComponent.GetLastWeaponDamageScreenLocations(/*out*/ LastWeaponDamageScreenLocations);
+
+		for (const FLyraScreenSpaceHitLocation& Hit : LastWeaponDamageScreenLocations)
+		{
+			const FSlateBrush* LocationMarkerImage = PerHitMarkerZoneOverrideImages.Find(Hit.HitZone);
+			if (LocationMarkerImage == nullptr)
 			{
-				HitNotifyOpacity = FMath::Clamp(1.0f - (float)(TimeSinceLastHitNotification / HitNotifyDuration), 0.0f, 1.0f);
+				LocationMarkerImage = PerHitMarkerImage;
 			}
+
+			CachedHitMarkers.Add({ Hit.Location, LocationMarkerImage });
 		}
 	}
+
+	return true;
+}
+
+void SHitMarkerConfirmationWidget::UpdateLocalHitMarkerPositions(const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect) const
+{
+	const FSlateRenderTransform& PaintTransform = AllottedGeometry.GetAccumulatedRenderTransform();
+	const FVector2D WindowOffset = MyCullingRect.GetTopLeft(); // Accounting for window trim when not in fullscreen mode
+
+	if (!bLocalHitMarkerPositionsDirty && (PaintTransform == LocalHitMarkerPositionsTransform) && (WindowOffset == LocalHitMarkerPositionsWindowOffset))
+	{
+		return;
+	}
+
+	bLocalHitMarkerPositionsDirty = false;
+	LocalHitMarkerPositionsTransform = PaintTransform;
+	LocalHitMarkerPositionsWindowOffset = WindowOffset;
+
+	LocalHitMarkerPositions.Reset(CachedHitMarkers.Num());
+	for (const FCachedHitMarker& Hit : CachedHitMarkers)
+	{
+		LocalHitMarkerPositions.Add(AllottedGeometry.AbsoluteToLocal(Hit.ScreenLocation + WindowOffset));
+	}
 }
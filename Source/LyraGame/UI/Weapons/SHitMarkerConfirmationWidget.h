@@ -12,6 +12,7 @@
 #include "GameplayTagContainer.h"
 
 struct FLocalPlayerContext;
+class ULyraWeaponStateComponent;
 
 class SHitMarkerConfirmationWidget : public SLeafWidget
 {
@@ -40,10 +41,42 @@ public:
 	virtual int32 OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const override;
 	virtual void Tick(const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime) override;
 	virtual FVector2D ComputeDesiredSize(float) const override;
-	virtual bool ComputeVolatility() const override { return true; }
+	virtual bool ComputeVolatility() const override { return ColorAndOpacity.IsBound(); }
 	//~End of SWidget interface
 
 private:
+	ULyraWeaponStateComponent* FindWeaponStateComponent();
+
+	/** Copies the hit locations from the weapon state component if they changed, returns true if they did */
+	bool UpdateCachedHitMarkers(const ULyraWeaponStateComponent& WeaponStateComponent);
+
+	/** Converts the cached hit locations into local space, only when the hits or our geometry changed since the last paint */
+	void UpdateLocalHitMarkerPositions(const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect) const;
+
+private:
+	struct FCachedHitMarker
+	{
+		/** Hit location in viewport screenspace */
+		FVector2D ScreenLocation;
+
+		/** The marker image for the hit zone */
+		const FSlateBrush* Image = nullptr;
+	};
+
+	/** The hits being displayed, with their marker images already resolved */
+	TArray<FCachedHitMarker> CachedHitMarkers;
+	uint32 CachedHitMarkersSerial = 0;
+	bool bHasCachedHitMarkers = false;
+
+	/** Local space positions of CachedHitMarkers, and what they were computed for */
+	mutable TArray<FVector2D> LocalHitMarkerPositions;
+	mutable FSlateRenderTransform LocalHitMarkerPositionsTransform;
+	mutable FVector2D LocalHitMarkerPositionsWindowOffset = FVector2D::ZeroVector;
+	mutable bool bLocalHitMarkerPositionsDirty = true;
+
+	TWeakObjectPtr<APlayerController> CachedPlayerController;
+	TWeakObjectPtr<ULyraWeaponStateComponent> CachedWeaponStateComponent;
+
 	/** The marker image to draw for individual hit markers. */
 	const FSlateBrush* PerHitMarkerImage = nullptr;
 
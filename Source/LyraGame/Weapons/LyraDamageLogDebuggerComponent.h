@@ -10,13 +10,7 @@
 
 struct FLyraVerbMessage;
 
-struct FFrameDamageEntry
-{
-	int32 NumImpacts = 0;
-	double SumDamage = 0.0;
-	double TimeOfFirstHit = 0.0;
-};
-
+// Logs the damage taken by the owning actor once it stops taking damage, using the data gathered by ULyraDamageTelemetrySubsystem
 UCLASS(Blueprintable, meta=(BlueprintSpawnableComponent))
 class ULyraDamageLogDebuggerComponent : public UActorComponent
 {
@@ -28,7 +22,6 @@ public:
 
 	virtual void BeginPlay() override;
 	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
-	virtual void TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 
 	UPROPERTY(EditAnywhere)
 	double SecondsBetweenDamageBeforeLogging = 1.0;
@@ -36,9 +29,9 @@ public:
 private:
 	FGameplayMessageListenerHandle ListenerHandle;
 
-	double LastDamageEntryTime = 0.0;
-	TMap<int64, FFrameDamageEntry> DamageLog;
+	FTimerHandle LogDamageTimerHandle;
 
 private:
 	void OnDamageMessage(FGameplayTag Channel, const FLyraVerbMessage& Payload);
+	void LogDamage();
 };
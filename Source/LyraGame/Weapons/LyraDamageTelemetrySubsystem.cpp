@@ -0,0 +1,284 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "LyraDamageTelemetrySubsystem.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "TimerManager.h"
+#include "LyraLogChannels.h"
+
+namespace LyraDamageTelemetry
+{
+	static bool bEnabled = true;
+	static FAutoConsoleVariableRef CVarEnabled(
+		TEXT("lyra.DamageTelemetry.Enabled"),
+		bEnabled,
+		TEXT("Should damage telemetry (DPS, hit intervals, time to kill) be recorded"),
+		ECVF_Default);
+
+	static int32 SamplesPerTarget = 32;
+	static FAutoConsoleVariableRef CVarSamplesPerTarget(
+		TEXT("lyra.DamageTelemetry.SamplesPerTarget"),
+		SamplesPerTarget,
+		TEXT("Capacity of the recent hit ring buffer kept for each damaged actor (applies to newly tracked actors)"),
+		ECVF_Default);
+
+	static float EngagementTimeout = 1.0f;
+	static FAutoConsoleVariableRef CVarEngagementTimeout(
+		TEXT("lyra.DamageTelemetry.EngagementTimeout"),
+		EngagementTimeout,
+		TEXT("Seconds without damage after which an engagement with a target is considered over"),
+		ECVF_Default);
+
+	static float FlushInterval = 5.0f;
+	static FAutoConsoleVariableRef CVarFlushInterval(
+		TEXT("lyra.DamageTelemetry.FlushInterval"),
+		FlushInterval,
+		TEXT("How often (in seconds) idle engagements are folded into the totals (takes effect on the next world)"),
+		ECVF_Default);
+
+	static bool bLogEngagements = false;
+	static FAutoConsoleVariableRef CVarLogEngagements(
+		TEXT("lyra.DamageTelemetry.LogEngagements"),
+		bLogEngagements,
+		TEXT("Should a summary be logged as each engagement is closed"),
+		ECVF_Default);
+
+	static FAutoConsoleCommandWithWorld CmdExportCSV(
+		TEXT("Lyra.DamageTelemetry.ExportCSV"),
+		TEXT("Writes the recorded damage telemetry for the current world to a CSV file in the profiling directory"),
+		FConsoleCommandWithWorldDelegate::CreateStatic([](UWorld* World)
+		{
+			if (ULyraDamageTelemetrySubsystem* Telemetry = UWorld::GetSubsystem<ULyraDamageTelemetrySubsystem>(World))
+			{
+				Telemetry->FlushTelemetry();
+				Telemetry->ExportToCSV();
+			}
+		}));
+}
+
+//////////////////////////////////////////////////////////////////////
+
+ULyraDamageTelemetrySubsystem::ULyraDamageTelemetrySubsystem()
+{
+}
+
+void ULyraDamageTelemetrySubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	if (LyraDamageTelemetry::FlushInterval > 0.0f)
+	{
+		InWorld.GetTimerManager().SetTimer(FlushTimerHandle, this, &ThisClass::FlushTelemetry, LyraDamageTelemetry::FlushInterval, /*bLoop=*/ true);
+	}
+}
+
+void ULyraDamageTelemetrySubsystem::Deinitialize()
+{
+	if (UWorld* World = GetWorld())
+	{
+		World->GetTimerManager().ClearTimer(FlushTimerHandle);
+	}
+
+	Super::Deinitialize();
+}
+
+bool ULyraDamageTelemetrySubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+FName ULyraDamageTelemetrySubsystem::GetWeaponName(const UObject* Weapon)
+{
+	// Group by class so all instances of the same weapon share a breakdown entry
+	return (Weapon != nullptr) ? Weapon->GetClass()->GetFName() : NAME_None;
+}
+
+void ULyraDamageTelemetrySubsystem::RecordDamage(const AActor* Target, const UObject* Weapon, double Damage)
+{
+	if (!LyraDamageTelemetry::bEnabled || (Target == nullptr))
+	{
+		return;
+	}
+
+	const double CurrentTime = GetWorld()->GetTimeSeconds();
+	const FName WeaponName = GetWeaponName(Weapon);
+
+	FLyraDamageTelemetryTarget& TargetData = Targets.FindOrAdd(FObjectKey(Target));
+	if (TargetData.Samples.Num() == 0)
+	{
+		TargetData.Samples.SetNum(FMath::Max(1, LyraDamageTelemetry::SamplesPerTarget));
+		TargetData.TargetName = GetNameSafe(Target);
+	}
+
+	FLyraDamageTelemetrySample& Sample = TargetData.Samples[TargetData.NextSampleIndex];
+	Sample.Time = CurrentTime;
+	Sample.Damage = (float)Damage;
+	Sample.WeaponName = WeaponName;
+	TargetData.NextSampleIndex = (TargetData.NextSampleIndex + 1) % TargetData.Samples.Num();
+
+	FLyraDamageTelemetryEngagement& Engagement = TargetData.Engagement;
+	if (Engagement.IsActive() && ((CurrentTime - Engagement.LastHitTime) >= LyraDamageTelemetry::EngagementTimeout))
+	{
+		CloseEngagement(TargetData);
+	}
+
+	if (!Engagement.IsActive())
+	{
+		Engagement.FirstHitTime = CurrentTime;
+	}
+
+	// Multiple impacts in one frame (e.g., shotgun pellets) count as a single interval sample
+	if (Engagement.LastHitFrame != GFrameCounter)
+	{
+		if (Engagement.NumFrames > 0)
+		{
+			const double Interval = CurrentTime - Engagement.LastHitTime;
+			Engagement.MinInterval = FMath::Min(Engagement.MinInterval, Interval);
+			Engagement.MaxInterval = FMath::Max(Engagement.MaxInterval, Interval);
+			Engagement.TotalInterval += Interval;
+		}
+
+		Engagement.NumFrames++;
+		Engagement.LastHitFrame = GFrameCounter;
+		Engagement.LastHitTime = CurrentTime;
+	}
+
+	Engagement.NumImpacts++;
+	Engagement.TotalDamage += Damage;
+
+	FLyraDamageTelemetryWeaponStats& Stats = WeaponStats.FindOrAdd(WeaponName);
+	Stats.NumImpacts++;
+	Stats.TotalDamage += Damage;
+}
+
+void ULyraDamageTelemetrySubsystem::RecordKill(const AActor* Target, const UObject* Weapon)
+{
+	if (!LyraDamageTelemetry::bEnabled || (Target == nullptr))
+	{
+		return;
+	}
+
+	FLyraDamageTelemetryTarget* TargetData = Targets.Find(FObjectKey(Target));
+	if ((TargetData == nullptr) || !TargetData->Engagement.IsActive())
+	{
+		return;
+	}
+
+	const double TimeToKill = GetWorld()->GetTimeSeconds() - TargetData->Engagement.FirstHitTime;
+
+	FLyraDamageTelemetryWeaponStats& Stats = WeaponStats.FindOrAdd(GetWeaponName(Weapon));
+	Stats.NumKills++;
+	Stats.TotalTimeToKill += TimeToKill;
+	Stats.MinTimeToKill = FMath::Min(Stats.MinTimeToKill, TimeToKill);
+	Stats.MaxTimeToKill = FMath::Max(Stats.MaxTimeToKill, TimeToKill);
+
+	CloseEngagement(*TargetData);
+}
+
+void ULyraDamageTelemetrySubsystem::CloseEngagement(FLyraDamageTelemetryTarget& TargetData)
+{
+	FLyraDamageTelemetryEngagement& Engagement = TargetData.Engagement;
+	check(Engagement.IsActive());
+
+	NumEngagements++;
+	TotalEngagementDamage += Engagement.TotalDamage;
+	TotalEngagementTime += Engagement.TotalInterval;
+
+	if (LyraDamageTelemetry::bLogEngagements)
+	{
+		UE_LOG(LogLyra, Log, TEXT("%s: %d impacts in %d distinct frames over %.2f seconds did %.2f damage"),
+			*TargetData.TargetName, Engagement.NumImpacts, Engagement.NumFrames, Engagement.TotalInterval, Engagement.TotalDamage);
+		if (Engagement.TotalInterval > 0.0)
+		{
+			UE_LOG(LogLyra, Log, TEXT("%s: Interval ranged from %.1f ms to %.1f ms (avg %.1f ms), DPS %.2f"),
+				*TargetData.TargetName, Engagement.MinInterval * 1000.0, Engagement.MaxInterval * 1000.0, Engagement.GetAverageInterval() * 1000.0, Engagement.GetDPS());
+		}
+	}
+
+	TargetData.LastEngagement = Engagement;
+	Engagement = FLyraDamageTelemetryEngagement();
+}
+
+void ULyraDamageTelemetrySubsystem::FlushTelemetry()
+{
+	const double CurrentTime = GetWorld()->GetTimeSeconds();
+
+	for (auto It = Targets.CreateIterator(); It; ++It)
+	{
+		FLyraDamageTelemetryTarget& TargetData = It.Value();
+
+		if (TargetData.Engagement.IsActive() && ((CurrentTime - TargetData.Engagement.LastHitTime) >= LyraDamageTelemetry::EngagementTimeout))
+		{
+			CloseEngagement(TargetData);
+		}
+
+		if (!TargetData.Engagement.IsActive() && (It.Key().ResolveObjectPtr() == nullptr))
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+bool ULyraDamageTelemetrySubsystem::GetEngagement(const AActor* Target, FLyraDamageTelemetryEngagement& OutEngagement) const
+{
+	if (const FLyraDamageTelemetryTarget* TargetData = Targets.Find(FObjectKey(Target)))
+	{
+		OutEngagement = TargetData->Engagement.IsActive() ? TargetData->Engagement : TargetData->LastEngagement;
+		return OutEngagement.IsActive();
+	}
+
+	return false;
+}
+
+FString ULyraDamageTelemetrySubsystem::ExportToCSV() const
+{
+	TStringBuilder<4096> Csv;
+
+	Csv.Append(TEXT("Section,Target,Weapon,Time,Damage,NumImpacts,NumKills,AvgTimeToKill,MinTimeToKill,MaxTimeToKill,DPS\n"));
+
+	for (const auto& KVP : Targets)
+	{
+		const FLyraDamageTelemetryTarget& TargetData = KVP.Value;
+
+		// Walk the ring oldest to newest
+		for (int32 Offset = 0; Offset < TargetData.Samples.Num(); ++Offset)
+		{
+			const FLyraDamageTelemetrySample& Sample = TargetData.Samples[(TargetData.NextSampleIndex + Offset) % TargetData.Samples.Num()];
+			if (Sample.Time > 0.0)
+			{
+				Csv.Appendf(TEXT("Hit,%s,%s,%.3f,%.2f,,,,,,\n"), *TargetData.TargetName, *Sample.WeaponName.ToString(), Sample.Time, Sample.Damage);
+			}
+		}
+	}
+
+	for (const auto& KVP : WeaponStats)
+	{
+		const FLyraDamageTelemetryWeaponStats& Stats = KVP.Value;
+		const double AvgTimeToKill = (Stats.NumKills > 0) ? (Stats.TotalTimeToKill / Stats.NumKills) : 0.0;
+		const double MinTimeToKill = (Stats.NumKills > 0) ? Stats.MinTimeToKill : 0.0;
+
+		Csv.Appendf(TEXT("Weapon,,%s,,%.2f,%d,%d,%.3f,%.3f,%.3f,\n"),
+			*KVP.Key.ToString(), Stats.TotalDamage, Stats.NumImpacts, Stats.NumKills, AvgTimeToKill, MinTimeToKill, Stats.MaxTimeToKill);
+	}
+
+	const double OverallDPS = (TotalEngagementTime > 0.0) ? (TotalEngagementDamage / TotalEngagementTime) : 0.0;
+	Csv.Appendf(TEXT("Total,,,%.3f,%.2f,,,,,,%.2f\n"), TotalEngagementTime, TotalEngagementDamage, OverallDPS);
+
+	const FString OutputDir = FPaths::ProfilingDir() / TEXT("DamageTelemetry");
+	IFileManager::Get().MakeDirectory(*OutputDir, true);
+
+	const FString Filename = OutputDir / FString::Printf(TEXT("DamageTelemetry-%s.csv"), *FDateTime::Now().ToString());
+	if (!FFileHelper::SaveStringToFile(Csv.ToView(), *Filename))
+	{
+		UE_LOG(LogLyra, Warning, TEXT("Failed to write damage telemetry to %s"), *Filename);
+		return FString();
+	}
+
+	UE_LOG(LogLyra, Log, TEXT("Wrote damage telemetry for %d engagements (overall DPS %.2f) to %s"), NumEngagements, OverallDPS, *Filename);
+	return Filename;
+}
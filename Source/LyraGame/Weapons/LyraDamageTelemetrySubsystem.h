@@ -0,0 +1,122 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+
+#include "LyraDamageTelemetrySubsystem.generated.h"
+
+class AActor;
+
+// A single damage event recorded against a target
+struct FLyraDamageTelemetrySample
+{
+	double Time = 0.0;
+	float Damage = 0.0f;
+	FName WeaponName;
+};
+
+// Streaming aggregates for one engagement: a run of hits on a target without a gap longer than the engagement timeout
+struct FLyraDamageTelemetryEngagement
+{
+	int32 NumImpacts = 0;
+	int32 NumFrames = 0;
+	double TotalDamage = 0.0;
+	double FirstHitTime = 0.0;
+	double LastHitTime = 0.0;
+	uint64 LastHitFrame = 0;
+	double MinInterval = TNumericLimits<double>::Max();
+	double MaxInterval = 0.0;
+	double TotalInterval = 0.0;
+
+	bool IsActive() const { return NumImpacts > 0; }
+	double GetDuration() const { return LastHitTime - FirstHitTime; }
+	double GetDPS() const { return (TotalInterval > 0.0) ? (TotalDamage / TotalInterval) : 0.0; }
+	double GetAverageInterval() const { return (NumFrames > 1) ? (TotalInterval / (NumFrames - 1)) : 0.0; }
+};
+
+// Aggregated damage dealt by one weapon type since the telemetry was last reset
+struct FLyraDamageTelemetryWeaponStats
+{
+	int32 NumImpacts = 0;
+	double TotalDamage = 0.0;
+	int32 NumKills = 0;
+	double TotalTimeToKill = 0.0;
+	double MinTimeToKill = TNumericLimits<double>::Max();
+	double MaxTimeToKill = 0.0;
+};
+
+// The recent damage history and current engagement for one damaged actor
+struct FLyraDamageTelemetryTarget
+{
+	// Fixed-capacity ring buffer of the most recent hits, allocated once when the target is first damaged
+	TArray<FLyraDamageTelemetrySample> Samples;
+	int32 NextSampleIndex = 0;
+
+	FLyraDamageTelemetryEngagement Engagement;
+
+	// The most recently closed engagement, kept so it can still be inspected after a flush
+	FLyraDamageTelemetryEngagement LastEngagement;
+
+	FString TargetName;
+};
+
+/**
+ * ULyraDamageTelemetrySubsystem
+ *
+ * Always-on damage telemetry (DPS, hit intervals, time-to-kill and a per-weapon breakdown).
+ * Does not tick, idle engagements are folded into the totals on a timer or when flushed explicitly.
+ */
+UCLASS()
+class LYRAGAME_API ULyraDamageTelemetrySubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	ULyraDamageTelemetrySubsystem();
+
+	//~USubsystem interface
+	virtual void Deinitialize() override;
+	//~End of USubsystem interface
+
+	//~UWorldSubsystem interface
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	//~End of UWorldSubsystem interface
+
+	/** Records a damage event against Target. Weapon is the source object of the damage effect (typically the weapon instance) */
+	void RecordDamage(const AActor* Target, const UObject* Weapon, double Damage);
+
+	/** Records that Target ran out of health, closing its engagement and recording the time to kill against Weapon */
+	void RecordKill(const AActor* Target, const UObject* Weapon);
+
+	/** Folds any engagements that have been idle longer than the engagement timeout into the totals and drops destroyed targets */
+	void FlushTelemetry();
+
+	/** Returns the current engagement with Target, or the last closed one if there is no current engagement */
+	bool GetEngagement(const AActor* Target, FLyraDamageTelemetryEngagement& OutEngagement) const;
+
+	/** Writes the per-target recent hits and the per-weapon breakdown to a CSV file, returning the path written (or an empty string) */
+	FString ExportToCSV() const;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	void CloseEngagement(FLyraDamageTelemetryTarget& TargetData);
+
+	static FName GetWeaponName(const UObject* Weapon);
+
+private:
+	TMap<FObjectKey, FLyraDamageTelemetryTarget> Targets;
+
+	TMap<FName, FLyraDamageTelemetryWeaponStats> WeaponStats;
+
+	// Totals across all closed engagements
+	int32 NumEngagements = 0;
+	double TotalEngagementDamage = 0.0;
+	double TotalEngagementTime = 0.0;
+
+	FTimerHandle FlushTimerHandle;
+};
@@ -38,6 +38,20 @@ namespace LyraConsoleVariables
 		DrawBulletHitRadius,
 		TEXT("When bullet hit debug drawing is enabled (see DrawBulletHitDuration), how big should the hit radius be? (in uu)"),
 		ECVF_Default);
+
+	static bool LogTraceScratchGrowth = false;
+	static FAutoConsoleVariableRef CVarLogTraceScratchGrowth(
+		TEXT("lyra.Weapon.LogTraceScratchGrowth"),
+		LogTraceScratchGrowth,
+		TEXT("Should we log whenever a weapon trace had to grow its scratch hit arrays (steady-state firing should never do this)"),
+		ECVF_Default);
+
+	static bool BatchCartridgeTargetData = true;
+	static FAutoConsoleVariableRef CVarBatchCartridgeTargetData(
+		TEXT("lyra.Weapon.BatchCartridgeTargetData"),
+		BatchCartridgeTargetData,
+		TEXT("Should clients pack all the bullets of a cartridge into one target data entry when sending them to the server"),
+		ECVF_Default);
 }
 
 // Weapon fire will be blocked/canceled if the player has this tag
@@ -103,28 +117,59 @@ bool ULyraGameplayAbility_RangedWeapon::CanActivateAbility(const FGameplayAbilit
 	return bResult;
 }
 
-int32 ULyraGameplayAbility_RangedWeapon::FindFirstPawnHitResult(const TArray<FHitResult>& HitResults)
+int32 ULyraGameplayAbility_RangedWeapon::FindFirstPawnHitResult(const TArray<FHitResult>& HitResults) const
 {
 	for (int32 Idx = 0; Idx < HitResults.Num(); ++Idx)
 	{
-		const FHitResult& CurHitResult = HitResults[Idx];
+		if (IsPawnHitResult(HitResults[Idx]))
+		{
+			return Idx;
+		}
+	}
+
+	return INDEX_NONE;
+}
+
+bool ULyraGameplayAbility_RangedWeapon::IsPawnHitResult(const FHitResult& HitResult) const
+{
+	auto ClassifyHit = [](const FHitResult& CurHitResult)
+	{
 		if (CurHitResult.HitObjectHandle.DoesRepresentClass(APawn::StaticClass()))
 		{
 			// If we hit a pawn, we're good
-			return Idx;
+			return true;
 		}
-		else
+
+		// If we hit something attached to a pawn, we're good
+		AActor* HitActor = CurHitResult.HitObjectHandle.FetchActor();
+		return (HitActor != nullptr) && (Cast<APawn>(HitActor->GetAttachParentActor()) != nullptr);
+	};
+
+	const UPrimitiveComponent* HitComponent = HitResult.GetComponent();
+	if (HitComponent == nullptr)
+	{
+		return ClassifyHit(HitResult);
+	}
+
+	// Attachments can change between frames, so the cache only lives for the current one
+	if (PawnHitClassificationFrame != GFrameCounter)
+	{
+		PawnHitClassificationCache.Reset();
+		PawnHitClassificationFrame = GFrameCounter;
+	}
+
+	for (const FPawnHitClassification& Entry : PawnHitClassificationCache)
+	{
+		if (Entry.Component.Get() == HitComponent)
 		{
-			AActor* HitActor = CurHitResult.HitObjectHandle.FetchActor();
-			if ((HitActor != nullptr) && (HitActor->GetAttachParentActor() != nullptr) && (Cast<APawn>(HitActor->GetAttachParentActor()) != nullptr))
-			{
-				// If we hit something attached to a pawn, we're good
-				return Idx;
-			}
+			return Entry.bIsPawnHit;
 		}
 	}
 
-	return INDEX_NONE;
+	FPawnHitClassification& NewEntry = PawnHitClassificationCache.AddDefaulted_GetRef();
+	NewEntry.Component = HitComponent;
+	NewEntry.bIsPawnHit = ClassifyHit(HitResult);
+	return NewEntry.bIsPawnHit;
 }
 
 void ULyraGameplayAbility_RangedWeapon::AddAdditionalTraceIgnoreActors(FCollisionQueryParams& TraceParams) const
@@ -145,8 +190,9 @@ ECollisionChannel ULyraGameplayAbility_RangedWeapon::DetermineTraceChannel(FColl
 
 FHitResult ULyraGameplayAbility_RangedWeapon::WeaponTrace(const FVector& StartTrace, const FVector& EndTrace, float SweepRadius, bool bIsSimulated, OUT TArray<FHitResult>& OutHitResults) const
 {
-	TArray<FHitResult> HitResults;
-	
+	TArray<FHitResult>& HitResults = ScratchQueryHits;
+	HitResults.Reset();
+
 	FCollisionQueryParams TraceParams(SCENE_QUERY_STAT(WeaponTrace), /*bTraceComplex=*/ true, /*IgnoreActor=*/ GetAvatarActorFromActorInfo());
 	TraceParams.bReturnPhysicalMaterial = true;
 	AddAdditionalTraceIgnoreActors(TraceParams);
@@ -316,7 +362,8 @@ FHitResult ULyraGameplayAbility_RangedWeapon::DoSingleBulletTrace(const FVector&
 		// If this weapon didn't hit anything with a line trace and supports a sweep radius, try that
 		if (SweepRadius > 0.0f)
 		{
-			TArray<FHitResult> SweepHits;
+			TArray<FHitResult>& SweepHits = ScratchSweepHits;
+			SweepHits.Reset();
 			Impact = WeaponTrace(StartTrace, EndTrace, SweepRadius, bIsSimulated, /*out*/ SweepHits);
 
 			// If the trace with sweep radius enabled hit a pawn, check if we should use its hit results
@@ -343,7 +390,8 @@ FHitResult ULyraGameplayAbility_RangedWeapon::DoSingleBulletTrace(const FVector&
 
 				if (bUseSweepHits)
 				{
-					OutHits = SweepHits;
+					// Swap buffers rather than copying, the old contents of OutHits become next shot's sweep scratch
+					Swap(OutHits, SweepHits);
 				}
 			}
 		}
@@ -389,6 +437,11 @@ void ULyraGameplayAbility_RangedWeapon::TraceBulletsInCartridge(const FRangedWea
 
 	const int32 BulletsPerCartridge = WeaponData->GetBulletsPerCartridge();
 
+	// Every bullet contributes at least one entry, so size the output up front for the common case
+	OutHits.Reserve(OutHits.Num() + BulletsPerCartridge);
+
+	TArray<FHitResult>& AllImpacts = ScratchBulletImpacts;
+
 	for (int32 BulletIndex = 0; BulletIndex < BulletsPerCartridge; ++BulletIndex)
 	{
 		const float BaseSpreadAngle = WeaponData->GetCalculatedSpreadAngle();
@@ -402,7 +455,7 @@ void ULyraGameplayAbility_RangedWeapon::TraceBulletsInCartridge(const FRangedWea
 		const FVector EndTrace = InputData.StartTrace + (BulletDir * WeaponData->GetMaxDamageRange());
 		FVector HitLocation = EndTrace;
 
-		TArray<FHitResult> AllImpacts;
+		AllImpacts.Reset();
 
 		FHitResult Impact = DoSingleBulletTrace(InputData.StartTrace, EndTrace, WeaponData->GetBulletTraceSweepRadius(), /*bIsSimulated=*/ false, /*out*/ AllImpacts);
 
@@ -489,10 +542,23 @@ void ULyraGameplayAbility_RangedWeapon::OnTargetDataReadyCallback(const FGamepla
 		// Take ownership of the target data to make sure no callbacks into game code invalidate it out from under us
 		FGameplayAbilityTargetDataHandle LocalTargetDataHandle(MoveTemp(const_cast<FGameplayAbilityTargetDataHandle&>(InData)));
 
+		// Clients may have packed each cartridge into one entry, the rest of the pipeline expects one entry per bullet
+		FLyraGameplayAbilityTargetData_CartridgeHits::UnpackCartridges(LocalTargetDataHandle);
+
 		const bool bShouldNotifyServer = CurrentActorInfo->IsLocallyControlled() && !CurrentActorInfo->IsNetAuthority();
 		if (bShouldNotifyServer)
 		{
-			MyAbilityComponent->CallServerSetReplicatedTargetData(CurrentSpecHandle, CurrentActivationInfo.GetActivationPredictionKey(), LocalTargetDataHandle, ApplicationTag, MyAbilityComponent->ScopedPredictionKey);
+			if (LyraConsoleVariables::BatchCartridgeTargetData)
+			{
+				FGameplayAbilityTargetDataHandle PackedTargetDataHandle;
+				FLyraGameplayAbilityTargetData_CartridgeHits::PackCartridges(LocalTargetDataHandle, /*out*/ PackedTargetDataHandle);
+
+				MyAbilityComponent->CallServerSetReplicatedTargetData(CurrentSpecHandle, CurrentActivationInfo.GetActivationPredictionKey(), PackedTargetDataHandle, ApplicationTag, MyAbilityComponent->ScopedPredictionKey);
+			}
+			else
+			{
+				MyAbilityComponent->CallServerSetReplicatedTargetData(CurrentSpecHandle, CurrentActivationInfo.GetActivationPredictionKey(), LocalTargetDataHandle, ApplicationTag, MyAbilityComponent->ScopedPredictionKey);
+			}
 		}
 
 		const bool bIsTargetDataValid = true;
@@ -568,9 +634,23 @@ void ULyraGameplayAbility_RangedWeapon::StartRangedWeaponTargeting()
 
 	FScopedPredictionWindow ScopedPrediction(MyAbilityComponent, CurrentActivationInfo.GetActivationPredictionKey());
 
-	TArray<FHitResult> FoundHits;
+	TArray<FHitResult>& FoundHits = ScratchCartridgeHits;
+	FoundHits.Reset();
+
+	const SIZE_T ScratchSizeBeforeTrace = ScratchQueryHits.GetAllocatedSize() + ScratchSweepHits.GetAllocatedSize() + ScratchBulletImpacts.GetAllocatedSize() + ScratchCartridgeHits.GetAllocatedSize();
+
 	PerformLocalTargeting(/*out*/ FoundHits);
 
+	if (LyraConsoleVariables::LogTraceScratchGrowth)
+	{
+		const SIZE_T ScratchSizeAfterTrace = ScratchQueryHits.GetAllocatedSize() + ScratchSweepHits.GetAllocatedSize() + ScratchBulletImpacts.GetAllocatedSize() + ScratchCartridgeHits.GetAllocatedSize();
+		if (ScratchSizeAfterTrace != ScratchSizeBeforeTrace)
+		{
+			UE_LOG(LogLyraAbilitySystem, Log, TEXT("Weapon ability %s grew its trace scratch buffers from %llu to %llu bytes (%d hits)"),
+				*GetPathName(), (uint64)ScratchSizeBeforeTrace, (uint64)ScratchSizeAfterTrace, FoundHits.Num());
+		}
+	}
+
 	// Fill out the target data from the hit results
 	FGameplayAbilityTargetDataHandle TargetData;
 	TargetData.UniqueId = WeaponStateComponent ? WeaponStateComponent->GetUnconfirmedServerSideHitMarkerCount() : 0;
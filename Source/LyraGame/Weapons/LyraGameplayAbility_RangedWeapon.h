@@ -9,6 +9,7 @@
 
 class ULyraRangedWeaponInstance;
 class APawn;
+class UPrimitiveComponent;
 
 /** Defines where an ability starts its trace from and where it should face */
 UENUM(BlueprintType)
@@ -80,7 +81,11 @@ protected:
 	};
 
 protected:
-	static int32 FindFirstPawnHitResult(const TArray<FHitResult>& HitResults);
+	// Returns the index of the first hit on a pawn (or on something attached to a pawn), or INDEX_NONE
+	int32 FindFirstPawnHitResult(const TArray<FHitResult>& HitResults) const;
+
+	// Classifies a single hit as a pawn hit, caching the answer per primitive component for the current frame
+	bool IsPawnHitResult(const FHitResult& HitResult) const;
 
 	// Does a single weapon trace, either sweeping or ray depending on if SweepRadius is above zero
 	FHitResult WeaponTrace(const FVector& StartTrace, const FVector& EndTrace, float SweepRadius, bool bIsSimulated, OUT TArray<FHitResult>& OutHitResults) const;
@@ -112,4 +117,21 @@ protected:
 
 private:
 	FDelegateHandle OnTargetDataReadyCallbackDelegateHandle;
+
+	struct FPawnHitClassification
+	{
+		TWeakObjectPtr<const UPrimitiveComponent> Component;
+		bool bIsPawnHit = false;
+	};
+
+	// Pawn classification of the components hit this frame, shared by all bullets of a cartridge
+	mutable TArray<FPawnHitClassification, TInlineAllocator<16>> PawnHitClassificationCache;
+	mutable uint64 PawnHitClassificationFrame = 0;
+
+	// Scratch hit arrays reused across shots so steady-state firing doesn't reallocate them.
+	// They only grow when a shot produces more hits than any previous one.
+	mutable TArray<FHitResult> ScratchQueryHits;
+	mutable TArray<FHitResult> ScratchSweepHits;
+	TArray<FHitResult> ScratchBulletImpacts;
+	TArray<FHitResult> ScratchCartridgeHits;
 };
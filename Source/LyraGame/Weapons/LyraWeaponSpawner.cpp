@@ -5,6 +5,8 @@
 #include "Net/UnrealNetwork.h"
 #include "Components/StaticMeshComponent.h"
 #include "Components/CapsuleComponent.h"
+#include "GameFramework/GameStateBase.h"
+#include "GameFramework/RotatingMovementComponent.h"
 #include "Equipment/LyraEquipmentDefinition.h"
 #include "Equipment/LyraEquipmentManagerComponent.h"
 #include "Equipment/LyraPickupDefinition.h"
@@ -19,8 +21,9 @@
 // Sets default values
 ALyraWeaponSpawner::ALyraWeaponSpawner()
 {
- 	// Set this actor to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
+	// Ticking is only enabled on clients while a cooldown is running (see StartCoolDown)
 	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bStartWithTickEnabled = false;
 
 	RootComponent = CollisionVolume = CreateDefaultSubobject<UCapsuleComponent>(TEXT("CollisionVolume"));
 	CollisionVolume->InitCapsuleSize(80.f, 80.f);
@@ -32,9 +35,16 @@ ALyraWeaponSpawner::ALyraWeaponSpawner()
 	WeaponMesh = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("WeaponMesh"));
 	WeaponMesh->SetupAttachment(RootComponent);
 
+	WeaponMeshRotation = CreateDefaultSubobject<URotatingMovementComponent>(TEXT("WeaponMeshRotation"));
+	WeaponMeshRotation->SetUpdatedComponent(WeaponMesh);
+	WeaponMeshRotation->bUpdateOnlyIfRendered = true;
+	WeaponMeshRotation->bAutoActivate = false;
+
 	WeaponMeshRotationSpeed = 40.0f;
 	CoolDownTime = 30.0f;
 	CheckExistingOverlapDelay = 0.25f;
+	CoolDownPercentage = 0.0f;
+	CoolDownStartTime = 0.0f;
 	bIsWeaponAvailable = true;
 	bReplicates = true;
 }
@@ -52,6 +62,13 @@ void ALyraWeaponSpawner::BeginPlay()
 	{
 		UE_LOG(LogLyra, Error, TEXT("'%s' does not have a valid weapon definition! Make sure to set this data on the instance!"), *GetNameSafe(this));
 	}
+
+	// The spin is purely cosmetic, so dedicated servers never move the weapon mesh
+	WeaponMeshRotation->RotationRate = FRotator(0.0f, WeaponMeshRotationSpeed, 0.0f);
+	if (!IsNetMode(NM_DedicatedServer))
+	{
+		WeaponMeshRotation->SetActive(bIsWeaponAvailable);
+	}
 }
 
 void ALyraWeaponSpawner::EndPlay(const EEndPlayReason::Type EndPlayReason)
@@ -65,19 +82,34 @@ void ALyraWeaponSpawner::EndPlay(const EEndPlayReason::Type EndPlayReason)
 	Super::EndPlay(EndPlayReason);
 }
 
-// Called every frame
 void ALyraWeaponSpawner::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
 
-	//Update the CoolDownPercentage property to drive respawn time indicators
-	UWorld* World = GetWorld();
-	if (World->GetTimerManager().IsTimerActive(CoolDownTimerHandle))
+	//Update the CoolDownPercentage property to drive respawn time indicators, nobody can see it if the pad isn't rendered
+	if (WasRecentlyRendered())
+	{
+		CoolDownPercentage = GetCoolDownPercentage();
+	}
+}
+
+float ALyraWeaponSpawner::GetCoolDownPercentage() const
+{
+	if (bIsWeaponAvailable || (CoolDownTime <= 0.0f))
+	{
+		return 0.0f;
+	}
+
+	const UWorld* World = GetWorld();
+	if (World == nullptr)
 	{
-		CoolDownPercentage = 1.0f - World->GetTimerManager().GetTimerRemaining(CoolDownTimerHandle)/CoolDownTime;
+		return 0.0f;
 	}
 
-	WeaponMesh->AddRelativeRotation(FRotator(0.0f, World->GetDeltaSeconds() * WeaponMeshRotationSpeed, 0.0f));
+	const AGameStateBase* GameState = World->GetGameState();
+	const double CurrentTime = (GameState != nullptr) ? GameState->GetServerWorldTimeSeconds() : World->GetTimeSeconds();
+
+	return FMath::Clamp((float)(CurrentTime - CoolDownStartTime) / CoolDownTime, 0.0f, 1.0f);
 }
 
 void ALyraWeaponSpawner::OnConstruction(const FTransform& Transform)
@@ -134,8 +166,19 @@ void ALyraWeaponSpawner::StartCoolDown()
 {
 	if (UWorld* World = GetWorld())
 	{
+		if (GetLocalRole() == ROLE_Authority)
+		{
+			const AGameStateBase* GameState = World->GetGameState();
+			CoolDownStartTime = (GameState != nullptr) ? GameState->GetServerWorldTimeSeconds() : World->GetTimeSeconds();
+		}
+
 		World->GetTimerManager().SetTimer(CoolDownTimerHandle, this, &ALyraWeaponSpawner::OnCoolDownTimerComplete, CoolDownTime);
 	}
+
+	if (!IsNetMode(NM_DedicatedServer))
+	{
+		SetActorTickEnabled(true);
+	}
 }
 
 void ALyraWeaponSpawner::ResetCoolDown()
@@ -160,6 +203,7 @@ void ALyraWeaponSpawner::ResetCoolDown()
 	}
 
 	CoolDownPercentage = 0.0f;
+	SetActorTickEnabled(false);
 }
 
 void ALyraWeaponSpawner::OnCoolDownTimerComplete()
@@ -170,6 +214,11 @@ void ALyraWeaponSpawner::OnCoolDownTimerComplete()
 void ALyraWeaponSpawner::SetWeaponPickupVisibility(bool bShouldBeVisible)
 {
 	WeaponMesh->SetVisibility(bShouldBeVisible, true);
+
+	if (!IsNetMode(NM_DedicatedServer))
+	{
+		WeaponMeshRotation->SetActive(bShouldBeVisible);
+	}
 }
 
 void ALyraWeaponSpawner::PlayPickupEffects_Implementation()
@@ -228,6 +277,7 @@ void ALyraWeaponSpawner::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& O
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 
 	DOREPLIFETIME(ALyraWeaponSpawner, bIsWeaponAvailable);
+	DOREPLIFETIME(ALyraWeaponSpawner, CoolDownStartTime);
 }
 
 int32 ALyraWeaponSpawner::GetDefaultStatFromItemDef(const TSubclassOf<ULyraInventoryItemDefinition> WeaponItemClass, FGameplayTag StatTag)
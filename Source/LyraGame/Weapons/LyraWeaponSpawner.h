@@ -11,6 +11,7 @@ class ULyraInventoryItemDefinition;
 class ULyraWeaponPickupDefinition;
 class UCapsuleComponent;
 class UStaticMeshComponent;
+class URotatingMovementComponent;
 
 UCLASS(Blueprintable,BlueprintType)
 class LYRAGAME_API ALyraWeaponSpawner : public AActor
@@ -27,7 +28,7 @@ protected:
 	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 public:	
-	// Called every frame
+	// Only ticks on clients while a cooldown is running, to keep CoolDownPercentage current for respawn indicators
 	virtual void Tick(float DeltaTime) override;
 
 	void OnConstruction(const FTransform& Transform) override;
@@ -48,10 +49,14 @@ protected:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Lyra|WeaponPickup")
 	float CheckExistingOverlapDelay;
 
-	//Used to drive weapon respawn time indicators 0-1
+	//Used to drive weapon respawn time indicators 0-1. Only updated on clients while the pad is rendered, prefer GetCoolDownPercentage
 	UPROPERTY(BlueprintReadOnly, Transient, Category = "Lyra|WeaponPickup")
 	float CoolDownPercentage;
 
+	//Server world time at which the current cooldown started, used to derive cooldown progress on demand
+	UPROPERTY(Replicated, Transient)
+	float CoolDownStartTime;
+
 public:
 
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Lyra|WeaponPickup")
@@ -66,6 +71,10 @@ public:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Lyra|WeaponPickup")
 	float WeaponMeshRotationSpeed;
 
+	//Spins the weapon mesh on clients, only while the mesh is visible and rendered
+	UPROPERTY(BlueprintReadOnly, Category = "Lyra|WeaponPickup")
+	URotatingMovementComponent* WeaponMeshRotation;
+
 	FTimerHandle CoolDownTimerHandle;
 
 	FTimerHandle CheckOverlapsDelayTimerHandle;
@@ -90,6 +99,10 @@ public:
 	UFUNCTION()
 	void OnCoolDownTimerComplete();
 
+	/** Returns how far through the respawn cooldown this pad is (0-1), derived from the replicated start time */
+	UFUNCTION(BlueprintPure, Category = "Lyra|WeaponPickup")
+	float GetCoolDownPercentage() const;
+
 	void SetWeaponPickupVisibility(bool bShouldBeVisible);
 
 	UFUNCTION(BlueprintNativeEvent, Category = "Lyra|WeaponPickup")
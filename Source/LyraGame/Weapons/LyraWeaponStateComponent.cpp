@@ -89,6 +89,7 @@ void ULyraWeaponStateComponent::ClientConfirmTargetData_Implementation(uint16 Un
 						bFoundShowAsSuccessHit = true;
 
 						LastWeaponDamageScreenLocations.Add(Entry);
+						++LastWeaponDamageScreenLocationsSerial;
 					}
 					++HitLocationIndex;
 				}
@@ -148,6 +149,7 @@ void ULyraWeaponStateComponent::ActuallyUpdateDamageInstigatedTime()
 	if (World->GetTimeSeconds() - LastWeaponDamageInstigatedTime > 0.1)
 	{
 		LastWeaponDamageScreenLocations.Reset();
+		++LastWeaponDamageScreenLocationsSerial;
 	}
 	LastWeaponDamageInstigatedTime = World->GetTimeSeconds();
 }
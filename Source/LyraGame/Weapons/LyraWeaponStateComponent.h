@@ -56,11 +56,17 @@ public:
 	void UpdateDamageInstigatedTime(const FGameplayEffectContextHandle& EffectContext);
 
 	/** Gets the array of most recent locations this player instigated damage, in screen-space */
-	void GetLastWeaponDamageScreenLocations(TArray<FLyraScreenSpaceHitLocation>& WeaponDamageScreenLocations)
+	void GetLastWeaponDamageScreenLocations(TArray<FLyraScreenSpaceHitLocation>& WeaponDamageScreenLocations) const
 	{
 		WeaponDamageScreenLocations = LastWeaponDamageScreenLocations;
 	}
 
+	/** Returns a counter that changes whenever the last weapon damage screen locations change, so the reticle can skip copying them */
+	uint32 GetLastWeaponDamageScreenLocationsSerial() const
+	{
+		return LastWeaponDamageScreenLocationsSerial;
+	}
+
 	/** Returns the elapsed time since the last (outgoing) damage hit notification occurred */
 	double GetTimeSinceLastHitNotification() const;
 
@@ -85,6 +91,7 @@ private:
 
 	/** Screen-space locations of our most recently instigated weapon damage (the confirmed hits) */
 	TArray<FLyraScreenSpaceHitLocation> LastWeaponDamageScreenLocations;
+	uint32 LastWeaponDamageScreenLocationsSerial = 0;
 
 	/** The unconfirmed hits */
 	TArray<FLyraServerSideHitMarkerBatch> UnconfirmedServerSideHitMarkers;